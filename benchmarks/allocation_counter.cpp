@@ -0,0 +1,131 @@
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+namespace benchmark
+{
+
+
+std::atomic<size_t> allocationCount(0);
+
+
+size_t GetAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+
+void * Allocate(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    auto result = std::malloc((size > 0) ? size : 1);
+
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+
+    return result;
+}
+
+
+void * AllocateAligned(size_t size, std::align_val_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    auto alignmentValue = static_cast<size_t>(alignment);
+
+    // aligned_alloc requires size to be a multiple of the alignment.
+    auto alignedSize =
+        ((size + alignmentValue - 1) / alignmentValue) * alignmentValue;
+
+    auto result = std::aligned_alloc(
+        alignmentValue,
+        (alignedSize > 0) ? alignedSize : alignmentValue);
+
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+
+    return result;
+}
+
+
+} // end namespace benchmark
+
+
+void * operator new(size_t size)
+{
+    return benchmark::Allocate(size);
+}
+
+
+void * operator new[](size_t size)
+{
+    return benchmark::Allocate(size);
+}
+
+
+void * operator new(size_t size, std::align_val_t alignment)
+{
+    return benchmark::AllocateAligned(size, alignment);
+}
+
+
+void * operator new[](size_t size, std::align_val_t alignment)
+{
+    return benchmark::AllocateAligned(size, alignment);
+}
+
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
@@ -0,0 +1,25 @@
+/**
+  * @file allocation_counter.h
+  *
+  * @brief Counts calls to the global operator new.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace benchmark
+{
+
+
+// The number of allocations made by any thread since the program started.
+size_t GetAllocationCount();
+
+
+} // end namespace benchmark
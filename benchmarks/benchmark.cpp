@@ -0,0 +1,41 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+
+
+namespace benchmark
+{
+
+
+void Benchmarks::Report(std::ostream &output) const
+{
+    size_t nameWidth = 0;
+
+    for (auto &result: this->results_)
+    {
+        nameWidth = std::max(nameWidth, result.name.size());
+    }
+
+    output << fmt::format(
+        "{:<{}}  {:>12}  {:>12}\n",
+        "benchmark",
+        nameWidth,
+        "ns/op",
+        "allocs/op");
+
+    for (auto &result: this->results_)
+    {
+        output << fmt::format(
+            "{:<{}}  {:>12.1f}  {:>12.2f}\n",
+            result.name,
+            nameWidth,
+            result.nanosecondsPerOperation,
+            result.allocationsPerOperation);
+    }
+
+    output.flush();
+}
+
+
+} // end namespace benchmark
@@ -0,0 +1,133 @@
+/**
+  * @file benchmark.h
+  *
+  * @brief Measures nanoseconds and allocations per operation.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "allocation_counter.h"
+
+
+namespace benchmark
+{
+
+
+struct Result
+{
+    std::string name;
+    double nanosecondsPerOperation;
+    double allocationsPerOperation;
+};
+
+
+// Keeps the compiler from discarding a value that is otherwise unused.
+template<typename T>
+void DoNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+
+class Benchmarks
+{
+public:
+    // Only benchmarks with names containing filter are run.
+    Benchmarks(const std::string &filter)
+        :
+        filter_(filter),
+        results_()
+    {
+
+    }
+
+    /** Time run, which performs operationCount operations.
+     **
+     ** setup runs before each round, and is not timed. The fastest round is
+     ** reported, with the allocations made during that round.
+     **/
+    template<typename Setup, typename Run>
+    void Measure(
+        const std::string &name,
+        size_t operationCount,
+        Setup &&setup,
+        Run &&run)
+    {
+        if (name.find(this->filter_) == std::string::npos)
+        {
+            return;
+        }
+
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr size_t minimumRounds = 5;
+        static constexpr size_t maximumRounds = 1000;
+        static constexpr auto minimumDuration = std::chrono::milliseconds(200);
+
+        auto best = std::numeric_limits<double>::max();
+        double allocations = 0;
+        Clock::duration total{};
+
+        for (size_t round = 0; round < maximumRounds; ++round)
+        {
+            if (round >= minimumRounds && total >= minimumDuration)
+            {
+                break;
+            }
+
+            setup();
+
+            auto allocationsBefore = GetAllocationCount();
+            auto start = Clock::now();
+
+            run();
+
+            auto elapsed = Clock::now() - start;
+            auto allocationsAfter = GetAllocationCount();
+
+            total += elapsed;
+
+            auto nanoseconds = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    elapsed).count());
+
+            if (nanoseconds < best)
+            {
+                best = nanoseconds;
+
+                allocations =
+                    static_cast<double>(allocationsAfter - allocationsBefore);
+            }
+        }
+
+        auto count = static_cast<double>(operationCount);
+        this->results_.push_back({name, best / count, allocations / count});
+    }
+
+    void Report(std::ostream &output) const;
+
+private:
+    std::string filter_;
+    std::vector<Result> results_;
+};
+
+
+void RunValueBenchmarks(Benchmarks &benchmarks);
+void RunGroupBenchmarks(Benchmarks &benchmarks);
+void RunListBenchmarks(Benchmarks &benchmarks);
+void RunOrderedListBenchmarks(Benchmarks &benchmarks);
+void RunPolyBenchmarks(Benchmarks &benchmarks);
+void RunNameBenchmarks(Benchmarks &benchmarks);
+
+
+} // end namespace benchmark
@@ -0,0 +1,144 @@
+#include <pex/group.h>
+#include <pex/endpoint.h>
+#include "benchmark.h"
+
+
+namespace benchmark
+{
+
+
+namespace
+{
+
+
+template<typename T>
+struct WideFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::f00, "f00"),
+        fields::Field(&T::f01, "f01"),
+        fields::Field(&T::f02, "f02"),
+        fields::Field(&T::f03, "f03"),
+        fields::Field(&T::f04, "f04"),
+        fields::Field(&T::f05, "f05"),
+        fields::Field(&T::f06, "f06"),
+        fields::Field(&T::f07, "f07"),
+        fields::Field(&T::f08, "f08"),
+        fields::Field(&T::f09, "f09"),
+        fields::Field(&T::f10, "f10"),
+        fields::Field(&T::f11, "f11"),
+        fields::Field(&T::f12, "f12"),
+        fields::Field(&T::f13, "f13"),
+        fields::Field(&T::f14, "f14"),
+        fields::Field(&T::f15, "f15"),
+        fields::Field(&T::f16, "f16"),
+        fields::Field(&T::f17, "f17"),
+        fields::Field(&T::f18, "f18"),
+        fields::Field(&T::f19, "f19"));
+};
+
+
+template<template<typename> typename T>
+struct WideTemplate
+{
+    T<double> f00;
+    T<double> f01;
+    T<double> f02;
+    T<double> f03;
+    T<double> f04;
+    T<double> f05;
+    T<double> f06;
+    T<double> f07;
+    T<double> f08;
+    T<double> f09;
+    T<double> f10;
+    T<double> f11;
+    T<double> f12;
+    T<double> f13;
+    T<double> f14;
+    T<double> f15;
+    T<double> f16;
+    T<double> f17;
+    T<double> f18;
+    T<double> f19;
+
+    static constexpr auto fields = WideFields<WideTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Wide";
+};
+
+
+using WideGroup = pex::Group<WideFields, WideTemplate>;
+using Wide = typename WideGroup::Plain;
+using WideModel = typename WideGroup::Model;
+using WideControl = typename WideGroup::template Control<WideModel>;
+
+
+class WideObserver
+{
+public:
+    using WideEndpoint = pex::Endpoint<WideObserver, WideControl>;
+
+    WideObserver(WideControl control)
+        :
+        endpoint_(PEX_THIS("WideObserver"), control, &WideObserver::OnWide_),
+        notificationCount_(0)
+    {
+
+    }
+
+    ~WideObserver()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    size_t GetNotificationCount() const
+    {
+        return this->notificationCount_;
+    }
+
+private:
+    void OnWide_(const Wide &)
+    {
+        ++this->notificationCount_;
+    }
+
+    WideEndpoint endpoint_;
+    size_t notificationCount_;
+};
+
+
+} // end anonymous namespace
+
+
+void RunGroupBenchmarks(Benchmarks &benchmarks)
+{
+    static constexpr size_t operationCount = 1000;
+
+    WideModel model;
+    PEX_ROOT(model);
+
+    WideControl control(model);
+    WideObserver observer(control);
+
+    Wide wide{};
+
+    benchmarks.Measure(
+        "Group::Set fields=20",
+        operationCount,
+        []() {},
+        [&]()
+        {
+            for (size_t i = 0; i < operationCount; ++i)
+            {
+                wide.f00 = static_cast<double>(i);
+                model.Set(wide);
+            }
+
+            DoNotOptimize(observer.GetNotificationCount());
+        });
+
+    PEX_CLEAR_NAME(&model);
+}
+
+
+} // end namespace benchmark
@@ -0,0 +1,111 @@
+#include <fmt/core.h>
+#include <numeric>
+#include <vector>
+#include <pex/list.h>
+#include "benchmark.h"
+
+
+namespace benchmark
+{
+
+
+namespace
+{
+
+
+using List = pex::List<int, 0>;
+using ListModel = typename List::Model;
+
+// Operations per round when the list is measured at a given size.
+static constexpr size_t batchCount = 100;
+
+
+std::vector<int> MakeValues(size_t count)
+{
+    std::vector<int> values(count);
+    std::iota(std::begin(values), std::end(values), 0);
+
+    return values;
+}
+
+
+void MeasureAtSize(Benchmarks &benchmarks, size_t itemCount)
+{
+    ListModel model;
+    PEX_ROOT(model);
+
+    auto values = MakeValues(itemCount);
+
+    benchmarks.Measure(
+        fmt::format("List::Model::Append items={}", itemCount),
+        batchCount,
+        [&]()
+        {
+            model.Set(values);
+        },
+        [&]()
+        {
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                model.Append(static_cast<int>(i));
+            }
+        });
+
+    benchmarks.Measure(
+        fmt::format("List::Model::Erase items={}", itemCount),
+        batchCount,
+        [&]()
+        {
+            model.Set(values);
+        },
+        [&]()
+        {
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                model.Erase(itemCount / 2);
+            }
+        });
+
+    benchmarks.Measure(
+        fmt::format("List::Model item Set items={}", itemCount),
+        batchCount,
+        [&]()
+        {
+            model.Set(values);
+        },
+        [&]()
+        {
+            for (size_t i = 0; i < batchCount; ++i)
+            {
+                model[i * (itemCount / batchCount)].Set(static_cast<int>(i));
+            }
+        });
+
+    model.Set(values);
+
+    benchmarks.Measure(
+        fmt::format("List::Model::Set items={}", itemCount),
+        1,
+        []() {},
+        [&]()
+        {
+            model.Set(values);
+        });
+
+    PEX_CLEAR_NAME(&model);
+}
+
+
+} // end anonymous namespace
+
+
+void RunListBenchmarks(Benchmarks &benchmarks)
+{
+    for (size_t itemCount: {1000, 10000, 100000})
+    {
+        MeasureAtSize(benchmarks, itemCount);
+    }
+}
+
+
+} // end namespace benchmark
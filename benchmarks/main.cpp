@@ -0,0 +1,26 @@
+#include <iostream>
+#include "benchmark.h"
+
+
+int main(int argc, char **argv)
+{
+    if (argc > 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " [name filter]" << std::endl;
+
+        return 1;
+    }
+
+    benchmark::Benchmarks benchmarks((argc == 2) ? argv[1] : "");
+
+    benchmark::RunValueBenchmarks(benchmarks);
+    benchmark::RunGroupBenchmarks(benchmarks);
+    benchmark::RunListBenchmarks(benchmarks);
+    benchmark::RunOrderedListBenchmarks(benchmarks);
+    benchmark::RunPolyBenchmarks(benchmarks);
+    benchmark::RunNameBenchmarks(benchmarks);
+
+    benchmarks.Report(std::cout);
+
+    return 0;
+}
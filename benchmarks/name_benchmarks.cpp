@@ -0,0 +1,88 @@
+#include <fmt/core.h>
+#include <thread>
+#include <vector>
+#include <pex/detail/log.h>
+#include "benchmark.h"
+
+
+namespace benchmark
+{
+
+
+namespace
+{
+
+
+struct Node
+{
+    char data;
+};
+
+
+// Name and clear every node, as a node's constructor and destructor do when
+// ENABLE_PEX_NAMES is defined.
+void NameAndClear(Node &root, std::vector<Node> &nodes)
+{
+    for (auto &node: nodes)
+    {
+        pex::PexName(&node, &root, "node");
+    }
+
+    for (auto &node: nodes)
+    {
+        pex::ClearPexName(&node);
+    }
+}
+
+
+void MeasureThreads(Benchmarks &benchmarks, size_t threadCount)
+{
+    static constexpr size_t nodeCount = 10000;
+
+    Node root{};
+    pex::PexName(&root, "root");
+
+    std::vector<std::vector<Node>> nodes(
+        threadCount,
+        std::vector<Node>(nodeCount));
+
+    benchmarks.Measure(
+        fmt::format("PexName and ClearPexName threads={}", threadCount),
+        nodeCount * threadCount,
+        []() {},
+        [&]()
+        {
+            std::vector<std::thread> threads;
+
+            for (auto &threadNodes: nodes)
+            {
+                threads.emplace_back(
+                    [&root, &threadNodes]()
+                    {
+                        NameAndClear(root, threadNodes);
+                    });
+            }
+
+            for (auto &thread: threads)
+            {
+                thread.join();
+            }
+        });
+
+    pex::ClearPexName(&root);
+}
+
+
+} // end anonymous namespace
+
+
+void RunNameBenchmarks(Benchmarks &benchmarks)
+{
+    for (size_t threadCount: {1, 4})
+    {
+        MeasureThreads(benchmarks, threadCount);
+    }
+}
+
+
+} // end namespace benchmark
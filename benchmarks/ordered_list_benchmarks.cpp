@@ -0,0 +1,81 @@
+#include <fmt/core.h>
+#include <numeric>
+#include <vector>
+#include <pex/ordered_list.h>
+#include "benchmark.h"
+
+
+namespace benchmark
+{
+
+
+namespace
+{
+
+
+using List = pex::List<int, 0>;
+using OrderedListGroup = pex::OrderedListGroup<List>;
+using OrderedModel = typename OrderedListGroup::Model;
+
+
+void MeasureMoves(Benchmarks &benchmarks, size_t itemCount)
+{
+    static constexpr size_t moveCount = 100;
+
+    OrderedModel model;
+    PEX_ROOT(model);
+
+    std::vector<int> values(itemCount);
+    std::iota(std::begin(values), std::end(values), 0);
+    model.Set(values);
+
+    std::vector<size_t> order(itemCount);
+    std::iota(std::begin(order), std::end(order), size_t{0});
+
+    auto resetOrder = [&]()
+    {
+        model.indices.Set(order);
+    };
+
+    benchmarks.Measure(
+        fmt::format("OrderedList::MoveDown items={}", itemCount),
+        moveCount,
+        resetOrder,
+        [&]()
+        {
+            // Walk the first item down, one position per move.
+            for (size_t i = 0; i < moveCount; ++i)
+            {
+                model.MoveDown(0);
+            }
+        });
+
+    benchmarks.Measure(
+        fmt::format("OrderedList::MoveToTop items={}", itemCount),
+        moveCount,
+        resetOrder,
+        [&]()
+        {
+            for (size_t i = 0; i < moveCount; ++i)
+            {
+                model.MoveToTop(itemCount - 1 - i);
+            }
+        });
+
+    PEX_CLEAR_NAME(&model);
+}
+
+
+} // end anonymous namespace
+
+
+void RunOrderedListBenchmarks(Benchmarks &benchmarks)
+{
+    for (size_t itemCount: {1000, 10000})
+    {
+        MeasureMoves(benchmarks, itemCount);
+    }
+}
+
+
+} // end namespace benchmark
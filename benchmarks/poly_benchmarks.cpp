@@ -0,0 +1,146 @@
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+#include <pex/list.h>
+#include <pex/group.h>
+#include <pex/derived_group.h>
+#include "benchmark.h"
+
+
+namespace benchmark
+{
+
+
+namespace
+{
+
+
+class Shape: public pex::poly::PolyBase<nlohmann::json, Shape>
+{
+public:
+    using Json = nlohmann::json;
+
+    static constexpr auto polyTypeName = "Shape";
+};
+
+
+struct ShapeSupers
+{
+    using ValueBase = Shape;
+};
+
+
+template<typename T>
+class CircleFields
+{
+public:
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::x, "x"),
+        fields::Field(&T::y, "y"),
+        fields::Field(&T::radius, "radius"));
+};
+
+
+struct CircleTemplates
+{
+    using Supers = ShapeSupers;
+
+    template<template<typename> typename T>
+    class Template
+    {
+    public:
+        T<double> x;
+        T<double> y;
+        T<double> radius;
+
+        static constexpr auto fields = CircleFields<Template>::fields;
+        static constexpr auto fieldsTypeName = "Circle";
+    };
+};
+
+
+using CircleDerivedGroup =
+    pex::poly::DerivedGroup<CircleFields, CircleTemplates>;
+
+using Circle = typename CircleDerivedGroup::DerivedValue;
+using ValueWrapper = pex::poly::ValueWrapperTemplate<Shape>;
+
+
+template<typename T>
+struct DrawingFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::shapes, "shapes"));
+};
+
+
+template<template<typename> typename T>
+class DrawingTemplate
+{
+public:
+    T<pex::List<pex::MakePoly<ShapeSupers>>> shapes;
+
+    static constexpr auto fields = DrawingFields<DrawingTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Drawing";
+};
+
+
+using DrawingGroup = pex::Group<DrawingFields, DrawingTemplate>;
+using Drawing = typename DrawingGroup::Plain;
+using DrawingModel = typename DrawingGroup::Model;
+using DrawingControl = typename DrawingGroup::template Control<DrawingModel>;
+
+
+void MeasureJson(Benchmarks &benchmarks, size_t shapeCount)
+{
+    DrawingModel model;
+    PEX_ROOT(model);
+
+    DrawingControl control(model);
+
+    for (size_t i = 0; i < shapeCount; ++i)
+    {
+        auto value = static_cast<double>(i);
+
+        control.shapes.Append(
+            ValueWrapper::Create<Circle>(value, value, 1.0));
+    }
+
+    auto drawing = model.Get();
+    nlohmann::json unstructured;
+
+    benchmarks.Measure(
+        fmt::format("poly List Unstructure items={}", shapeCount),
+        shapeCount,
+        []() {},
+        [&]()
+        {
+            unstructured = fields::Unstructure<nlohmann::json>(drawing);
+        });
+
+    benchmarks.Measure(
+        fmt::format("poly List Structure items={}", shapeCount),
+        shapeCount,
+        []() {},
+        [&]()
+        {
+            auto recovered = fields::Structure<Drawing>(unstructured);
+            DoNotOptimize(recovered);
+        });
+
+    PEX_CLEAR_NAME(&model);
+}
+
+
+} // end anonymous namespace
+
+
+void RunPolyBenchmarks(Benchmarks &benchmarks)
+{
+    for (size_t shapeCount: {100, 1000})
+    {
+        MeasureJson(benchmarks, shapeCount);
+    }
+}
+
+
+} // end namespace benchmark
@@ -0,0 +1,176 @@
+#include <fmt/core.h>
+#include <memory>
+#include <vector>
+#include <pex/model_value.h>
+#include <pex/control_value.h>
+#include "benchmark.h"
+
+
+namespace benchmark
+{
+
+
+namespace
+{
+
+
+using Model = pex::model::Value<int>;
+
+
+struct Sink
+{
+    Sink()
+        :
+        value(0)
+    {
+        PEX_NAME("Sink");
+    }
+
+    ~Sink()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    static void OnValue(void *context, int value)
+    {
+        static_cast<Sink *>(context)->value = value;
+    }
+
+    int value;
+};
+
+
+// A chain of depth control::Values, each following the one before it.
+template<typename Upstream, size_t depth>
+struct ControlChain
+{
+    using Control = pex::control::Value<Upstream>;
+    using Next = ControlChain<Control, depth - 1>;
+    using Tail = typename Next::Tail;
+
+    ControlChain(Upstream &upstream)
+        :
+        control(upstream),
+        next(this->control)
+    {
+
+    }
+
+    Tail & GetTail()
+    {
+        return this->next.GetTail();
+    }
+
+    Control control;
+    Next next;
+};
+
+
+template<typename Upstream>
+struct ControlChain<Upstream, 0>
+{
+    using Tail = Upstream;
+
+    ControlChain(Upstream &upstream)
+        :
+        tail(upstream)
+    {
+
+    }
+
+    Tail & GetTail()
+    {
+        return this->tail;
+    }
+
+    Upstream &tail;
+};
+
+
+void MeasureSet(Benchmarks &benchmarks, size_t observerCount)
+{
+    static constexpr size_t operationCount = 10000;
+
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<Sink> sinks(observerCount);
+
+    for (auto &sink: sinks)
+    {
+        model.Connect(&sink, &Sink::OnValue);
+    }
+
+    benchmarks.Measure(
+        fmt::format("model::Value::Set observers={}", observerCount),
+        operationCount,
+        []() {},
+        [&model]()
+        {
+            for (size_t i = 0; i < operationCount; ++i)
+            {
+                model.Set(static_cast<int>(i));
+            }
+        });
+
+    for (auto &sink: sinks)
+    {
+        model.Disconnect(&sink);
+    }
+
+    PEX_CLEAR_NAME(&model);
+}
+
+
+template<size_t depth>
+void MeasureChain(Benchmarks &benchmarks)
+{
+    static constexpr size_t operationCount = 10000;
+
+    Model model;
+    PEX_ROOT(model);
+
+    // The chain is not copyable, and may be large.
+    auto chain = std::make_unique<ControlChain<Model, depth>>(model);
+    auto &tail = chain->GetTail();
+
+    Sink sink;
+    tail.Connect(&sink, &Sink::OnValue);
+
+    benchmarks.Measure(
+        fmt::format("control::Value chain depth={}", depth),
+        operationCount,
+        []() {},
+        [&model, &sink]()
+        {
+            for (size_t i = 0; i < operationCount; ++i)
+            {
+                model.Set(static_cast<int>(i));
+            }
+
+            DoNotOptimize(sink.value);
+        });
+
+    tail.Disconnect(&sink);
+    chain.reset();
+    PEX_CLEAR_NAME(&model);
+}
+
+
+} // end anonymous namespace
+
+
+void RunValueBenchmarks(Benchmarks &benchmarks)
+{
+    for (size_t observerCount: {0, 1, 8, 64})
+    {
+        MeasureSet(benchmarks, observerCount);
+    }
+
+    MeasureChain<1>(benchmarks);
+    MeasureChain<4>(benchmarks);
+    MeasureChain<16>(benchmarks);
+}
+
+
+} // end namespace benchmark
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <optional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <fields/assign.h>
 #include <jive/for_each.h>
@@ -8,6 +10,8 @@
 #include "pex/selectors.h"
 #include "pex/detail/value_connection.h"
 #include "pex/detail/aggregate.h"
+#include "pex/detail/generation.h"
+#include "pex/view.h"
 
 
 namespace pex
@@ -257,6 +261,91 @@ public:
             doNotify);
     }
 
+    /** The sum of the generations of the members that have one.
+     **
+     ** Members are never removed, so the sum only grows.
+     **/
+    uint64_t GetGeneration() const
+    {
+        auto derived = static_cast<const Derived *>(this);
+        uint64_t result = 0;
+
+        auto addGeneration = [derived, &result] (auto thisField)
+        {
+            using Member = typename std::remove_cvref_t<
+                decltype(derived->*(thisField.member))>;
+
+            if constexpr (detail::HasGetGeneration<Member>)
+            {
+                result += (derived->*(thisField.member)).GetGeneration();
+            }
+        };
+
+        jive::ForEach(
+            Fields<Derived>::fields,
+            addGeneration);
+
+        return result;
+    }
+
+    /** Each member with a generation also advances parent. **/
+    void SetGenerationParent(detail::Generation *parent)
+    {
+        auto derived = static_cast<Derived *>(this);
+
+        auto setParent = [derived, parent] (auto thisField)
+        {
+            using Member = typename std::remove_cvref_t<
+                decltype(derived->*(thisField.member))>;
+
+            if constexpr (detail::HasGenerationParent<Member>)
+            {
+                (derived->*(thisField.member)).SetGenerationParent(parent);
+            }
+        };
+
+        jive::ForEach(
+            Fields<Derived>::fields,
+            setParent);
+    }
+
+    /** True when every member with a value reports its changes to the
+     ** generation parent. A member without a generation, like a poly model,
+     ** changes without advancing the generation of the group.
+     **/
+    static constexpr bool MembersReportChanges()
+    {
+        return std::apply(
+            [](auto ...field)
+            {
+                return (MemberReportsChanges_<decltype(field)>() && ...);
+            },
+            Fields<Derived>::fields);
+    }
+
+    /** Each member that can be borrowed also refuses changes while parent
+     ** is borrowed.
+     **/
+    void SetBorrowsParent(const detail::Borrows *parent)
+    {
+        auto derived = static_cast<Derived *>(this);
+
+        auto setParent = [derived, parent] (auto thisField)
+        {
+            using Member = typename std::remove_cvref_t<
+                decltype(derived->*(thisField.member))>;
+
+            if constexpr (detail::HasBorrowsParent<Member>)
+            {
+                (derived->*(thisField.member)).SetBorrowsParent(parent);
+            }
+        };
+
+        jive::ForEach(
+            Fields<Derived>::fields,
+            setParent);
+    }
+
     template<typename>
     friend class Reference;
 
@@ -278,6 +367,18 @@ protected:
             Fields<Derived>::fields,
             Fields<Plain>::fields);
     }
+
+private:
+    template<typename Field>
+    static constexpr bool MemberReportsChanges_()
+    {
+        using Member = typename std::remove_cvref_t<
+            decltype(
+                std::declval<Derived &>().*(std::declval<Field>().member))>;
+
+        // Signals have no value to change.
+        return IsSignal<Member> || detail::ReportsChanges<Member>;
+    }
 };
 
 
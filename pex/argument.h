@@ -67,4 +67,10 @@ template<typename T>
 using Argument = typename detail::Argument_<T>::Type;
 
 
+// Types passed by const reference also have Set overloads that move from an
+// rvalue.
+template<typename T>
+concept MovableArgument = std::is_reference_v<Argument<T>>;
+
+
 } // namespace pex
@@ -0,0 +1,367 @@
+/**
+  * @file async_endpoint.h
+  *
+  * @brief An Endpoint that delivers notifications on an Executor.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "pex/endpoint.h"
+#include "pex/executor.h"
+
+
+namespace pex
+{
+
+
+enum class Coalesce
+{
+    // Every notification is delivered, in order.
+    none,
+
+    // Only the most recent notification waiting for delivery is kept.
+    latest
+};
+
+
+namespace detail
+{
+
+
+// Signals carry no value, so only the count of pending signals matters.
+template<typename Connection, typename = std::void_t<>>
+struct AsyncPending_
+{
+    static constexpr bool isSignal = true;
+    struct Type {};
+};
+
+
+template<typename Connection>
+struct AsyncPending_<Connection, std::void_t<typename Connection::Type>>
+{
+    static constexpr bool isSignal = false;
+    using Type = typename Connection::Type;
+};
+
+
+/**
+ ** Queues notifications for one observer, and drains them on an Executor.
+ **
+ ** At most one drain is scheduled at a time, so the observer receives its
+ ** notifications in order and never concurrently, even on a thread pool.
+ **
+ ** An exception thrown by the observer propagates to the executor. The
+ ** notifications still queued are delivered by another drain.
+ **
+ ** Tasks posted to the executor share ownership of the queue, so they may
+ ** safely run after the AsyncEndpoint is gone. A canceled queue does
+ ** nothing.
+ **/
+template<typename Connection>
+class AsyncQueue
+    :
+    public std::enable_shared_from_this<AsyncQueue<Connection>>
+{
+public:
+    static constexpr bool isSignal = AsyncPending_<Connection>::isSignal;
+
+    using Observer = typename Connection::Observer;
+    using Callable = typename Connection::Callable;
+
+    AsyncQueue(
+        Observer *observer,
+        Callable callable,
+        Executor &executor,
+        Coalesce coalesce)
+        :
+        connection_(observer, callable),
+        executor_(executor),
+        coalesce_(coalesce),
+        mutex_(),
+        isIdle_(),
+        pending_(),
+        isScheduled_(false),
+        isCanceled_(false),
+        runningThread_()
+    {
+
+    }
+
+    template<typename ...Value>
+    void Push(Value &&...value)
+    {
+        static_assert(sizeof...(Value) == (isSignal ? 0 : 1));
+
+        {
+            std::lock_guard lock(this->mutex_);
+
+            if (this->isCanceled_)
+            {
+                return;
+            }
+
+            if (this->coalesce_ == Coalesce::latest)
+            {
+                this->pending_.clear();
+            }
+
+            if constexpr (isSignal)
+            {
+                this->pending_.emplace_back();
+            }
+            else
+            {
+                this->pending_.emplace_back(std::forward<Value>(value)...);
+            }
+
+            if (this->isScheduled_)
+            {
+                return;
+            }
+
+            this->isScheduled_ = true;
+        }
+
+        this->Post_();
+    }
+
+    /** Discard pending notifications, and stop accepting new ones.
+     **
+     ** Waits for a callback in progress on another thread to return.
+     **/
+    void Cancel()
+    {
+        std::unique_lock lock(this->mutex_);
+
+        this->isCanceled_ = true;
+        this->pending_.clear();
+
+        this->isIdle_.wait(
+            lock,
+            [this]()
+            {
+                return this->runningThread_ == std::thread::id()
+                    || this->runningThread_ == std::this_thread::get_id();
+            });
+    }
+
+    size_t GetPendingCount() const
+    {
+        std::lock_guard lock(this->mutex_);
+
+        return this->pending_.size();
+    }
+
+private:
+    using Pending = typename AsyncPending_<Connection>::Type;
+
+    void Post_()
+    {
+        this->executor_.Post(
+            [self = this->shared_from_this()]()
+            {
+                self->Drain_();
+            });
+    }
+
+    void Drain_()
+    {
+        std::unique_lock lock(this->mutex_);
+
+        while (!this->pending_.empty() && !this->isCanceled_)
+        {
+            auto pending = std::move(this->pending_.front());
+            this->pending_.pop_front();
+            this->runningThread_ = std::this_thread::get_id();
+            lock.unlock();
+
+            try
+            {
+                if constexpr (isSignal)
+                {
+                    this->connection_();
+                }
+                else
+                {
+                    this->connection_(pending);
+                }
+            }
+            catch (...)
+            {
+                lock.lock();
+                this->runningThread_ = std::thread::id();
+                this->isIdle_.notify_all();
+
+                // The rest of the queue is delivered by another drain, so
+                // one failed callback does not stop the observer's
+                // notifications.
+                bool hasMore = !this->pending_.empty() && !this->isCanceled_;
+                this->isScheduled_ = hasMore;
+                lock.unlock();
+
+                if (hasMore)
+                {
+                    this->Post_();
+                }
+
+                throw;
+            }
+
+            lock.lock();
+            this->runningThread_ = std::thread::id();
+            this->isIdle_.notify_all();
+        }
+
+        this->isScheduled_ = false;
+    }
+
+    Connection connection_;
+    Executor &executor_;
+    Coalesce coalesce_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable isIdle_;
+    std::deque<Pending> pending_;
+    bool isScheduled_;
+    bool isCanceled_;
+    std::thread::id runningThread_;
+};
+
+
+} // end namespace detail
+
+
+/**
+ ** Like Endpoint, but the observer's callback runs on executor.
+ **
+ ** The upstream only queues the notification, so a slow observer does not
+ ** stall the thread that sets the model. Values are copied into the queue.
+ **
+ ** Use Coalesce::latest when the observer only needs the most recent value,
+ ** for example to redraw a display that is slower than the producer.
+ **
+ ** Destroying the AsyncEndpoint discards undelivered notifications, and
+ ** waits for a callback that is running on another thread.
+ **
+ ** The upstream is connected on the constructing thread. If the upstream
+ ** may be notifying on another thread at that moment, the model must use
+ ** the ConcurrentTag notify policy.
+ **/
+template<typename Observer, typename Upstream_>
+class AsyncEndpoint: Separator
+{
+public:
+    using InternalEndpoint = Endpoint<AsyncEndpoint, Upstream_>;
+    using Control = typename InternalEndpoint::Control;
+    using Upstream = typename InternalEndpoint::Upstream;
+
+    static constexpr bool isSignal = IsSignal<Upstream>;
+
+    // The same connection that a Terminus would make to the observer.
+    using Connection =
+        typename MakeConnection<Observer, Control>::Connection;
+
+    using Callable = typename Connection::Callable;
+
+    AsyncEndpoint(
+        Observer *observer,
+        Control upstream,
+        Callable callable,
+        Executor &executor,
+        Coalesce coalesce = Coalesce::none)
+        :
+        queue_(
+            std::make_shared<Queue>(observer, callable, executor, coalesce)),
+        endpoint(
+            PEX_THIS("AsyncEndpoint"),
+            upstream,
+            GetInternalCallable_())
+    {
+        PEX_MEMBER(endpoint);
+    }
+
+    AsyncEndpoint(
+        Observer *observer,
+        Upstream &upstream,
+        Callable callable,
+        Executor &executor,
+        Coalesce coalesce = Coalesce::none)
+        :
+        AsyncEndpoint(
+            observer,
+            Control(upstream),
+            callable,
+            executor,
+            coalesce)
+    {
+
+    }
+
+    // The internal endpoint observes this address.
+    AsyncEndpoint(const AsyncEndpoint &) = delete;
+    AsyncEndpoint(AsyncEndpoint &&) = delete;
+    AsyncEndpoint & operator=(const AsyncEndpoint &) = delete;
+    AsyncEndpoint & operator=(AsyncEndpoint &&) = delete;
+
+    ~AsyncEndpoint()
+    {
+        this->endpoint.Disconnect();
+        this->queue_->Cancel();
+
+        PEX_CLEAR_NAME(this);
+        PEX_CLEAR_NAME(&this->endpoint);
+    }
+
+    /** The number of notifications waiting to be delivered. **/
+    size_t GetPendingCount() const
+    {
+        return this->queue_->GetPendingCount();
+    }
+
+    explicit operator Control () const
+    {
+        return static_cast<Control>(this->endpoint);
+    }
+
+private:
+    using Queue = detail::AsyncQueue<Connection>;
+
+    static typename InternalEndpoint::Callable GetInternalCallable_()
+    {
+        if constexpr (isSignal)
+        {
+            return &AsyncEndpoint::OnInternalSignal_;
+        }
+        else
+        {
+            return &AsyncEndpoint::OnInternal_;
+        }
+    }
+
+    void OnInternalSignal_()
+    {
+        this->queue_->Push();
+    }
+
+    void OnInternal_(detail::InternalType<Upstream> value)
+    {
+        this->queue_->Push(value);
+    }
+
+    std::shared_ptr<Queue> queue_;
+    InternalEndpoint endpoint;
+};
+
+
+} // end namespace pex
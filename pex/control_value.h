@@ -48,7 +48,8 @@ class Value_
             typename UpstreamHolderT<Upstream_>::Type,
             Filter_
         >,
-        Access_
+        Access_,
+        NotifyPolicyT<Upstream_>
     >,
     Separator
 {
@@ -79,7 +80,9 @@ public:
     using Plain = Type;
 
     using Connection = ValueConnection<void, UpstreamType, Filter>;
-    using Base = detail::NotifyMany<Connection, Access>;
+
+    using Base =
+        detail::NotifyMany<Connection, Access, NotifyPolicyT<Upstream_>>;
 
     using Callable = typename Connection::Callable;
 
@@ -113,6 +116,11 @@ public:
         UpstreamHolder &upstream_;
         Value_ *observer_;
 
+        // upstreamConnection_ is only created while this is not connected, so
+        // there is no need for ConnectOnce to search the upstream's
+        // connections, and disconnecting by token avoids another search.
+        detail::ConnectionToken token_;
+
     public:
         using FunctionPointer = void (*)(void *, Argument<UpstreamType>);
 
@@ -122,9 +130,10 @@ public:
             FunctionPointer callable)
             :
             upstream_(upstream),
-            observer_(observer)
+            observer_(observer),
+            token_(this->upstream_.Connect(observer, callable))
         {
-            this->upstream_.ConnectOnce(observer, callable);
+
         }
 
         ~UpstreamConnection()
@@ -135,7 +144,7 @@ public:
                 " from ",
                 LookupPexName(&this->upstream_));
 
-            this->upstream_.Disconnect(this->observer_);
+            this->upstream_.Disconnect(this->token_);
         }
     };
 
@@ -538,7 +547,7 @@ public:
         return *this;
     }
 
-    void Connect(void *observer, Callable callable)
+    detail::ConnectionToken Connect(void *observer, Callable callable)
     {
         static_assert(HasAccess<GetTag, Access>);
 
@@ -554,10 +563,24 @@ public:
                 &Value_::OnUpstreamChanged_);
         }
 
-        this->Base::Connect(observer, callable);
+        return this->Base::Connect(observer, callable);
+    }
+
+    // Connect a callback that is known at compile time.
+    template<auto callback, typename T>
+    detail::ConnectionToken Connect(T *observer)
+    {
+        return this->Connect(
+            observer,
+            detail::BoundCallback
+            <
+                callback,
+                T,
+                typename Connection::FunctionPointer
+            >);
     }
 
-    void ConnectOnce(void *observer, Callable callable)
+    detail::ConnectionToken ConnectOnce(void *observer, Callable callable)
     {
         static_assert(HasAccess<GetTag, Access>);
 
@@ -572,7 +595,7 @@ public:
                 &Value_::OnUpstreamChanged_);
         }
 
-        this->Base::ConnectOnce(observer, callable);
+        return this->Base::ConnectOnce(observer, callable);
     }
 
     void Disconnect(void *observer)
@@ -587,6 +610,16 @@ public:
         }
     }
 
+    void Disconnect(detail::ConnectionToken token)
+    {
+        this->Base::Disconnect(token);
+
+        if (!this->HasConnections())
+        {
+            this->upstreamConnection_.reset();
+        }
+    }
+
     std::vector<size_t> GetNotificationOrderChain(void *observer)
     {
         auto upstreamChain = this->upstream_.GetNotificationOrderChain(this);
@@ -626,6 +659,47 @@ public:
         }
     }
 
+    /** The model's value, without a copy.
+     **
+     ** Only available without a filter, because a filtered value is a
+     ** temporary. The reference is invalidated by the next Set.
+     **/
+    const Type & GetRef() const
+        requires (
+            std::is_same_v<NoFilter, Filter>
+            && detail::HasGetRef<UpstreamHolder>)
+    {
+        static_assert(
+            HasAccess<GetTag, Access>,
+            "Cannot Get a write-only value.");
+
+        return this->upstream_.GetRef();
+    }
+
+    /** Borrow the model's value.
+     **
+     ** In debug builds, setting the value while the View exists throws
+     ** std::logic_error.
+     **/
+    pex::View<Type> View() const
+        requires (
+            std::is_same_v<NoFilter, Filter>
+            && detail::HasView<UpstreamHolder>)
+    {
+        static_assert(
+            HasAccess<GetTag, Access>,
+            "Cannot Get a write-only value.");
+
+        return this->upstream_.View();
+    }
+
+    /** The model's generation, which is advanced by every change. **/
+    uint64_t GetGeneration() const
+        requires detail::HasGetGeneration<UpstreamHolder>
+    {
+        return this->upstream_.GetGeneration();
+    }
+
     explicit operator Type () const
     {
         return this->Get();
@@ -647,12 +721,54 @@ public:
         }
     }
 
+    void Set(Type &&value) requires MovableArgument<Type>
+    {
+        static_assert(
+            HasAccess<SetTag, Access>,
+            "Cannot Set a read-only value.");
+
+        if constexpr (std::is_same_v<NoFilter, Filter>)
+        {
+            this->upstream_.Set(std::move(value));
+        }
+        else
+        {
+            this->upstream_.Set(this->FilterOnSet_(std::move(value)));
+        }
+    }
+
+    /** Set the value, and only notify if the model's value changes.
+     **
+     ** Returns true if the model notified its observers.
+     **/
+    bool SetIfChanged(Argument<Type> value)
+    {
+        static_assert(
+            HasAccess<SetTag, Access>,
+            "Cannot Set a read-only value.");
+
+        if constexpr (std::is_same_v<NoFilter, Filter>)
+        {
+            return this->upstream_.SetIfChanged(value);
+        }
+        else
+        {
+            return this->upstream_.SetIfChanged(this->FilterOnSet_(value));
+        }
+    }
+
     Value_ & operator=(Argument<Type> value)
     {
         this->Set(value);
         return *this;
     }
 
+    Value_ & operator=(Type &&value) requires MovableArgument<Type>
+    {
+        this->Set(std::move(value));
+        return *this;
+    }
+
     bool HasModel() const
     {
         return this->upstream_.HasModel();
@@ -686,11 +802,40 @@ protected:
         }
     }
 
+    void SetWithoutNotify_(Type &&value) requires MovableArgument<Type>
+    {
+        static_assert(
+            HasAccess<SetTag, Access>,
+            "Cannot Set a read-only value.");
+
+        if constexpr (std::is_same_v<NoFilter, Filter>)
+        {
+            this->upstream_.SetWithoutNotify_(std::move(value));
+        }
+        else
+        {
+            this->upstream_.SetWithoutNotify_(
+                this->FilterOnSet_(std::move(value)));
+        }
+    }
+
     UpstreamType FilterOnSet_(Argument<Type> value) const
+    {
+        return this->ApplySetFilter_(value);
+    }
+
+    UpstreamType FilterOnSet_(Type &&value) const requires MovableArgument<Type>
+    {
+        return this->ApplySetFilter_(std::move(value));
+    }
+
+    // Value is Argument<Type> or Type &&, which is moved into the filter.
+    template<typename Value>
+    UpstreamType ApplySetFilter_(Value &&value) const
     {
         if constexpr (std::is_same_v<NoFilter, Filter>)
         {
-            return value;
+            return std::forward<Value>(value);
         }
         else if constexpr (detail::SetterIsMember<UpstreamType, Filter>)
         {
@@ -703,11 +848,11 @@ protected:
                     return {};
                 }
 
-                return this->filter_->Set(*value);
+                return this->filter_->Set(*std::forward<Value>(value));
             }
             else
             {
-                return this->filter_->Set(value);
+                return this->filter_->Set(std::forward<Value>(value));
             }
         }
         else
@@ -720,11 +865,11 @@ protected:
                     return {};
                 }
 
-                return Filter::Set(*value);
+                return Filter::Set(*std::forward<Value>(value));
             }
             else
             {
-                return Filter::Set(value);
+                return Filter::Set(std::forward<Value>(value));
             }
         }
     }
@@ -834,6 +979,8 @@ public:
     using Type = typename Base::Type;
     using ValueType = typename Type::value_type;
     using Access = typename Base::Access;
+    using ElementChanges = typename Base::UpstreamHolder::ElementChanges;
+    using ElementCallable = typename Base::UpstreamHolder::ElementCallable;
 
     template <typename, typename, typename>
     friend class ::pex::control::Value_;
@@ -841,6 +988,9 @@ public:
     template<typename>
     friend class ::pex::Reference;
 
+    template<typename>
+    friend class ::pex::DeferValueContainer;
+
     template<typename>
     friend class ::pex::ConstControlReference;
 
@@ -856,8 +1006,31 @@ public:
     void Set(size_t index, Argument<ValueType> value)
         requires (HasAccess<SetTag, Access>)
     {
-        this->SetWithoutNotify_(index, value);
-        this->Notify();
+        this->upstream_.Set(index, value);
+    }
+
+    detail::ConnectionToken ConnectElements(
+        void *observer,
+        ElementCallable callable)
+    {
+        return this->upstream_.ConnectElements(observer, callable);
+    }
+
+    void DisconnectElements(void *observer)
+    {
+        this->upstream_.DisconnectElements(observer);
+    }
+
+    void DisconnectElements(detail::ConnectionToken token)
+    {
+        this->upstream_.DisconnectElements(token);
+    }
+
+    using Base::Notify;
+
+    void Notify(const ElementChanges &changes)
+    {
+        this->upstream_.Notify(changes);
     }
 
     Type Get(size_t index) const
@@ -890,7 +1063,7 @@ public:
 protected:
     using Base::SetWithoutNotify_;
 
-    void SetWithoutNotify_(size_t index, Argument<Type> value)
+    void SetWithoutNotify_(size_t index, Argument<ValueType> value)
     {
         this->upstream_.SetWithoutNotify_(index, value);
     }
@@ -913,6 +1086,8 @@ public:
     using MappedType = typename Type::mapped_type;
     using KeyType = typename Type::key_type;
     using Access = typename Base::Access;
+    using ElementChanges = typename Base::UpstreamHolder::ElementChanges;
+    using ElementCallable = typename Base::UpstreamHolder::ElementCallable;
 
     template<typename>
     friend class ::pex::Transaction;
@@ -920,6 +1095,9 @@ public:
     template<typename>
     friend class ::pex::Reference;
 
+    template<typename>
+    friend class ::pex::DeferKeyValueContainer;
+
     template<typename>
     friend class ::pex::ConstReference;
 
@@ -933,8 +1111,31 @@ public:
     void Set(const KeyType &key, Argument<MappedType> value)
         requires (HasAccess<SetTag, Access>)
     {
-        this->SetWithoutNotify_(key, value);
-        this->Notify();
+        this->upstream_.Set(key, value);
+    }
+
+    detail::ConnectionToken ConnectElements(
+        void *observer,
+        ElementCallable callable)
+    {
+        return this->upstream_.ConnectElements(observer, callable);
+    }
+
+    void DisconnectElements(void *observer)
+    {
+        this->upstream_.DisconnectElements(observer);
+    }
+
+    void DisconnectElements(detail::ConnectionToken token)
+    {
+        this->upstream_.DisconnectElements(token);
+    }
+
+    using Base::Notify;
+
+    void Notify(const ElementChanges &changes)
+    {
+        this->upstream_.Notify(changes);
     }
 
     Type Get(const KeyType &key) const
@@ -967,7 +1168,7 @@ protected:
 
     void SetWithoutNotify_(const KeyType &key, Argument<MappedType> value)
     {
-        this->upstream_[key] = value;
+        this->upstream_.SetWithoutNotify_(key, value);
     }
 };
 
@@ -0,0 +1,597 @@
+/**
+  * @file concurrent_connections.h
+  *
+  * @brief Stores connections in immutable snapshots, so that notifications
+  * on one thread never wait for connection changes on another.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "pex/detail/connection_slots.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+// The ConcurrentConnections with a notification in progress on this thread,
+// innermost last.
+inline thread_local std::vector<const void *> concurrentNotifiers;
+
+
+/**
+ ** Copy-on-write connections for the ConcurrentTag notify policy.
+ **
+ ** Notifications iterate an immutable snapshot that is read with a few
+ ** atomic operations and without locking.
+ **
+ ** Changes are serialized by a mutex that notifications never take. Each
+ ** change publishes a new snapshot and retires the old one. A retired
+ ** snapshot is deleted once every notification that could have read it has
+ ** finished, which is tracked with two reader counts and an epoch:
+ **
+ **  - A notification registers in the count for the current epoch.
+ **  - The epoch may only advance when the count for the previous epoch has
+ **    drained, so no notification is still reading a snapshot retired two
+ **    epochs ago.
+ **
+ ** Writers advance the epoch opportunistically and never wait for
+ ** notifications. Synchronize is the exception; see below.
+ **/
+template<typename ConnectionType>
+class ConcurrentConnections
+{
+public:
+    using Observer = typename ConnectionType::Observer;
+
+private:
+    struct Snapshot
+    {
+        std::vector<ConnectionType> connections;
+        std::vector<uint32_t> ids;
+    };
+
+    struct Retired
+    {
+        Snapshot *snapshot;
+        uint64_t epoch;
+    };
+
+public:
+    /**
+     ** Holds the current snapshot for the lifetime of the Deferral.
+     **
+     ** Changes made during a notification are published immediately, but
+     ** the notification continues with the snapshot it started with.
+     **/
+    class [[nodiscard]] Deferral
+    {
+    public:
+        Deferral(const ConcurrentConnections &connections)
+            :
+            connections_(connections),
+            epoch_(connections.EnterReader_()),
+            snapshot_(connections.current_.load())
+        {
+            concurrentNotifiers.push_back(&connections);
+        }
+
+        ~Deferral()
+        {
+            assert(concurrentNotifiers.back() == &this->connections_);
+            concurrentNotifiers.pop_back();
+            this->connections_.ExitReader_(this->epoch_);
+        }
+
+        Deferral(const Deferral &) = delete;
+        Deferral & operator=(const Deferral &) = delete;
+
+        ConnectionType * begin()
+        {
+            if (!this->snapshot_)
+            {
+                return nullptr;
+            }
+
+            return this->snapshot_->connections.data();
+        }
+
+        ConnectionType * end()
+        {
+            if (!this->snapshot_)
+            {
+                return nullptr;
+            }
+
+            return this->begin() + this->snapshot_->connections.size();
+        }
+
+        const Snapshot * GetSnapshot() const
+        {
+            return this->snapshot_;
+        }
+
+    private:
+        const ConcurrentConnections &connections_;
+        uint64_t epoch_;
+        Snapshot *snapshot_;
+    };
+
+    using WriteLock = std::unique_lock<std::recursive_mutex>;
+
+    ConcurrentConnections()
+        :
+        current_(nullptr),
+        epoch_(0),
+        readers_{},
+        hasRetired_(false),
+        writeMutex_(),
+        retired_(),
+        lastRetiredEpoch_(0),
+        nextId_(0)
+    {
+
+    }
+
+    ConcurrentConnections(const ConcurrentConnections &other)
+        :
+        ConcurrentConnections()
+    {
+        this->CopyFrom_(other);
+    }
+
+    ConcurrentConnections & operator=(const ConcurrentConnections &other)
+    {
+        if (&other != this)
+        {
+            this->clear();
+            this->CopyFrom_(other);
+        }
+
+        return *this;
+    }
+
+    // Moving requires that neither side is being used on another thread.
+    ConcurrentConnections(ConcurrentConnections &&other) noexcept
+        :
+        ConcurrentConnections()
+    {
+        this->current_.store(other.current_.exchange(nullptr));
+        this->nextId_ = other.nextId_;
+    }
+
+    // The replaced connections are retired like any other change, so a
+    // notification that is still reading them on another thread can finish.
+    ConcurrentConnections & operator=(ConcurrentConnections &&other) noexcept
+    {
+        if (&other != this)
+        {
+            {
+                WriteLock lock(this->writeMutex_);
+                this->Publish_(other.current_.exchange(nullptr));
+                this->nextId_ = std::max(this->nextId_, other.nextId_);
+            }
+
+            this->Synchronize();
+        }
+
+        return *this;
+    }
+
+    ~ConcurrentConnections()
+    {
+        assert(this->readers_[0] == 0 && this->readers_[1] == 0);
+
+        delete this->current_.load();
+
+        for (auto &retired: this->retired_)
+        {
+            delete retired.snapshot;
+        }
+    }
+
+    /**
+     ** Serializes changes with other threads.
+     **
+     ** Each change takes the lock itself. Hold it across several changes to
+     ** apply them without interruption.
+     **/
+    WriteLock LockWriters()
+    {
+        return WriteLock(this->writeMutex_);
+    }
+
+    /**
+     ** Waits until no notification is using a connection that has been
+     ** removed.
+     **
+     ** Returns immediately when called from a notification of these
+     ** connections on this thread, because waiting for the notification
+     ** that called it would never end. A call from a notification of other
+     ** connections still waits.
+     **
+     ** Must not be called while holding a lock that a callback may take.
+     **/
+    void Synchronize()
+    {
+        if (this->IsNotifyingOnThisThread_())
+        {
+            return;
+        }
+
+        while (true)
+        {
+            {
+                WriteLock lock(this->writeMutex_);
+
+                if (this->retired_.empty())
+                {
+                    return;
+                }
+
+                this->TryReclaim_();
+
+                if (this->epoch_.load() >= this->lastRetiredEpoch_ + 2)
+                {
+                    return;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    bool IsDeferring() const
+    {
+        return (this->readers_[0].load() + this->readers_[1].load()) > 0;
+    }
+
+    /** Appends a connection, returning the token that identifies it. **/
+    template<typename ...Args>
+    ConnectionToken Emplace(Args &&...args)
+    {
+        WriteLock lock(this->writeMutex_);
+
+        auto snapshot = this->CopyCurrent_();
+        auto id = this->nextId_++;
+        assert(id != ConnectionToken::npos);
+
+        snapshot->connections.emplace_back(std::forward<Args>(args)...);
+        snapshot->ids.push_back(id);
+        this->Publish_(snapshot);
+
+        return {id, 1};
+    }
+
+    bool Contains(ConnectionToken token) const
+    {
+        Deferral deferral(*this);
+
+        return GetIndex_(deferral.GetSnapshot(), token).has_value();
+    }
+
+    /** Returns a copy, or nothing if the token is no longer valid. **/
+    std::optional<ConnectionType> Find(ConnectionToken token) const
+    {
+        Deferral deferral(*this);
+        auto snapshot = deferral.GetSnapshot();
+        auto index = GetIndex_(snapshot, token);
+
+        if (!index)
+        {
+            return {};
+        }
+
+        return snapshot->connections[*index];
+    }
+
+    /** Returns the token of the first connection made by observer. **/
+    std::optional<ConnectionToken> Find(const Observer *observer) const
+    {
+        Deferral deferral(*this);
+        auto snapshot = deferral.GetSnapshot();
+        auto index = GetIndex_(snapshot, observer);
+
+        if (!index)
+        {
+            return {};
+        }
+
+        return ConnectionToken{snapshot->ids[*index], 1};
+    }
+
+    /** Returns false if the token is no longer valid. **/
+    bool Erase(ConnectionToken token)
+    {
+        WriteLock lock(this->writeMutex_);
+
+        auto index = GetIndex_(this->current_.load(), token);
+
+        if (!index)
+        {
+            return false;
+        }
+
+        auto snapshot = this->CopyCurrent_();
+        snapshot->connections.erase(
+            std::next(snapshot->connections.begin(), *index));
+
+        snapshot->ids.erase(std::next(snapshot->ids.begin(), *index));
+        this->Publish_(snapshot);
+
+        return true;
+    }
+
+    /** Removes all connections made by observer, returning the count. **/
+    size_t Erase(const Observer *observer)
+    {
+        WriteLock lock(this->writeMutex_);
+
+        auto current = this->current_.load();
+
+        if (!GetIndex_(current, observer))
+        {
+            return 0;
+        }
+
+        auto snapshot = new Snapshot{};
+
+        for (size_t i = 0; i < current->connections.size(); ++i)
+        {
+            if (current->connections[i].GetObserver() != observer)
+            {
+                snapshot->connections.push_back(current->connections[i]);
+                snapshot->ids.push_back(current->ids[i]);
+            }
+        }
+
+        auto erasedCount =
+            current->connections.size() - snapshot->connections.size();
+
+        this->Publish_(snapshot);
+
+        return erasedCount;
+    }
+
+    /** The position of the observer's first connection in callback order. **/
+    std::optional<size_t> GetOrder(const Observer *observer) const
+    {
+        Deferral deferral(*this);
+
+        return GetIndex_(deferral.GetSnapshot(), observer);
+    }
+
+    void clear()
+    {
+        WriteLock lock(this->writeMutex_);
+
+        if (this->current_.load())
+        {
+            this->Publish_(nullptr);
+        }
+    }
+
+    size_t size() const
+    {
+        Deferral deferral(*this);
+        auto snapshot = deferral.GetSnapshot();
+
+        if (!snapshot)
+        {
+            return 0;
+        }
+
+        return snapshot->connections.size();
+    }
+
+    bool empty() const
+    {
+        return this->size() == 0;
+    }
+
+private:
+    bool IsNotifyingOnThisThread_() const
+    {
+        return std::find(
+            std::begin(concurrentNotifiers),
+            std::end(concurrentNotifiers),
+            static_cast<const void *>(this)) != std::end(concurrentNotifiers);
+    }
+
+    uint64_t EnterReader_() const
+    {
+        while (true)
+        {
+            auto epoch = this->epoch_.load();
+            auto &readers = this->readers_[epoch & 1];
+            ++readers;
+
+            // Registration is only valid if the epoch did not advance before
+            // it was counted.
+            if (this->epoch_.load() == epoch)
+            {
+                return epoch;
+            }
+
+            --readers;
+        }
+    }
+
+    void ExitReader_(uint64_t epoch) const
+    {
+        --this->readers_[epoch & 1];
+
+        if (this->hasRetired_.load(std::memory_order_relaxed))
+        {
+            // Reclaim only if it does not require waiting for a writer.
+            std::unique_lock lock(this->writeMutex_, std::try_to_lock);
+
+            if (lock.owns_lock())
+            {
+                this->TryReclaim_();
+            }
+        }
+    }
+
+    // Must be called with writeMutex_ held.
+    void TryReclaim_() const
+    {
+        // Each retired snapshot needs at most two advances.
+        for (int i = 0; i < 2; ++i)
+        {
+            auto epoch = this->epoch_.load();
+
+            if (this->readers_[(epoch + 1) & 1].load() != 0)
+            {
+                break;
+            }
+
+            this->epoch_.store(epoch + 1);
+        }
+
+        auto epoch = this->epoch_.load();
+
+        auto reclaimable = std::partition(
+            std::begin(this->retired_),
+            std::end(this->retired_),
+            [epoch](const Retired &retired)
+            {
+                return retired.epoch + 2 > epoch;
+            });
+
+        for (auto it = reclaimable; it != std::end(this->retired_); ++it)
+        {
+            delete it->snapshot;
+        }
+
+        this->retired_.erase(reclaimable, std::end(this->retired_));
+        this->hasRetired_.store(!this->retired_.empty());
+    }
+
+    // Must be called with writeMutex_ held.
+    Snapshot * CopyCurrent_() const
+    {
+        auto current = this->current_.load();
+
+        if (!current)
+        {
+            return new Snapshot{};
+        }
+
+        return new Snapshot(*current);
+    }
+
+    // Must be called with writeMutex_ held.
+    void Publish_(Snapshot *snapshot)
+    {
+        if (snapshot && snapshot->connections.empty())
+        {
+            delete snapshot;
+            snapshot = nullptr;
+        }
+
+        auto previous = this->current_.exchange(snapshot);
+
+        if (previous)
+        {
+            this->lastRetiredEpoch_ = this->epoch_.load();
+            this->retired_.push_back({previous, this->lastRetiredEpoch_});
+            this->hasRetired_.store(true);
+        }
+
+        this->TryReclaim_();
+    }
+
+    void CopyFrom_(const ConcurrentConnections &other)
+    {
+        Deferral deferral(other);
+        auto snapshot = deferral.GetSnapshot();
+
+        WriteLock lock(this->writeMutex_);
+        this->nextId_ = std::max(this->nextId_, other.nextId_);
+
+        if (snapshot)
+        {
+            this->Publish_(new Snapshot(*snapshot));
+        }
+    }
+
+    static std::optional<size_t> GetIndex_(
+        const Snapshot *snapshot,
+        ConnectionToken token)
+    {
+        if (!snapshot || token.generation != 1)
+        {
+            return {};
+        }
+
+        auto found = std::find(
+            std::begin(snapshot->ids),
+            std::end(snapshot->ids),
+            token.index);
+
+        if (found == std::end(snapshot->ids))
+        {
+            return {};
+        }
+
+        return static_cast<size_t>(
+            std::distance(std::begin(snapshot->ids), found));
+    }
+
+    static std::optional<size_t> GetIndex_(
+        const Snapshot *snapshot,
+        const Observer *observer)
+    {
+        if (!snapshot)
+        {
+            return {};
+        }
+
+        for (size_t i = 0; i < snapshot->connections.size(); ++i)
+        {
+            if (snapshot->connections[i].GetObserver() == observer)
+            {
+                return i;
+            }
+        }
+
+        return {};
+    }
+
+    std::atomic<Snapshot *> current_;
+
+    // Reclamation state is mutable so that const readers can help reclaim.
+    mutable std::atomic<uint64_t> epoch_;
+    mutable std::atomic<size_t> readers_[2];
+    mutable std::atomic<bool> hasRetired_;
+    mutable std::recursive_mutex writeMutex_;
+    mutable std::vector<Retired> retired_;
+
+    uint64_t lastRetiredEpoch_;
+    uint32_t nextId_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace pex
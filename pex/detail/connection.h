@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <type_traits>
+#include <functional>
 #include "jive/compare.h"
 #include <optional>
 
@@ -25,29 +26,67 @@ namespace detail
 {
 
 
+// The plain function pointer that a std::function Callable may hold.
+// Member function Callables have none.
+template<typename Callable>
+struct FunctionPointer_
+{
+    using Type = void;
+};
+
+template<typename ...Args>
+struct FunctionPointer_<std::function<void(Args...)>>
+{
+    using Type = void (*)(Args...);
+};
+
+
+struct NoFunctionPointer {};
+
+
 template<typename Observer_, typename Callable_>
 class Connection: jive::Compare<Connection<Observer_, Callable_>>
 {
 public:
     using Observer = Observer_;
     using Callable = Callable_;
+    using FunctionPointer = typename FunctionPointer_<Callable>::Type;
 
     static constexpr auto IsMemberFunction =
         std::is_member_function_pointer_v<Callable>;
 
+    static constexpr bool hasFunctionPointer =
+        !std::is_void_v<FunctionPointer>;
+
     Connection(Observer *observer, Callable callable)
         :
         observer_(observer),
-        callable_(callable)
+        callable_{},
+        function_{}
     {
+        if constexpr (hasFunctionPointer)
+        {
+            // A plain function is stored and called directly, without the
+            // indirection of std::function.
+            auto function = callable.template target<FunctionPointer>();
 
+            if (function)
+            {
+                this->function_ = *function;
+
+                return;
+            }
+        }
+
+        this->callable_ = std::move(callable);
     }
 
     /** Conversion from observer pointer for comparisons. **/
     explicit Connection(Observer *observer)
         :
         observer_(observer),
-        callable_{}
+        callable_{},
+        function_{}
     {
 
     }
@@ -55,7 +94,8 @@ public:
     Connection(const Connection &other)
         :
         observer_(other.observer_),
-        callable_(other.callable_)
+        callable_(other.callable_),
+        function_(other.function_)
     {
 
     }
@@ -64,6 +104,7 @@ public:
     {
         this->observer_ = other.observer_;
         this->callable_ = other.callable_;
+        this->function_ = other.function_;
 
         return *this;
     }
@@ -87,15 +128,92 @@ public:
 
     Callable GetCallable() const
     {
+        if constexpr (hasFunctionPointer)
+        {
+            if (this->function_)
+            {
+                return this->function_;
+            }
+        }
+
         return this->callable_;
     }
 
 protected:
+    template<typename ...Args>
+    void Call_(Args &&...args)
+    {
+        if constexpr (IsMemberFunction)
+        {
+            static_assert(
+                !std::is_same_v<Observer, void>,
+                "Cannot call member function on void type.");
+
+            (this->observer_->*(this->callable_))(std::forward<Args>(args)...);
+        }
+        else
+        {
+            if constexpr (hasFunctionPointer)
+            {
+                if (this->function_)
+                {
+                    this->function_(
+                        this->observer_,
+                        std::forward<Args>(args)...);
+
+                    return;
+                }
+            }
+
+            this->callable_(this->observer_, std::forward<Args>(args)...);
+        }
+    }
+
     Observer * observer_;
     Callable callable_;
+
+    [[no_unique_address]]
+    std::conditional_t
+    <
+        hasFunctionPointer,
+        FunctionPointer,
+        NoFunctionPointer
+    > function_;
 };
 
 
+template<auto callback, typename Observer, typename FunctionPointer>
+struct BoundCallback_;
+
+template<auto callback, typename Observer, typename ...Args>
+struct BoundCallback_<callback, Observer, void (*)(void *, Args...)>
+{
+    static void Call(void *observer, Args ...args)
+    {
+        auto self = static_cast<Observer *>(observer);
+
+        if constexpr (std::is_member_function_pointer_v<decltype(callback)>)
+        {
+            (self->*callback)(std::forward<Args>(args)...);
+        }
+        else
+        {
+            callback(self, std::forward<Args>(args)...);
+        }
+    }
+};
+
+
+/** A function pointer that calls callback on an Observer.
+ **
+ ** callback is known at compile time, so the call to it is made directly,
+ ** and can be inlined.
+ **/
+template<auto callback, typename Observer, typename FunctionPointer>
+inline constexpr FunctionPointer BoundCallback =
+    &BoundCallback_<callback, Observer, FunctionPointer>::Call;
+
+
 } // namespace detail
 
 
@@ -0,0 +1,889 @@
+/**
+  * @file connection_slots.h
+  *
+  * @brief Stores connections in stable slots, so that a connection can be
+  * found and removed by token in constant time.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "pex/detail/small_vector.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+/**
+ ** Returned by Connect.
+ **
+ ** A token refers to one connection, and is invalidated when that
+ ** connection is removed. The generation guards against a stale token
+ ** matching a later connection that reuses the same slot.
+ **/
+struct ConnectionToken
+{
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    uint32_t index = npos;
+    uint32_t generation = 0;
+
+    bool operator==(const ConnectionToken &) const = default;
+};
+
+
+/**
+ ** A slot map of connections.
+ **
+ ** Slots never move while they are occupied, and vacant slots are reused.
+ ** The occupied slots are threaded on a doubly-linked list in the order the
+ ** connections were made, so callbacks are still executed in connection
+ ** order regardless of which slot a connection occupies.
+ **
+ ** Removal by token is constant time. Searches by observer are linear.
+ **
+ ** While a Deferral exists (NotifyMany_ holds one during Notify_), the
+ ** connections may still be changed, but the changes are not applied to the
+ ** linked list until the outermost Deferral is destroyed:
+ **
+ **  - Removed connections are skipped immediately, but their slots (and
+ **    their callables, which may be executing) are kept until the end.
+ **  - New connections receive their token immediately, but are not visited
+ **    until the next iteration. If there is no room for a new slot without
+ **    reallocating the slots that are being iterated, the connection waits
+ **    in a separate queue for the slot it has been promised.
+ **/
+template<typename ConnectionType, size_t inlineCount>
+class ConnectionSlots
+{
+public:
+    using Observer = typename ConnectionType::Observer;
+
+private:
+    static constexpr auto npos = ConnectionToken::npos;
+
+    struct Slot
+    {
+        std::optional<ConnectionType> connection;
+        uint32_t generation = 0;
+        uint32_t previous = npos;
+        uint32_t next = npos;
+
+        // Set when the connection is removed during a deferral.
+        bool isRemoved = false;
+
+        // False for connections made during a deferral, until they are
+        // appended to the linked list.
+        bool isLinked = false;
+
+        bool IsLive() const
+        {
+            return this->connection.has_value() && !this->isRemoved;
+        }
+    };
+
+    // A connection made during a deferral when no slot was available.
+    struct Waiting
+    {
+        ConnectionType connection;
+        bool isRemoved;
+    };
+
+    // Changes made during a deferral.
+    // Only allocated when there are any, so that the common case of a node
+    // that is never modified from a callback does not pay for it.
+    struct Deferred
+    {
+        // Slots of new connections, to be linked in order.
+        std::vector<uint32_t> links;
+
+        // Linked slots to be unlinked and vacated.
+        std::vector<uint32_t> removals;
+
+        std::vector<Waiting> waiting;
+    };
+
+    using Slots = SmallVector<Slot, inlineCount>;
+
+public:
+    template<typename Connections, typename Value>
+    class Iterator_
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ConnectionType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+
+        Iterator_()
+            :
+            connections_(nullptr),
+            index_(npos)
+        {
+
+        }
+
+        Iterator_(Connections *connections, uint32_t index)
+            :
+            connections_(connections),
+            index_(index)
+        {
+            this->SkipRemoved_();
+        }
+
+        reference operator*() const
+        {
+            return *this->connections_->slots_[this->index_].connection;
+        }
+
+        pointer operator->() const
+        {
+            return &(**this);
+        }
+
+        Iterator_ & operator++()
+        {
+            this->index_ = this->connections_->slots_[this->index_].next;
+            this->SkipRemoved_();
+
+            return *this;
+        }
+
+        Iterator_ operator++(int)
+        {
+            auto result = *this;
+            ++(*this);
+
+            return result;
+        }
+
+        bool operator==(const Iterator_ &other) const
+        {
+            return this->index_ == other.index_;
+        }
+
+        ConnectionToken GetToken() const
+        {
+            return {
+                this->index_,
+                this->connections_->slots_[this->index_].generation};
+        }
+
+    private:
+        void SkipRemoved_()
+        {
+            while (
+                this->index_ != npos
+                && this->connections_->slots_[this->index_].isRemoved)
+            {
+                this->index_ = this->connections_->slots_[this->index_].next;
+            }
+        }
+
+        Connections *connections_;
+        uint32_t index_;
+    };
+
+    using iterator = Iterator_<ConnectionSlots, ConnectionType>;
+
+    using const_iterator =
+        Iterator_<const ConnectionSlots, const ConnectionType>;
+
+    /**
+     ** Defers changes to the linked list for the lifetime of the Deferral.
+     ** Deferrals may be nested.
+     **/
+    class [[nodiscard]] Deferral
+    {
+    public:
+        Deferral(ConnectionSlots &slots)
+            :
+            slots_(slots)
+        {
+            ++this->slots_.deferralCount_;
+        }
+
+        ~Deferral()
+        {
+            if (--this->slots_.deferralCount_ == 0)
+            {
+                this->slots_.ApplyDeferred_();
+            }
+        }
+
+        Deferral(const Deferral &) = delete;
+        Deferral & operator=(const Deferral &) = delete;
+
+        iterator begin() { return this->slots_.begin(); }
+        iterator end() { return this->slots_.end(); }
+
+    private:
+        ConnectionSlots &slots_;
+    };
+
+    // ConnectionSlots is not synchronized, so there is nothing to lock.
+    struct [[nodiscard]] WriteLock {};
+
+    WriteLock LockWriters()
+    {
+        return {};
+    }
+
+    // Removed connections are never called once Erase returns.
+    void Synchronize()
+    {
+
+    }
+
+    ConnectionSlots()
+        :
+        slots_{},
+        first_(npos),
+        last_(npos),
+        vacant_(npos),
+        count_(0),
+        deferralCount_(0),
+        deferred_{}
+    {
+
+    }
+
+    // A copy contains the other's connections in callback order, as though
+    // any deferred changes had already been applied.
+    ConnectionSlots(const ConnectionSlots &other)
+        :
+        ConnectionSlots()
+    {
+        this->CopyFrom_(other);
+    }
+
+    ConnectionSlots & operator=(const ConnectionSlots &other)
+    {
+        assert(!this->IsDeferring());
+
+        if (&other != this)
+        {
+            this->Reset_();
+            this->CopyFrom_(other);
+        }
+
+        return *this;
+    }
+
+    ConnectionSlots(ConnectionSlots &&other) noexcept
+        :
+        slots_(std::move(other.slots_)),
+        first_(other.first_),
+        last_(other.last_),
+        vacant_(other.vacant_),
+        count_(other.count_),
+        deferralCount_(0),
+        deferred_{}
+    {
+        assert(!other.IsDeferring());
+        other.Reset_();
+    }
+
+    ConnectionSlots & operator=(ConnectionSlots &&other) noexcept
+    {
+        assert(!this->IsDeferring());
+        assert(!other.IsDeferring());
+
+        if (&other != this)
+        {
+            this->slots_ = std::move(other.slots_);
+            this->first_ = other.first_;
+            this->last_ = other.last_;
+            this->vacant_ = other.vacant_;
+            this->count_ = other.count_;
+            other.Reset_();
+        }
+
+        return *this;
+    }
+
+    bool IsDeferring() const
+    {
+        return this->deferralCount_ > 0;
+    }
+
+    /** Appends a connection, returning the token that identifies it. **/
+    template<typename ...Args>
+    ConnectionToken Emplace(Args &&...args)
+    {
+        uint32_t index;
+
+        if (this->vacant_ != npos)
+        {
+            index = this->vacant_;
+            this->vacant_ = this->slots_[index].next;
+        }
+        else if (
+            this->IsDeferring()
+            && (this->GetWaitingCount_() > 0
+                || this->slots_.size() == this->slots_.capacity()))
+        {
+            // A new slot would reallocate the slots that are being
+            // iterated. Promise the next slot after any others that are
+            // waiting, and create it when the deferral ends.
+            auto &waiting = this->GetDeferred_().waiting;
+            assert(this->slots_.size() + waiting.size() < npos);
+
+            index = static_cast<uint32_t>(
+                this->slots_.size() + waiting.size());
+
+            waiting.push_back(
+                Waiting{ConnectionType(std::forward<Args>(args)...), false});
+
+            ++this->count_;
+
+            // The generation of a new slot's first connection.
+            return {index, 1};
+        }
+        else
+        {
+            assert(this->slots_.size() < npos);
+            index = static_cast<uint32_t>(this->slots_.size());
+            this->slots_.emplace_back();
+        }
+
+        auto &slot = this->slots_[index];
+        assert(!slot.connection);
+
+        slot.connection.emplace(std::forward<Args>(args)...);
+        ++slot.generation;
+        ++this->count_;
+
+        if (this->IsDeferring())
+        {
+            this->GetDeferred_().links.push_back(index);
+        }
+        else
+        {
+            this->Link_(index);
+        }
+
+        return {index, slot.generation};
+    }
+
+    bool Contains(ConnectionToken token) const
+    {
+        if (token.index < this->slots_.size())
+        {
+            const auto &slot = this->slots_[token.index];
+            return slot.IsLive() && (slot.generation == token.generation);
+        }
+
+        auto waiting = this->FindWaiting_(token);
+
+        return waiting && !waiting->isRemoved;
+    }
+
+    /** Returns nullptr if the token is no longer valid. **/
+    ConnectionType * Find(ConnectionToken token)
+    {
+        if (!this->Contains(token))
+        {
+            return nullptr;
+        }
+
+        if (token.index < this->slots_.size())
+        {
+            return &(*this->slots_[token.index].connection);
+        }
+
+        return &this->FindWaiting_(token)->connection;
+    }
+
+    /** Returns the token of the first connection made by observer.
+     **
+     ** Linear in the number of connections.
+     **/
+    std::optional<ConnectionToken> Find(const Observer *observer) const
+    {
+        for (auto it = this->begin(); it != this->end(); ++it)
+        {
+            if (it->GetObserver() == observer)
+            {
+                return it.GetToken();
+            }
+        }
+
+        if (!this->deferred_)
+        {
+            return {};
+        }
+
+        for (auto index: this->deferred_->links)
+        {
+            const auto &slot = this->slots_[index];
+
+            if (slot.IsLive() && slot.connection->GetObserver() == observer)
+            {
+                return ConnectionToken{index, slot.generation};
+            }
+        }
+
+        for (size_t i = 0; i < this->deferred_->waiting.size(); ++i)
+        {
+            const auto &waiting = this->deferred_->waiting[i];
+
+            if (
+                !waiting.isRemoved
+                && waiting.connection.GetObserver() == observer)
+            {
+                return ConnectionToken{
+                    static_cast<uint32_t>(this->slots_.size() + i),
+                    1};
+            }
+        }
+
+        return {};
+    }
+
+    /** Returns false if the token is no longer valid. **/
+    bool Erase(ConnectionToken token)
+    {
+        if (!this->Contains(token))
+        {
+            return false;
+        }
+
+        if (token.index < this->slots_.size())
+        {
+            this->Remove_(token.index);
+        }
+        else
+        {
+            this->FindWaiting_(token)->isRemoved = true;
+            --this->count_;
+        }
+
+        return true;
+    }
+
+    /** Removes all connections made by observer, returning the count. **/
+    size_t Erase(const Observer *observer)
+    {
+        size_t erasedCount = 0;
+        auto index = this->first_;
+
+        while (index != npos)
+        {
+            auto &slot = this->slots_[index];
+            auto next = slot.next;
+
+            if (slot.IsLive() && slot.connection->GetObserver() == observer)
+            {
+                this->Remove_(index);
+                ++erasedCount;
+            }
+
+            index = next;
+        }
+
+        if (!this->deferred_)
+        {
+            return erasedCount;
+        }
+
+        for (auto deferredIndex: this->deferred_->links)
+        {
+            auto &slot = this->slots_[deferredIndex];
+
+            if (slot.IsLive() && slot.connection->GetObserver() == observer)
+            {
+                this->Remove_(deferredIndex);
+                ++erasedCount;
+            }
+        }
+
+        for (auto &waiting: this->deferred_->waiting)
+        {
+            if (
+                !waiting.isRemoved
+                && waiting.connection.GetObserver() == observer)
+            {
+                waiting.isRemoved = true;
+                --this->count_;
+                ++erasedCount;
+            }
+        }
+
+        return erasedCount;
+    }
+
+    /** The position of the observer's first connection in callback order.
+     **
+     ** Linear in the number of connections.
+     **/
+    std::optional<size_t> GetOrder(const Observer *observer) const
+    {
+        size_t order = 0;
+
+        for (auto &connection: *this)
+        {
+            if (connection.GetObserver() == observer)
+            {
+                return order;
+            }
+
+            ++order;
+        }
+
+        return {};
+    }
+
+    void clear()
+    {
+        if (this->IsDeferring())
+        {
+            auto index = this->first_;
+
+            while (index != npos)
+            {
+                auto next = this->slots_[index].next;
+
+                if (!this->slots_[index].isRemoved)
+                {
+                    this->Remove_(index);
+                }
+
+                index = next;
+            }
+
+            if (this->deferred_)
+            {
+                for (auto deferredIndex: this->deferred_->links)
+                {
+                    if (this->slots_[deferredIndex].IsLive())
+                    {
+                        this->Remove_(deferredIndex);
+                    }
+                }
+
+                for (auto &waiting: this->deferred_->waiting)
+                {
+                    if (!waiting.isRemoved)
+                    {
+                        waiting.isRemoved = true;
+                        --this->count_;
+                    }
+                }
+            }
+
+            assert(this->count_ == 0);
+
+            return;
+        }
+
+        // Vacate rather than discard the slots, so that the generations
+        // continue to count up and outstanding tokens remain invalid.
+        while (this->first_ != npos)
+        {
+            this->Vacate_(this->first_);
+        }
+    }
+
+    size_t size() const
+    {
+        return this->count_;
+    }
+
+    bool empty() const
+    {
+        return this->count_ == 0;
+    }
+
+    /** True while the slots fit in the inline storage. **/
+    bool IsInline() const
+    {
+        return this->slots_.IsInline();
+    }
+
+    iterator begin() { return iterator(this, this->first_); }
+    iterator end() { return iterator(this, npos); }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, this->first_);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, npos);
+    }
+
+private:
+    void Reset_()
+    {
+        this->slots_.clear();
+        this->first_ = npos;
+        this->last_ = npos;
+        this->vacant_ = npos;
+        this->count_ = 0;
+    }
+
+    void CopyFrom_(const ConnectionSlots &other)
+    {
+        assert(this->empty());
+
+        for (auto &connection: other)
+        {
+            this->Emplace(connection);
+        }
+
+        if (!other.deferred_)
+        {
+            return;
+        }
+
+        for (auto index: other.deferred_->links)
+        {
+            if (other.slots_[index].IsLive())
+            {
+                this->Emplace(*other.slots_[index].connection);
+            }
+        }
+
+        for (auto &waiting: other.deferred_->waiting)
+        {
+            if (!waiting.isRemoved)
+            {
+                this->Emplace(waiting.connection);
+            }
+        }
+    }
+
+    Deferred & GetDeferred_()
+    {
+        assert(this->IsDeferring());
+
+        if (!this->deferred_)
+        {
+            this->deferred_ = std::make_unique<Deferred>();
+        }
+
+        return *this->deferred_;
+    }
+
+    size_t GetWaitingCount_() const
+    {
+        if (!this->deferred_)
+        {
+            return 0;
+        }
+
+        return this->deferred_->waiting.size();
+    }
+
+    const Waiting * FindWaiting_(ConnectionToken token) const
+    {
+        if (token.index < this->slots_.size() || token.generation != 1)
+        {
+            return nullptr;
+        }
+
+        auto offset = token.index - this->slots_.size();
+
+        if (offset >= this->GetWaitingCount_())
+        {
+            return nullptr;
+        }
+
+        return &this->deferred_->waiting[offset];
+    }
+
+    Waiting * FindWaiting_(ConnectionToken token)
+    {
+        return const_cast<Waiting *>(
+            static_cast<const ConnectionSlots *>(this)->FindWaiting_(token));
+    }
+
+    // Removes the connection now, or marks it to be removed when the
+    // deferral ends.
+    void Remove_(uint32_t index)
+    {
+        auto &slot = this->slots_[index];
+        assert(slot.IsLive());
+
+        if (!this->IsDeferring())
+        {
+            this->Vacate_(index);
+
+            return;
+        }
+
+        slot.isRemoved = true;
+        --this->count_;
+
+        if (slot.isLinked)
+        {
+            this->GetDeferred_().removals.push_back(index);
+        }
+
+        // else
+        // The slot will be vacated instead of linked.
+    }
+
+    void ApplyDeferred_()
+    {
+        if (!this->deferred_)
+        {
+            return;
+        }
+
+        // Release the changes before applying them, so that a Deferral
+        // created from a nested call cannot add to them.
+        auto deferred = std::move(this->deferred_);
+
+        for (auto index: deferred->removals)
+        {
+            this->Release_(index);
+        }
+
+        for (auto index: deferred->links)
+        {
+            if (this->slots_[index].isRemoved)
+            {
+                this->Release_(index);
+            }
+            else
+            {
+                this->Link_(index);
+            }
+        }
+
+        // The waiting connections were promised the slots following the
+        // existing ones, in order.
+        for (auto &waiting: deferred->waiting)
+        {
+            auto index = static_cast<uint32_t>(this->slots_.size());
+            auto &slot = this->slots_.emplace_back();
+            slot.connection.emplace(std::move(waiting.connection));
+            ++slot.generation;
+            assert(slot.generation == 1);
+
+            if (waiting.isRemoved)
+            {
+                slot.isRemoved = true;
+                this->Release_(index);
+            }
+            else
+            {
+                this->Link_(index);
+            }
+        }
+    }
+
+    void Link_(uint32_t index)
+    {
+        auto &slot = this->slots_[index];
+        assert(!slot.isLinked);
+
+        slot.previous = this->last_;
+        slot.next = npos;
+        slot.isLinked = true;
+
+        if (this->last_ != npos)
+        {
+            this->slots_[this->last_].next = index;
+        }
+        else
+        {
+            this->first_ = index;
+        }
+
+        this->last_ = index;
+    }
+
+    void Unlink_(uint32_t index)
+    {
+        auto &slot = this->slots_[index];
+        assert(slot.isLinked);
+
+        if (slot.previous != npos)
+        {
+            this->slots_[slot.previous].next = slot.next;
+        }
+        else
+        {
+            this->first_ = slot.next;
+        }
+
+        if (slot.next != npos)
+        {
+            this->slots_[slot.next].previous = slot.previous;
+        }
+        else
+        {
+            this->last_ = slot.previous;
+        }
+
+        slot.isLinked = false;
+    }
+
+    // Returns a removed slot to the vacant list.
+    void Release_(uint32_t index)
+    {
+        auto &slot = this->slots_[index];
+        assert(slot.isRemoved);
+
+        if (slot.isLinked)
+        {
+            this->Unlink_(index);
+        }
+
+        slot.connection.reset();
+        slot.isRemoved = false;
+        ++slot.generation;
+        slot.previous = npos;
+        slot.next = this->vacant_;
+        this->vacant_ = index;
+    }
+
+    void Vacate_(uint32_t index)
+    {
+        assert(this->slots_[index].IsLive());
+        this->slots_[index].isRemoved = true;
+        this->Release_(index);
+        --this->count_;
+    }
+
+    Slots slots_;
+    uint32_t first_;
+    uint32_t last_;
+
+    // The head of a singly-linked list of vacant slots, threaded through
+    // Slot::next.
+    uint32_t vacant_;
+
+    size_t count_;
+
+    uint32_t deferralCount_;
+    std::unique_ptr<Deferred> deferred_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace pex
@@ -0,0 +1,182 @@
+/**
+  * @file element_changes.h
+  *
+  * @brief A second notification channel for containers, carrying only the
+  * elements that changed.
+  *
+  * Observers of the whole container receive a copy of every element, even
+  * when one was set. Observers of the elements receive the changed
+  * (index, value) or (key, value) pairs instead.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "pex/detail/log.h"
+#include "pex/detail/notify_many.h"
+#include "pex/detail/value_connection.h"
+#include "pex/detail/propagation.h"
+
+
+namespace pex
+{
+
+
+/**
+ ** The elements of a container that changed, in the order they were set.
+ **
+ ** When isReset is true, the whole container was replaced, and elements is
+ ** empty. Observers must read the container again.
+ **/
+template<typename Key, typename Value>
+struct ElementChanges
+{
+    bool isReset = false;
+    std::vector<std::pair<Key, Value>> elements;
+
+    static ElementChanges Reset()
+    {
+        return {true, {}};
+    }
+
+    bool empty() const
+    {
+        return !this->isReset && this->elements.empty();
+    }
+
+    void Add(const Key &key, const Value &value)
+    {
+        if (this->isReset)
+        {
+            return;
+        }
+
+        this->elements.emplace_back(key, value);
+    }
+
+    void MarkReset()
+    {
+        this->isReset = true;
+        this->elements.clear();
+    }
+
+    void clear()
+    {
+        this->isReset = false;
+        this->elements.clear();
+    }
+};
+
+
+namespace detail
+{
+
+
+template<typename Key, typename Value>
+class ElementNotifier
+{
+public:
+    using ElementChanges = ::pex::ElementChanges<Key, Value>;
+
+    using ElementConnection =
+        detail::ValueConnection<void, ElementChanges>;
+
+    using ElementCallable = typename ElementConnection::Callable;
+
+    template<typename Observer>
+    ConnectionToken ConnectElements(
+        Observer *observer,
+        ElementCallable callable)
+    {
+        return this->channel_.Connect(observer, callable);
+    }
+
+    void DisconnectElements(void *observer)
+    {
+        this->channel_.Disconnect(observer);
+    }
+
+    void DisconnectElements(ConnectionToken token)
+    {
+        this->channel_.Disconnect(token);
+    }
+
+    bool HasElementConnections() const
+    {
+        return this->channel_.HasConnections();
+    }
+
+protected:
+    void NotifyElement_(const Key &key, const Value &value)
+    {
+        // Skip building the change set when nobody is listening.
+        if (!this->channel_.HasConnections())
+        {
+            return;
+        }
+
+        ElementChanges changes;
+        changes.Add(key, value);
+        this->NotifyElements_(changes);
+    }
+
+    void NotifyReset_()
+    {
+        if (!this->channel_.HasConnections())
+        {
+            return;
+        }
+
+        this->NotifyElements_(ElementChanges::Reset());
+    }
+
+    void NotifyElements_(const ElementChanges &changes)
+    {
+        if (changes.empty() || !this->channel_.HasConnections())
+        {
+            return;
+        }
+
+        // A Propagation delivers only the last notification scheduled by a
+        // node, which would drop the earlier elements. A reset is still
+        // correct after any number of changes.
+        if (PropagationNode::IsScheduling() && !changes.isReset)
+        {
+            this->channel_.Notify(ElementChanges::Reset());
+            return;
+        }
+
+        this->channel_.Notify(changes);
+    }
+
+private:
+    class Channel_
+        :
+        public detail::NotifyMany<ElementConnection, GetAndSetTag>
+    {
+    public:
+        Channel_()
+        {
+            PEX_NAME_UNIQUE("pex::ElementChanges");
+        }
+
+        void Notify(const ElementChanges &changes)
+        {
+            this->Notify_(changes);
+        }
+    };
+
+    Channel_ channel_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace pex
@@ -0,0 +1,136 @@
+/**
+  * @file generation.h
+  *
+  * @brief A counter that is advanced each time a node's value changes.
+  *
+  * Polling consumers can keep the last generation they read, and skip any
+  * work while it is unchanged, without getting or comparing the value.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+/**
+ ** A Generation may have a parent, like the generation of the list that
+ ** holds an item. Each Bump also bumps the parent, so a container reads the
+ ** changes of all of its items from one counter.
+ **/
+class Generation
+{
+public:
+    Generation()
+        :
+        count_(0),
+        parent_(nullptr)
+    {
+
+    }
+
+    // A copy is a different node, with its own history and no parent.
+    Generation(const Generation &)
+        :
+        count_(0),
+        parent_(nullptr)
+    {
+
+    }
+
+    Generation & operator=(const Generation &)
+    {
+        return *this;
+    }
+
+    /** The parent must outlive this generation, or be replaced first. **/
+    void SetParent(Generation *parent)
+    {
+        this->parent_ = parent;
+    }
+
+    void Bump()
+    {
+        this->Bump(1);
+    }
+
+    void Bump(uint64_t count)
+    {
+        this->count_.fetch_add(count, std::memory_order_release);
+
+        if (this->parent_)
+        {
+            this->parent_->Bump(count);
+        }
+    }
+
+    uint64_t Get() const
+    {
+        return this->count_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<uint64_t> count_;
+    Generation *parent_;
+};
+
+
+template<typename T>
+concept HasGetGeneration = requires (const T &t)
+{
+    { t.GetGeneration() } -> std::convertible_to<uint64_t>;
+};
+
+
+// Nodes that can report their changes to the generation of a container.
+template<typename T>
+concept HasGenerationParent = requires (T &t, Generation *parent)
+{
+    { t.SetGenerationParent(parent) };
+};
+
+
+// Nodes that hold other nodes, like groups and lists, declare whether each
+// of them reports its changes with a static MembersReportChanges().
+template<typename T>
+constexpr bool MembersReportChanges()
+{
+    if constexpr (requires { T::MembersReportChanges(); })
+    {
+        return T::MembersReportChanges();
+    }
+    else
+    {
+        return true;
+    }
+}
+
+
+/**
+ ** Every change to a node that ReportsChanges advances its generation parent,
+ ** so a container can trust a cached value while its generation is
+ ** unchanged.
+ **/
+template<typename T>
+concept ReportsChanges =
+    HasGenerationParent<T> && MembersReportChanges<T>();
+
+
+} // end namespace detail
+
+
+} // end namespace pex
@@ -0,0 +1,691 @@
+/**
+  * @file history.h
+  *
+  * @brief Records the changes to a model node as a list of edits that can
+  * be undone and redone.
+  *
+  * The edits are recorded from notifications. Groups are recorded member by
+  * member, lists are recorded from their item, insert, and erase signals, and
+  * any other node is recorded as its whole value.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <jive/for_each.h>
+#include "pex/traits.h"
+#include "pex/signal.h"
+#include "pex/endpoint.h"
+#include "pex/promote_control.h"
+#include "pex/detail/value.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+template<typename T>
+concept IsHistorySequence = requires (const T &t)
+{
+    typename T::value_type;
+    t.size();
+    t.begin();
+    t.end();
+};
+
+
+template<typename T>
+concept HasHistoryFields = requires { T::fields; };
+
+
+/** An estimate of the memory held by a recorded value. **/
+template<typename T>
+size_t EstimateHistorySize(const T &value)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return sizeof(T) + value.size();
+    }
+    else if constexpr (IsHistorySequence<T>)
+    {
+        size_t result = sizeof(T);
+
+        for (auto &element: value)
+        {
+            result += EstimateHistorySize(element);
+        }
+
+        return result;
+    }
+    else if constexpr (HasHistoryFields<T>)
+    {
+        size_t result = 0;
+
+        jive::ForEach(
+            T::fields,
+            [&value, &result](auto field)
+            {
+                result += EstimateHistorySize(value.*(field.member));
+            });
+
+        return std::max(result, sizeof(T));
+    }
+    else
+    {
+        return sizeof(T);
+    }
+}
+
+
+class HistoryEdit
+{
+public:
+    virtual ~HistoryEdit() = default;
+    virtual void Undo() = 0;
+    virtual void Redo() = 0;
+    virtual size_t GetSize() const = 0;
+};
+
+
+using HistoryEdits = std::vector<std::unique_ptr<HistoryEdit>>;
+
+
+template<typename Node, typename Value>
+void SetHistoryValue(Node &node, const Value &value)
+{
+    if constexpr (IsSelectModel<Node>)
+    {
+        node.SetValue(value);
+    }
+    else
+    {
+        node.Set(value);
+    }
+}
+
+
+// Replaces the whole value of a node.
+template<typename Node, typename Value>
+class ValueEdit: public HistoryEdit
+{
+public:
+    ValueEdit(Node &node, const Value &before, const Value &after)
+        :
+        node_(&node),
+        before_(before),
+        after_(after)
+    {
+
+    }
+
+    void Undo() override
+    {
+        SetHistoryValue(*this->node_, this->before_);
+    }
+
+    void Redo() override
+    {
+        SetHistoryValue(*this->node_, this->after_);
+    }
+
+    size_t GetSize() const override
+    {
+        return sizeof(*this)
+            + EstimateHistorySize(this->before_)
+            + EstimateHistorySize(this->after_);
+    }
+
+private:
+    Node *node_;
+    Value before_;
+    Value after_;
+};
+
+
+// Inserts (or erases, when isInsert is false) one item of a list.
+template<typename ListModel, typename Item>
+class ListItemEdit: public HistoryEdit
+{
+public:
+    ListItemEdit(ListModel &list, size_t index, const Item &item, bool isInsert)
+        :
+        list_(&list),
+        index_(index),
+        item_(item),
+        isInsert_(isInsert)
+    {
+
+    }
+
+    void Undo() override
+    {
+        this->Apply_(!this->isInsert_);
+    }
+
+    void Redo() override
+    {
+        this->Apply_(this->isInsert_);
+    }
+
+    size_t GetSize() const override
+    {
+        return sizeof(*this) + EstimateHistorySize(this->item_);
+    }
+
+private:
+    void Apply_(bool insert)
+    {
+        if (insert)
+        {
+            this->list_->Insert(this->index_, this->item_);
+        }
+        else
+        {
+            this->list_->Erase(this->index_);
+        }
+    }
+
+    ListModel *list_;
+    size_t index_;
+    Item item_;
+    bool isInsert_;
+};
+
+
+// Replaces one item of a list.
+template<typename ListModel, typename Item>
+class ListReplaceEdit: public HistoryEdit
+{
+public:
+    ListReplaceEdit(
+        ListModel &list,
+        size_t index,
+        const Item &before,
+        const Item &after)
+        :
+        list_(&list),
+        index_(index),
+        before_(before),
+        after_(after)
+    {
+
+    }
+
+    void Undo() override
+    {
+        (*this->list_)[this->index_].Set(this->before_);
+    }
+
+    void Redo() override
+    {
+        (*this->list_)[this->index_].Set(this->after_);
+    }
+
+    size_t GetSize() const override
+    {
+        return sizeof(*this)
+            + EstimateHistorySize(this->before_)
+            + EstimateHistorySize(this->after_);
+    }
+
+private:
+    ListModel *list_;
+    size_t index_;
+    Item before_;
+    Item after_;
+};
+
+
+class HistoryRecorderBase
+{
+public:
+    virtual ~HistoryRecorderBase() = default;
+};
+
+
+template<typename Node>
+class ValueRecorder;
+
+template<typename Node>
+class GroupRecorder;
+
+template<typename Node>
+class ListRecorder;
+
+
+/** Selects the recorder for the kind of node. **/
+template<typename Node>
+using HistoryRecorder =
+    std::conditional_t
+    <
+        IsGroupModel<Node>,
+        GroupRecorder<Node>,
+        std::conditional_t
+        <
+            IsListModel<Node>,
+            ListRecorder<Node>,
+            ValueRecorder<Node>
+        >
+    >;
+
+
+// Records each new value of a node with the value it replaced.
+template<typename Node>
+class ValueRecorder: public HistoryRecorderBase
+{
+public:
+    using Control = typename PromoteControl<Node>::Type;
+    using Value = typename Control::Type;
+
+    ValueRecorder(Node &node, HistoryEdits &edits)
+        :
+        node_(&node),
+        edits_(&edits),
+        previous_(Control(node).Get()),
+        endpoint_(
+            PEX_THIS("pex::ValueRecorder"),
+            Control(node),
+            &ValueRecorder::OnValue_)
+    {
+        PEX_MEMBER(endpoint_);
+    }
+
+    ValueRecorder(const ValueRecorder &) = delete;
+    ValueRecorder & operator=(const ValueRecorder &) = delete;
+
+    ~ValueRecorder()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+private:
+    void OnValue_(Argument<Value> value)
+    {
+        if constexpr (HasEqualTo<Value>)
+        {
+            if (value == this->previous_)
+            {
+                return;
+            }
+        }
+
+        this->edits_->push_back(
+            std::make_unique<ValueEdit<Node, Value>>(
+                *this->node_,
+                this->previous_,
+                value));
+
+        this->previous_ = value;
+    }
+
+    Node *node_;
+    HistoryEdits *edits_;
+    Value previous_;
+    Endpoint<ValueRecorder, Control> endpoint_;
+};
+
+
+// Records each member of a group separately.
+template<typename Node>
+class GroupRecorder: public HistoryRecorderBase
+{
+public:
+    GroupRecorder(Node &node, HistoryEdits &edits)
+        :
+        members_()
+    {
+        auto addMember = [this, &node, &edits](auto nodeField)
+        {
+            using Member = std::remove_reference_t<
+                decltype(node.*(nodeField.member))>;
+
+            if constexpr (!IsSignal<Member>)
+            {
+                this->members_.push_back(
+                    std::make_unique<HistoryRecorder<Member>>(
+                        node.*(nodeField.member),
+                        edits));
+            }
+        };
+
+        jive::ForEach(Node::template Fields<Node>::fields, addMember);
+    }
+
+    GroupRecorder(const GroupRecorder &) = delete;
+    GroupRecorder & operator=(const GroupRecorder &) = delete;
+
+private:
+    std::vector<std::unique_ptr<HistoryRecorderBase>> members_;
+};
+
+
+/** Records the items of a list as they are inserted, erased, or changed.
+ **
+ ** A copy of each item is kept, so a changed item is recorded with the value
+ ** it replaced. Each item is observed by a recorder that holds its index.
+ ** Inserts and erases only mark the indices after them as stale, and they
+ ** are renumbered when an item next changes.
+ **/
+template<typename Node>
+class ListRecorder: public HistoryRecorderBase
+{
+public:
+    using Item = typename Node::Item;
+    using ItemControl = typename PromoteControl<typename Node::ListItem>::Type;
+    using OptionalIndex = typename Node::MemberAdded::Type;
+    using OptionalRange = typename Node::MembersAdded::Type;
+
+    ListRecorder(Node &node, HistoryEdits &edits)
+        :
+        list_(&node),
+        edits_(&edits),
+        items_(),
+        itemRecorders_(),
+        firstStale_(noStaleItems_),
+
+        memberAdded_(
+            PEX_THIS("pex::ListRecorder"),
+            node.memberAdded,
+            &ListRecorder::OnMemberAdded_),
+
+        memberWillRemove_(
+            this,
+            node.memberWillRemove,
+            &ListRecorder::OnMemberWillRemove_),
+
+        memberWillReplace_(
+            this,
+            node.memberWillReplace,
+            &ListRecorder::OnMemberWillReplace_),
+
+        memberReplaced_(
+            this,
+            node.memberReplaced,
+            &ListRecorder::OnMemberReplaced_),
+
+        membersAdded_(
+            this,
+            node.membersAdded,
+            &ListRecorder::OnMembersAdded_),
+
+        membersWillRemove_(
+            this,
+            node.membersWillRemove,
+            &ListRecorder::OnMembersWillRemove_)
+    {
+        size_t itemCount = node.size();
+        this->items_.reserve(itemCount);
+        this->itemRecorders_.reserve(itemCount);
+
+        for (size_t index = 0; index < itemCount; ++index)
+        {
+            this->items_.push_back(node[index].Get());
+
+            this->itemRecorders_.push_back(
+                std::make_unique<ItemRecorder_>(
+                    this,
+                    index,
+                    ItemControl(node[index])));
+        }
+    }
+
+    ListRecorder(const ListRecorder &) = delete;
+    ListRecorder & operator=(const ListRecorder &) = delete;
+
+    ~ListRecorder()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+private:
+    static constexpr size_t noStaleItems_ =
+        std::numeric_limits<size_t>::max();
+
+    class ItemRecorder_
+    {
+    public:
+        ItemRecorder_(ListRecorder *owner, size_t index_, ItemControl item)
+            :
+            index(index_),
+            owner_(owner),
+            endpoint_(
+                PEX_THIS("pex::ListRecorder item"),
+                item,
+                &ItemRecorder_::OnItem_)
+        {
+
+        }
+
+        ~ItemRecorder_()
+        {
+            PEX_CLEAR_NAME(this);
+        }
+
+        size_t index;
+
+    private:
+        void OnItem_(Argument<Item> item)
+        {
+            this->owner_->OnItem_(*this, item);
+        }
+
+        ListRecorder *owner_;
+        Endpoint<ItemRecorder_, ItemControl> endpoint_;
+    };
+
+    void OnItem_(ItemRecorder_ &itemRecorder, Argument<Item> item)
+    {
+        this->RenumberItems_();
+
+        size_t index = itemRecorder.index;
+        auto &previous = this->items_.at(index);
+
+        if constexpr (HasEqualTo<Item>)
+        {
+            if (item == previous)
+            {
+                return;
+            }
+        }
+
+        this->edits_->push_back(
+            std::make_unique<ListReplaceEdit<Node, Item>>(
+                *this->list_,
+                index,
+                previous,
+                item));
+
+        previous = item;
+    }
+
+    void Insert_(size_t first, size_t count)
+    {
+        std::vector<Item> items;
+        std::vector<std::unique_ptr<ItemRecorder_>> itemRecorders;
+        items.reserve(count);
+        itemRecorders.reserve(count);
+
+        for (size_t index = first; index < first + count; ++index)
+        {
+            auto &item = (*this->list_)[index];
+            items.push_back(item.Get());
+
+            itemRecorders.push_back(
+                std::make_unique<ItemRecorder_>(
+                    this,
+                    index,
+                    ItemControl(item)));
+
+            this->edits_->push_back(
+                std::make_unique<ListItemEdit<Node, Item>>(
+                    *this->list_,
+                    index,
+                    items.back(),
+                    true));
+        }
+
+        auto offset = static_cast<ptrdiff_t>(first);
+
+        this->items_.insert(
+            this->items_.begin() + offset,
+            std::make_move_iterator(items.begin()),
+            std::make_move_iterator(items.end()));
+
+        this->itemRecorders_.insert(
+            this->itemRecorders_.begin() + offset,
+            std::make_move_iterator(itemRecorders.begin()),
+            std::make_move_iterator(itemRecorders.end()));
+
+        this->MarkStale_(first + count);
+    }
+
+    void Erase_(size_t first, size_t count)
+    {
+        // Each erase at first removes the next of the erased items.
+        for (size_t index = first; index < first + count; ++index)
+        {
+            this->edits_->push_back(
+                std::make_unique<ListItemEdit<Node, Item>>(
+                    *this->list_,
+                    first,
+                    this->items_.at(index),
+                    false));
+        }
+
+        auto offset = static_cast<ptrdiff_t>(first);
+        auto length = static_cast<ptrdiff_t>(count);
+
+        this->items_.erase(
+            this->items_.begin() + offset,
+            this->items_.begin() + offset + length);
+
+        this->itemRecorders_.erase(
+            this->itemRecorders_.begin() + offset,
+            this->itemRecorders_.begin() + offset + length);
+
+        this->MarkStale_(first);
+    }
+
+    void MarkStale_(size_t firstStale)
+    {
+        this->firstStale_ = std::min(this->firstStale_, firstStale);
+    }
+
+    void RenumberItems_()
+    {
+        size_t itemCount = this->itemRecorders_.size();
+
+        for (size_t index = this->firstStale_; index < itemCount; ++index)
+        {
+            // An item is without a recorder while it is being replaced.
+            if (this->itemRecorders_[index])
+            {
+                this->itemRecorders_[index]->index = index;
+            }
+        }
+
+        this->firstStale_ = noStaleItems_;
+    }
+
+    void OnMemberAdded_(const OptionalIndex &index)
+    {
+        if (index)
+        {
+            this->Insert_(*index, 1);
+        }
+    }
+
+    void OnMemberWillRemove_(const OptionalIndex &index)
+    {
+        if (index)
+        {
+            this->Erase_(*index, 1);
+        }
+    }
+
+    void OnMembersAdded_(const OptionalRange &range)
+    {
+        if (range)
+        {
+            this->Insert_(range->first, range->count);
+        }
+    }
+
+    void OnMembersWillRemove_(const OptionalRange &range)
+    {
+        if (range)
+        {
+            this->Erase_(range->first, range->count);
+        }
+    }
+
+    void OnMemberWillReplace_(const OptionalIndex &index)
+    {
+        if (index)
+        {
+            this->itemRecorders_.at(*index).reset();
+        }
+    }
+
+    void OnMemberReplaced_(const OptionalIndex &index)
+    {
+        if (!index)
+        {
+            return;
+        }
+
+        auto &item = (*this->list_)[*index];
+
+        this->itemRecorders_.at(*index) =
+            std::make_unique<ItemRecorder_>(
+                this,
+                *index,
+                ItemControl(item));
+
+        // The replacement is recorded as a change to the item's value.
+        this->OnItem_(*this->itemRecorders_[*index], item.Get());
+    }
+
+    using IndexEndpoint =
+        Endpoint<ListRecorder, typename Node::MemberAdded>;
+
+    using RangeEndpoint =
+        Endpoint<ListRecorder, typename Node::MembersAdded>;
+
+    Node *list_;
+    HistoryEdits *edits_;
+    std::vector<Item> items_;
+    std::vector<std::unique_ptr<ItemRecorder_>> itemRecorders_;
+
+    // The item recorders from here to the end may hold an old index.
+    size_t firstStale_;
+
+    IndexEndpoint memberAdded_;
+    IndexEndpoint memberWillRemove_;
+    IndexEndpoint memberWillReplace_;
+    IndexEndpoint memberReplaced_;
+    RangeEndpoint membersAdded_;
+    RangeEndpoint membersWillRemove_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace pex
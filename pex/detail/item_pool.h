@@ -0,0 +1,302 @@
+/**
+  * @file item_pool.h
+  *
+  * @brief Allocates list items from chunks of adjacent slots, so each item
+  * keeps its address without a separate heap allocation.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+/**
+ ** Items are constructed in place in chunks that are never moved while an
+ ** item lives in them, so the address of an item is stable for as long as it
+ ** lives. Released slots are reused before new chunks are allocated.
+ **
+ ** A new chunk holds as many slots as there are live items, up to
+ ** maximumChunkSize, so appending to a list allocates rarely, items appended
+ ** together are adjacent in memory, and a small list allocates little.
+ **
+ ** Each chunk counts its live items, and is freed when the last of them is
+ ** released, so a list that shrinks returns the memory it no longer uses.
+ **
+ ** Make returns a Pointer that returns its slot to the pool when it is
+ ** destroyed. The pool must outlive every Pointer it has made.
+ **/
+template<typename T>
+class ItemPool
+{
+public:
+    static constexpr size_t maximumChunkSize = 1024;
+
+    class Deleter
+    {
+    public:
+        Deleter()
+            :
+            pool_(nullptr)
+        {
+
+        }
+
+        Deleter(ItemPool *pool)
+            :
+            pool_(pool)
+        {
+
+        }
+
+        void operator()(T *item) const
+        {
+            assert(this->pool_);
+            this->pool_->Release_(item);
+        }
+
+    private:
+        ItemPool *pool_;
+    };
+
+    using Pointer = std::unique_ptr<T, Deleter>;
+
+    ItemPool()
+        :
+        chunks_(),
+        current_(nullptr),
+        capacity_(0),
+        liveCount_(0)
+    {
+
+    }
+
+    ItemPool(const ItemPool &) = delete;
+    ItemPool & operator=(const ItemPool &) = delete;
+
+    ~ItemPool()
+    {
+        // Every item must be destroyed before its storage.
+        assert(this->liveCount_ == 0);
+    }
+
+    template<typename ...Args>
+    Pointer Make(Args &&...args)
+    {
+        Slot *slot = this->Acquire_();
+
+        T *item;
+
+        try
+        {
+            item = ::new (static_cast<void *>(slot->storage))
+                T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            this->Return_(slot);
+            throw;
+        }
+
+        ++this->liveCount_;
+
+        return Pointer(item, Deleter(this));
+    }
+
+    /** Make room for count more items without another allocation. **/
+    void Reserve(size_t count)
+    {
+        size_t available = this->capacity_ - this->liveCount_;
+
+        while (available < count)
+        {
+            size_t slotCount =
+                std::min(count - available, maximumChunkSize);
+
+            this->current_ = this->AddChunk_(slotCount);
+            available += slotCount;
+        }
+    }
+
+    size_t GetCapacity() const
+    {
+        return this->capacity_;
+    }
+
+    size_t GetLiveCount() const
+    {
+        return this->liveCount_;
+    }
+
+    size_t GetChunkCount() const
+    {
+        return this->chunks_.size();
+    }
+
+private:
+    union Slot
+    {
+        Slot *next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct Chunk
+    {
+        std::unique_ptr<Slot[]> slots;
+        size_t size;
+
+        // Slots from here to the end have never been used.
+        size_t unusedIndex;
+
+        // The slots in use, whether or not their items were constructed.
+        size_t usedCount;
+
+        // Released slots, which are reused first.
+        Slot *free;
+
+        bool HasSpace() const
+        {
+            return this->free || this->unusedIndex < this->size;
+        }
+    };
+
+    // Chunks are ordered by address, so the chunk of a slot is found from
+    // the slot's address.
+    using Chunks = std::map<const Slot *, Chunk, std::less<>>;
+
+    Slot * Acquire_()
+    {
+        if (!this->current_ || !this->current_->HasSpace())
+        {
+            this->current_ = this->FindSpace_();
+        }
+
+        if (!this->current_)
+        {
+            this->current_ = this->AddChunk_(
+                std::clamp(this->liveCount_, size_t{1}, maximumChunkSize));
+        }
+
+        Chunk &chunk = *this->current_;
+        Slot *slot;
+
+        if (chunk.free)
+        {
+            slot = chunk.free;
+            chunk.free = slot->next;
+        }
+        else
+        {
+            slot = &chunk.slots[chunk.unusedIndex++];
+        }
+
+        ++chunk.usedCount;
+
+        return slot;
+    }
+
+    Chunk * FindSpace_()
+    {
+        for (auto &entry: this->chunks_)
+        {
+            if (entry.second.HasSpace())
+            {
+                return &entry.second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void Return_(Slot *slot)
+    {
+        // The last chunk that starts at or before the slot holds it.
+        auto found = this->chunks_.upper_bound(slot);
+        assert(found != this->chunks_.begin());
+        --found;
+
+        Chunk &chunk = found->second;
+        assert(slot < found->first + chunk.size);
+        assert(chunk.usedCount > 0);
+
+        if (--chunk.usedCount == 0)
+        {
+            if (this->current_ == &chunk)
+            {
+                this->current_ = nullptr;
+            }
+
+            this->capacity_ -= chunk.size;
+            this->chunks_.erase(found);
+
+            return;
+        }
+
+        slot->next = chunk.free;
+        chunk.free = slot;
+
+        if (!this->current_)
+        {
+            this->current_ = &chunk;
+        }
+    }
+
+    void Release_(T *item)
+    {
+        assert(this->liveCount_ > 0);
+
+        item->~T();
+        --this->liveCount_;
+
+        // The item was constructed at the start of its slot.
+        this->Return_(reinterpret_cast<Slot *>(item));
+    }
+
+    Chunk * AddChunk_(size_t slotCount)
+    {
+        auto slots = std::make_unique<Slot[]>(slotCount);
+        const Slot *first = slots.get();
+
+        auto [entry, inserted] = this->chunks_.emplace(
+            first,
+            Chunk{std::move(slots), slotCount, 0, 0, nullptr});
+
+        assert(inserted);
+        this->capacity_ += slotCount;
+
+        return &entry->second;
+    }
+
+    Chunks chunks_;
+
+    // The chunk that new items are taken from, while it has space.
+    Chunk *current_;
+
+    size_t capacity_;
+    size_t liveCount_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace pex
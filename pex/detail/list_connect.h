@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <memory>
 #include "pex/list.h"
 #include "pex/selectors.h"
 #include "pex/promote_control.h"
@@ -103,7 +106,9 @@ public:
     using Connectable =
         ConnectableSelector<typename ListControl::ListItem>;
 
-    using Connectables = std::vector<Connectable>;
+    // Each connection is held by pointer, so inserting or erasing before it
+    // moves the pointer, and the connection itself is never rebuilt.
+    using Connectables = std::vector<std::unique_ptr<Connectable>>;
 
     using UpstreamControl = ListControl;
     using Upstream = typename PromoteControl<Upstream_>::Upstream;
@@ -117,9 +122,6 @@ public:
     using MemberWillRemoveTerminus =
         Terminus<ListConnect, typename ListControl::MemberWillRemove>;
 
-    using MemberRemovedTerminus =
-        Terminus<ListConnect, typename ListControl::MemberRemoved>;
-
     using MemberAddedTerminus =
         ::pex::Terminus<ListConnect, typename ListControl::MemberAdded>;
 
@@ -129,6 +131,12 @@ public:
     using MemberReplacedTerminus =
         Terminus<ListConnect, typename ListControl::MemberReplaced>;
 
+    using MembersAddedTerminus =
+        Terminus<ListConnect, typename ListControl::MembersAdded>;
+
+    using MembersWillRemoveTerminus =
+        Terminus<ListConnect, typename ListControl::MembersWillRemove>;
+
     using ListFlagTerminus =
         ::pex::Terminus<ListConnect, typename ListControl::ListFlag>;
 
@@ -148,15 +156,18 @@ public:
         muteState_(),
         listControl_(),
         connectables_(),
+        keys_(),
+        firstStaleKey_(noStaleKeys_),
         observer_(nullptr),
         valueConnection_(),
         signalConnection_(),
         indexedCallable_(),
         memberWillRemoveTerminus_(),
-        memberRemovedTerminus_(),
         memberAddedTerminus_(),
         memberWillReplaceTerminus_(),
         memberReplacedTerminus_(),
+        membersAddedTerminus_(),
+        membersWillRemoveTerminus_(),
         isNotifying_(false),
         isNotifyingTerminus_(),
         cached_()
@@ -173,6 +184,8 @@ public:
         muteState_(listControl.CloneMuteNode().Get()),
         listControl_(listControl),
         connectables_(),
+        keys_(),
+        firstStaleKey_(noStaleKeys_),
         observer_(nullptr),
         valueConnection_(),
         signalConnection_(),
@@ -183,11 +196,6 @@ public:
             this->listControl_.memberWillRemove,
             &ListConnect::OnMemberWillRemove_),
 
-        memberRemovedTerminus_(
-            this,
-            this->listControl_.memberRemoved,
-            &ListConnect::OnMemberRemoved_),
-
         memberAddedTerminus_(
             this,
             this->listControl_.memberAdded,
@@ -203,6 +211,16 @@ public:
             this->listControl_.memberReplaced,
             &ListConnect::OnMemberReplaced_),
 
+        membersAddedTerminus_(
+            this,
+            this->listControl_.membersAdded,
+            &ListConnect::OnMembersAdded_),
+
+        membersWillRemoveTerminus_(
+            this,
+            this->listControl_.membersWillRemove,
+            &ListConnect::OnMembersWillRemove_),
+
         isNotifying_(false),
 
         isNotifyingTerminus_(
@@ -227,6 +245,8 @@ public:
         muteState_(listControl.CloneMuteNode().Get()),
         listControl_(listControl),
         connectables_(),
+        keys_(),
+        firstStaleKey_(noStaleKeys_),
         observer_(observer),
         valueConnection_(std::in_place_t{}, observer, callable),
         signalConnection_(),
@@ -237,11 +257,6 @@ public:
             this->listControl_.memberWillRemove,
             &ListConnect::OnMemberWillRemove_),
 
-        memberRemovedTerminus_(
-            this,
-            this->listControl_.memberRemoved,
-            &ListConnect::OnMemberRemoved_),
-
         memberAddedTerminus_(
             this,
             this->listControl_.memberAdded,
@@ -257,6 +272,16 @@ public:
             this->listControl_.memberReplaced,
             &ListConnect::OnMemberReplaced_),
 
+        membersAddedTerminus_(
+            this,
+            this->listControl_.membersAdded,
+            &ListConnect::OnMembersAdded_),
+
+        membersWillRemoveTerminus_(
+            this,
+            this->listControl_.membersWillRemove,
+            &ListConnect::OnMembersWillRemove_),
+
         isNotifying_(false),
 
         isNotifyingTerminus_(
@@ -264,7 +289,7 @@ public:
             this->listControl_.isNotifying,
             &ListConnect::OnIsNotifying_),
 
-        cached_(this->listControl_.Get())
+        cached_()
     {
         assert(this->observer_ != nullptr);
         PEX_LINK_OBSERVER(this, this->observer_);
@@ -283,6 +308,8 @@ public:
         muteState_(listControl.CloneMuteNode().Get()),
         listControl_(listControl),
         connectables_(),
+        keys_(),
+        firstStaleKey_(noStaleKeys_),
         observer_(observer),
         valueConnection_(),
         signalConnection_(std::in_place_t{}, observer, callable),
@@ -293,11 +320,6 @@ public:
             this->listControl_.memberWillRemove,
             &ListConnect::OnMemberWillRemove_),
 
-        memberRemovedTerminus_(
-            this,
-            this->listControl_.memberRemoved,
-            &ListConnect::OnMemberRemoved_),
-
         memberAddedTerminus_(
             this,
             this->listControl_.memberAdded,
@@ -313,6 +335,16 @@ public:
             this->listControl_.memberReplaced,
             &ListConnect::OnMemberReplaced_),
 
+        membersAddedTerminus_(
+            this,
+            this->listControl_.membersAdded,
+            &ListConnect::OnMembersAdded_),
+
+        membersWillRemoveTerminus_(
+            this,
+            this->listControl_.membersWillRemove,
+            &ListConnect::OnMembersWillRemove_),
+
         isNotifying_(false),
 
         isNotifyingTerminus_(
@@ -363,6 +395,8 @@ public:
         muteState_(other.muteState_),
         listControl_(other.listControl_),
         connectables_(),
+        keys_(),
+        firstStaleKey_(noStaleKeys_),
         observer_(nullptr),
         valueConnection_(),
         signalConnection_(),
@@ -373,11 +407,6 @@ public:
             this->listControl_.memberWillRemove,
             &ListConnect::OnMemberWillRemove_),
 
-        memberRemovedTerminus_(
-            this,
-            this->listControl_.memberRemoved,
-            &ListConnect::OnMemberRemoved_),
-
         memberAddedTerminus_(
             this,
             this->listControl_.memberAdded,
@@ -393,6 +422,16 @@ public:
             this->listControl_.memberReplaced,
             &ListConnect::OnMemberReplaced_),
 
+        membersAddedTerminus_(
+            this,
+            this->listControl_.membersAdded,
+            &ListConnect::OnMembersAdded_),
+
+        membersWillRemoveTerminus_(
+            this,
+            this->listControl_.membersWillRemove,
+            &ListConnect::OnMembersWillRemove_),
+
         isNotifying_(false),
 
         isNotifyingTerminus_(
@@ -400,7 +439,7 @@ public:
             this->listControl_.isNotifying,
             &ListConnect::OnIsNotifying_),
 
-        cached_(other.cached_)
+        cached_()
     {
         if (other.valueConnection_)
         {
@@ -487,10 +526,6 @@ public:
             this,
             other.memberWillRemoveTerminus_);
 
-        this->memberRemovedTerminus_.RequireAssign(
-            this,
-            other.memberRemovedTerminus_);
-
         this->memberAddedTerminus_.RequireAssign(
             this,
             other.memberAddedTerminus_);
@@ -503,23 +538,29 @@ public:
             this,
             other.memberReplacedTerminus_);
 
+        this->membersAddedTerminus_.RequireAssign(
+            this,
+            other.membersAddedTerminus_);
+
+        this->membersWillRemoveTerminus_.RequireAssign(
+            this,
+            other.membersWillRemoveTerminus_);
+
         this->isNotifying_ = other.isNotifying_;
 
         this->isNotifyingTerminus_.RequireAssign(
             this,
             other.isNotifyingTerminus_);
 
-        this->cached_ = other.cached_;
-
         return *this;
     }
 
     void Connect(Observer *observer, ValueCallable callable)
     {
         PEX_LINK_OBSERVER(this, observer);
-        this->cached_ = this->listControl_.Get();
         this->observer_ = observer;
         this->valueConnection_.emplace(observer, callable);
+        this->cached_.reset();
 
         if (this->connectables_.empty())
         {
@@ -568,11 +609,6 @@ public:
         return result;
     }
 
-    bool NeedsCache_() const
-    {
-        return this->valueConnection_.has_value();
-    }
-
     ~ListConnect()
     {
         this->Disconnect();
@@ -614,6 +650,7 @@ public:
         this->valueConnection_.reset();
         this->signalConnection_.reset();
         this->indexedCallable_.reset();
+        this->cached_.reset();
         this->ClearListConnections_();
         this->observer_ = nullptr;
     }
@@ -624,6 +661,40 @@ public:
     }
 
 private:
+    struct ItemKey_
+    {
+        ItemKey_(size_t index_)
+            :
+            index(index_)
+        {
+
+        }
+
+        size_t index;
+    };
+
+    void NotifyValue_()
+    {
+        // The list returns its snapshot while it is unchanged, so reading
+        // the whole list is only costly after items were added or removed.
+        this->cached_ = this->listControl_.Get();
+        (*this->valueConnection_)(*this->cached_);
+    }
+
+    void NotifyItemValue_(size_t index, ::pex::Argument<Item> item)
+    {
+        if (!this->cached_ || index >= this->cached_->size())
+        {
+            this->NotifyValue_();
+
+            return;
+        }
+
+        // Only the changed item is copied.
+        (*this->cached_)[index] = item;
+        (*this->valueConnection_)(*this->cached_);
+    }
+
     void OnMute_(const Mute_ &muteState)
     {
         if (!muteState.isMuted && !muteState.isSilenced)
@@ -631,7 +702,7 @@ private:
             if (this->valueConnection_.has_value())
             {
                 // Notify list observers when unmuted.
-                (*this->valueConnection_)(this->cached_);
+                this->NotifyValue_();
             }
 
             if (this->signalConnection_.has_value())
@@ -644,15 +715,19 @@ private:
     }
 
     static void OnItemChanged_(
-        size_t index,
+        ItemKey_ *key,
         void * context,
         ::pex::Argument<Item> item)
     {
         auto self = static_cast<ListConnect *>(context);
+        self->RenumberKeys_();
+        size_t index = key->index;
 
-        if (self->NeedsCache_())
+        if (self->muteState_ || self->isNotifying_)
         {
-            self->cached_.at(index) = item;
+            // This change is not copied, so the cache is read again with
+            // the next notification.
+            self->cached_.reset();
         }
 
         if (self->muteState_)
@@ -669,7 +744,7 @@ private:
 
         if (self->valueConnection_.has_value())
         {
-            (*self->valueConnection_)(self->cached_);
+            self->NotifyItemValue_(index, item);
         }
 
         if (self->signalConnection_.has_value())
@@ -701,10 +776,12 @@ private:
 
         for (auto &connectable: this->connectables_)
         {
-            connectable.Disconnect(this);
+            connectable->Disconnect(this);
         }
 
         this->connectables_.clear();
+        this->keys_.clear();
+        this->firstStaleKey_ = noStaleKeys_;
     }
 
     void OnMemberWillRemove_(const std::optional<size_t> &index)
@@ -714,97 +791,148 @@ private:
             return;
         }
 
+        this->cached_.reset();
+
         if (!this->HasObservers())
         {
             return;
         }
 
-        this->ClearInvalidatedConnections_(*index);
+        this->EraseConnections_(*index, 1);
     }
 
-    void OnMemberRemoved_(const std::optional<size_t> &index)
+    void ClearConnection_(size_t index)
     {
-        if (!index)
+        this->connectables_.at(index)->Disconnect(this);
+    }
+
+    std::unique_ptr<Connectable> MakeConnection_(ItemKey_ *key)
+    {
+        return std::make_unique<Connectable>(
+            this,
+            this->listControl_.at(key->index),
+            std::bind(
+                ListConnect::OnItemChanged_,
+                key,
+                std::placeholders::_1,
+                std::placeholders::_2));
+    }
+
+    void RestoreConnection_(size_t index)
+    {
+        this->RenumberKeys_();
+
+        this->connectables_.at(index) =
+            this->MakeConnection_(this->keys_.at(index).get());
+    }
+
+    void RestoreConnections_(size_t firstIndex)
+    {
+        size_t listCount = this->listControl_.size();
+        assert(this->connectables_.size() == firstIndex);
+        assert(this->keys_.size() == firstIndex);
+
+        this->connectables_.reserve(listCount);
+        this->keys_.reserve(listCount);
+
+        for (size_t i = firstIndex; i < listCount; ++i)
         {
-            return;
+            this->keys_.push_back(std::make_unique<ItemKey_>(i));
+
+            this->connectables_.push_back(
+                this->MakeConnection_(this->keys_.back().get()));
         }
+    }
 
-        if (this->NeedsCache_())
+    /**
+     ** Connects only the inserted items. The connections after them stay
+     ** where they are, and their keys are renumbered when an item next
+     ** notifies.
+     **/
+    void InsertConnections_(size_t first, size_t count)
+    {
+        if (this->connectables_.size() >= this->listControl_.size())
         {
-            // Update the cache.
-            jive::SafeErase(this->cached_, *index);
+            // The new items were connected when the observer connected.
+            return;
         }
 
-        if (!this->HasObservers())
+        assert(this->connectables_.size() + count == this->listControl_.size());
+        assert(first <= this->connectables_.size());
+
+        std::vector<std::unique_ptr<ItemKey_>> keys;
+        Connectables connectables;
+        keys.reserve(count);
+        connectables.reserve(count);
+
+        for (size_t index = first; index < first + count; ++index)
         {
-            return;
+            keys.push_back(std::make_unique<ItemKey_>(index));
+            connectables.push_back(this->MakeConnection_(keys.back().get()));
         }
 
-        this->RestoreConnections_(*index);
-    }
+        auto offset = static_cast<ptrdiff_t>(first);
 
-    void ClearConnection_(size_t index)
-    {
-        this->connectables_.at(index).Disconnect(this);
+        this->keys_.insert(
+            this->keys_.begin() + offset,
+            std::make_move_iterator(keys.begin()),
+            std::make_move_iterator(keys.end()));
+
+        this->connectables_.insert(
+            this->connectables_.begin() + offset,
+            std::make_move_iterator(connectables.begin()),
+            std::make_move_iterator(connectables.end()));
+
+        this->MarkStale_(first + count);
     }
 
-    void ClearInvalidatedConnections_(size_t firstToClear)
+    /** Disconnects only the removed items. **/
+    void EraseConnections_(size_t first, size_t count)
     {
         size_t connectionCount = this->connectables_.size();
 
-        if (firstToClear >= connectionCount)
+        if (first >= connectionCount)
         {
-            // Nothing to do.
-            // An item was added at the end of the list.
-
+            // These items were never connected.
             return;
         }
 
-        for (size_t index = firstToClear; index < connectionCount; ++index)
+        size_t last = std::min(first + count, connectionCount);
+
+        for (size_t index = first; index < last; ++index)
         {
-            this->connectables_.at(index).Disconnect(this);
+            this->connectables_[index]->Disconnect(this);
         }
 
+        auto offset = static_cast<ptrdiff_t>(first);
+        auto length = static_cast<ptrdiff_t>(last - first);
+
         this->connectables_.erase(
-            jive::SafeEraseIterator(this->connectables_, firstToClear),
-            std::end(this->connectables_));
-    }
+            this->connectables_.begin() + offset,
+            this->connectables_.begin() + offset + length);
 
-    void RestoreConnection_(size_t index)
-    {
-        this->connectables_.at(index) =
-            Connectable(
-                this,
-                this->listControl_.at(index),
-                std::bind(
-                    ListConnect::OnItemChanged_,
-                    index,
-                    std::placeholders::_1,
-                    std::placeholders::_2));
+        this->keys_.erase(
+            this->keys_.begin() + offset,
+            this->keys_.begin() + offset + length);
+
+        this->MarkStale_(first);
     }
 
-    void RestoreConnectionAtEnd_(size_t index)
+    void MarkStale_(size_t firstStaleKey)
     {
-        this->connectables_.emplace_back(
-            this,
-            this->listControl_[index],
-            std::bind(
-                ListConnect::OnItemChanged_,
-                index,
-                std::placeholders::_1,
-                std::placeholders::_2));
+        this->firstStaleKey_ = std::min(this->firstStaleKey_, firstStaleKey);
     }
 
-    void RestoreConnections_(size_t firstIndex)
+    void RenumberKeys_()
     {
-        size_t listCount = this->listControl_.size();
-        assert(this->connectables_.size() == firstIndex);
-        static_assert(std::is_nothrow_move_constructible_v<Connectable>);
+        size_t keyCount = this->keys_.size();
 
-        for (size_t i = firstIndex; i < listCount; ++i)
+        for (size_t index = this->firstStaleKey_; index < keyCount; ++index)
         {
-            this->RestoreConnectionAtEnd_(i);
+            this->keys_[index]->index = index;
         }
+
+        this->firstStaleKey_ = noStaleKeys_;
     }
 
     void OnMemberAdded_(const std::optional<size_t> &index)
@@ -814,18 +942,11 @@ private:
             return;
         }
 
-        if (this->NeedsCache_())
-        {
-            // Maintain the cache.
-            this->cached_.insert(
-                jive::SafeInsertIterator(this->cached_, *index),
-                this->listControl_.at(*index).Get());
-        }
+        this->cached_.reset();
 
         if (this->HasObservers())
         {
-            this->ClearInvalidatedConnections_(*index);
-            this->RestoreConnections_(*index);
+            this->InsertConnections_(*index, 1);
         }
     }
 
@@ -836,6 +957,8 @@ private:
             return;
         }
 
+        this->cached_.reset();
+
         if (this->HasObservers())
         {
             this->ClearConnection_(*index);
@@ -853,12 +976,46 @@ private:
             return;
         }
 
+        this->cached_.reset();
+
         if (this->HasObservers())
         {
             this->RestoreConnection_(*index);
         }
     }
 
+    void OnMembersAdded_(const std::optional<ListRange> &range)
+    {
+        if (!range)
+        {
+            return;
+        }
+
+        this->cached_.reset();
+
+        if (this->HasObservers())
+        {
+            this->InsertConnections_(range->first, range->count);
+        }
+    }
+
+    void OnMembersWillRemove_(const std::optional<ListRange> &range)
+    {
+        if (!range)
+        {
+            return;
+        }
+
+        this->cached_.reset();
+
+        if (!this->HasObservers())
+        {
+            return;
+        }
+
+        this->EraseConnections_(range->first, range->count);
+    }
+
     void OnIsNotifying_(bool isNotifying)
     {
         this->isNotifying_ = isNotifying;
@@ -874,7 +1031,7 @@ private:
             // notification.
             if (this->valueConnection_.has_value())
             {
-                (*this->valueConnection_)(this->cached_);
+                this->NotifyValue_();
             }
 
             if (this->signalConnection_.has_value())
@@ -885,6 +1042,8 @@ private:
     }
 
 private:
+    static constexpr size_t noStaleKeys_ = std::numeric_limits<size_t>::max();
+
     using MuteNode = decltype(std::declval<ListControl>().CloneMuteNode());
     using MuteTerminus = pex::Terminus<ListConnect, MuteNode>;
 
@@ -892,18 +1051,31 @@ private:
     Mute_ muteState_;
     ListControl listControl_;
     Connectables connectables_;
+
+    // Each connection is bound to the key of its item, which moves with the
+    // item when others are inserted or erased before it.
+    std::vector<std::unique_ptr<ItemKey_>> keys_;
+
+    // The keys from here to the end may hold an old index.
+    size_t firstStaleKey_;
+
     Observer *observer_;
     std::optional<ValueConnection_> valueConnection_;
     std::optional<SignalConnection_> signalConnection_;
     std::optional<IndexedCallable> indexedCallable_;
     MemberWillRemoveTerminus memberWillRemoveTerminus_;
-    MemberRemovedTerminus memberRemovedTerminus_;
     MemberAddedTerminus memberAddedTerminus_;
     MemberWillReplaceTerminus memberWillReplaceTerminus_;
     MemberReplacedTerminus memberReplacedTerminus_;
+    MembersAddedTerminus membersAddedTerminus_;
+    MembersWillRemoveTerminus membersWillRemoveTerminus_;
     bool isNotifying_;
     ListFlagTerminus isNotifyingTerminus_;
-    ListType cached_;
+
+    // The last value sent to the value observer. A changed item is copied
+    // into it by index, and it is read again from the list after items are
+    // added or removed.
+    std::optional<Plain> cached_;
 };
 
 
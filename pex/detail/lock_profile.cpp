@@ -0,0 +1,200 @@
+#include "pex/detail/lock_profile.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <fmt/core.h>
+#include <jive/path.h>
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+// The mutex is only taken when a site is first reached, and when the sites
+// are reported or reset.
+struct LockSites
+{
+    std::mutex mutex;
+    std::vector<LockSite *> sites;
+};
+
+
+void ReportLockProfileAtExit()
+{
+    ReportLockProfile(std::cout);
+}
+
+
+LockSites & GetLockSites()
+{
+    // The sites are reported at exit, so they are never destroyed.
+    static auto lockSites = []()
+    {
+        auto result = new LockSites();
+        std::atexit(ReportLockProfileAtExit);
+
+        return result;
+    }();
+
+    return *lockSites;
+}
+
+
+LockSite::LockSite(const char *fileName, int line, const char *lockName)
+    :
+    fileName_(fileName),
+    line_(line),
+    lockName_(lockName),
+    acquireCount_(0),
+    contendedCount_(0),
+    totalWait_(0),
+    maxWait_(0),
+    totalHold_(0),
+    maxHold_(0),
+    waitHistogram_{},
+    holdHistogram_{}
+{
+    auto &lockSites = GetLockSites();
+    std::lock_guard lock(lockSites.mutex);
+    lockSites.sites.push_back(this);
+}
+
+
+LockProfile LockSite::GetProfile() const
+{
+    LockProfile result{
+        jive::path::Base(this->fileName_),
+        this->line_,
+        this->lockName_,
+        this->acquireCount_.load(std::memory_order_relaxed),
+        this->contendedCount_.load(std::memory_order_relaxed),
+        std::chrono::nanoseconds(
+            this->totalWait_.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(
+            this->maxWait_.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(
+            this->totalHold_.load(std::memory_order_relaxed)),
+        std::chrono::nanoseconds(
+            this->maxHold_.load(std::memory_order_relaxed)),
+        {},
+        {}};
+
+    for (size_t i = 0; i < profileBucketCount; ++i)
+    {
+        result.waitHistogram[i] =
+            this->waitHistogram_[i].load(std::memory_order_relaxed);
+
+        result.holdHistogram[i] =
+            this->holdHistogram_[i].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+
+void LockSite::Reset()
+{
+    this->acquireCount_.store(0, std::memory_order_relaxed);
+    this->contendedCount_.store(0, std::memory_order_relaxed);
+    this->totalWait_.store(0, std::memory_order_relaxed);
+    this->maxWait_.store(0, std::memory_order_relaxed);
+    this->totalHold_.store(0, std::memory_order_relaxed);
+    this->maxHold_.store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < profileBucketCount; ++i)
+    {
+        this->waitHistogram_[i].store(0, std::memory_order_relaxed);
+        this->holdHistogram_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+
+} // end namespace detail
+
+
+std::vector<LockProfile> GetLockProfiles(size_t count)
+{
+    std::vector<LockProfile> result;
+
+    {
+        auto &lockSites = detail::GetLockSites();
+        std::lock_guard lock(lockSites.mutex);
+
+        for (auto site: lockSites.sites)
+        {
+            auto profile = site->GetProfile();
+
+            if (profile.acquireCount > 0)
+            {
+                result.push_back(std::move(profile));
+            }
+        }
+    }
+
+    auto resultCount = std::min(count, result.size());
+
+    std::partial_sort(
+        std::begin(result),
+        std::next(std::begin(result), static_cast<ptrdiff_t>(resultCount)),
+        std::end(result),
+        [](const LockProfile &left, const LockProfile &right)
+        {
+            return left.totalWait > right.totalWait;
+        });
+
+    result.resize(resultCount);
+
+    return result;
+}
+
+
+void ReportLockProfile(std::ostream &output, size_t count)
+{
+    auto profiles = GetLockProfiles(count);
+
+    if (profiles.empty())
+    {
+        return;
+    }
+
+    output << "Most contended locks:\n";
+
+    for (auto &profile: profiles)
+    {
+        output << fmt::format(
+            "  {:>12} ns waited, {:>10} ns max wait, {:>10}/{:<10} contended, "
+            "{:>12} ns held, {:>10} ns max hold: {} {}:{}\n",
+            profile.totalWait.count(),
+            profile.maxWait.count(),
+            profile.contendedCount,
+            profile.acquireCount,
+            profile.totalHold.count(),
+            profile.maxHold.count(),
+            profile.lockName,
+            profile.fileName,
+            profile.line);
+    }
+
+    output.flush();
+}
+
+
+void ResetLockProfile()
+{
+    auto &lockSites = detail::GetLockSites();
+    std::lock_guard lock(lockSites.mutex);
+
+    for (auto site: lockSites.sites)
+    {
+        site->Reset();
+    }
+}
+
+
+} // end namespace pex
@@ -0,0 +1,118 @@
+/**
+  * @file lock_profile.h
+  *
+  * @brief Records lock wait and hold times for pex/lock_profile.h.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include "pex/lock_profile.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+size_t GetBucket(std::chrono::nanoseconds elapsed);
+
+
+using LockClock = std::chrono::steady_clock;
+
+
+/** The measurements of one lock call site.
+ **
+ ** Sites are static, and record with relaxed atomics, so measuring a lock
+ ** does not take another lock.
+ **/
+class LockSite
+{
+public:
+    LockSite(const char *fileName, int line, const char *lockName);
+
+    void RecordAcquire(std::chrono::nanoseconds wait, bool isContended)
+    {
+        this->acquireCount_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!isContended)
+        {
+            return;
+        }
+
+        this->contendedCount_.fetch_add(1, std::memory_order_relaxed);
+        this->totalWait_.fetch_add(wait.count(), std::memory_order_relaxed);
+        UpdateMaximum(this->maxWait_, wait.count());
+
+        this->waitHistogram_[GetBucket(wait)].fetch_add(
+            1,
+            std::memory_order_relaxed);
+    }
+
+    void RecordHold(std::chrono::nanoseconds hold)
+    {
+        this->totalHold_.fetch_add(hold.count(), std::memory_order_relaxed);
+        UpdateMaximum(this->maxHold_, hold.count());
+
+        this->holdHistogram_[GetBucket(hold)].fetch_add(
+            1,
+            std::memory_order_relaxed);
+    }
+
+    LockProfile GetProfile() const;
+
+    void Reset();
+
+private:
+    using Count = std::atomic<int64_t>;
+    using Histogram = std::array<std::atomic<uint64_t>, profileBucketCount>;
+
+    static void UpdateMaximum(Count &maximum, int64_t value)
+    {
+        auto current = maximum.load(std::memory_order_relaxed);
+
+        while (
+            value > current
+            && !maximum.compare_exchange_weak(
+                current,
+                value,
+                std::memory_order_relaxed))
+        {
+
+        }
+    }
+
+    const char *fileName_;
+    int line_;
+    const char *lockName_;
+
+    std::atomic<uint64_t> acquireCount_;
+    std::atomic<uint64_t> contendedCount_;
+    Count totalWait_;
+    Count maxWait_;
+    Count totalHold_;
+    Count maxHold_;
+    Histogram waitHistogram_;
+    Histogram holdHistogram_;
+};
+
+
+// Sites outlive the report made at exit, so they must not need destruction.
+static_assert(std::is_trivially_destructible_v<LockSite>);
+
+
+} // end namespace detail
+
+
+} // end namespace pex
@@ -1,8 +1,13 @@
 #include "pex/detail/log.h"
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 #include <fmt/core.h>
-#include <vector>
 #include <fields/describe.h>
 
 
@@ -13,21 +18,220 @@ namespace pex
 std::unique_ptr<std::mutex> logMutex(std::make_unique<std::mutex>());
 
 
+namespace
+{
+
+
 struct Name
+{
+    const void *parent;
+    const std::string *name;
+};
+
+
+// Another thread may release an interned name as soon as its shard is
+// unlocked, so the name is only read while the shard is locked. These are
+// copied out of an entry instead.
+struct NameInfo
+{
+    const void *parent;
+    bool isNamed;
+};
+
+
+struct NameCopy
 {
     const void *parent;
     std::string name;
 };
 
 
-std::map<const void *, Name> namesByAddress;
-std::map<const void *, Name> deletedNamesByAddress;
-std::map<const void *, const void *> observerByLinkedAddress;
+// Names are interned, so that each distinct name is stored once, and
+// registering a name that is already in use does not allocate.
+//
+// Each interned name counts the entries that hold it, and it is freed when
+// the last of them releases it, so the arena holds only the names in use.
+class NameArena
+{
+public:
+    const std::string * Intern(const std::string &name)
+    {
+        {
+            std::shared_lock lock(this->mutex_);
+            auto found = this->names_.find(name);
+
+            if (found != this->names_.end())
+            {
+                ++found->second;
+
+                return &found->first;
+            }
+        }
+
+        std::lock_guard lock(this->mutex_);
+
+        // The keys of an unordered_map do not move when it grows.
+        auto [found, inserted] = this->names_.try_emplace(name, 0);
+        ++found->second;
+
+        return &found->first;
+    }
+
+    void Release(const std::string *name)
+    {
+        std::lock_guard lock(this->mutex_);
+        auto found = this->names_.find(*name);
+        assert(found != this->names_.end());
+
+        if (--found->second == 0)
+        {
+            this->names_.erase(found);
+        }
+    }
+
+    size_t GetCount()
+    {
+        std::shared_lock lock(this->mutex_);
+
+        return this->names_.size();
+    }
+
+private:
+    std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::atomic<size_t>> names_;
+};
+
+
+// Each address belongs to one shard, and each shard has its own lock, so
+// nodes created on different threads rarely wait on each other.
+struct NameShard
+{
+    std::shared_mutex mutex;
+    std::unordered_map<const void *, Name> namesByAddress;
+    std::unordered_map<const void *, Name> deletedNamesByAddress;
+    std::unordered_map<const void *, const void *> observerByLinkedAddress;
+};
+
+
+class NameRegistry
+{
+public:
+    static constexpr size_t shardCount = 64;
+
+    NameShard & GetShard(const void *address)
+    {
+        // Fibonacci hashing spreads aligned addresses across the shards.
+        auto hash = reinterpret_cast<uintptr_t>(address)
+            * uint64_t{0x9E3779B97F4A7C15};
+
+        return this->shards_[(hash >> 32) % shardCount];
+    }
+
+    NameArena & GetArena()
+    {
+        return this->arena_;
+    }
+
+    template<typename Function>
+    void ForEachShard(Function &&function)
+    {
+        for (auto &shard: this->shards_)
+        {
+            function(shard);
+        }
+    }
+
+private:
+    std::array<NameShard, shardCount> shards_;
+    NameArena arena_;
+};
+
+
+NameRegistry & GetNameRegistry()
+{
+    // Nodes are named and cleared during static initialization and
+    // destruction, so the registry is never destroyed.
+    static auto registry = new NameRegistry();
+
+    return *registry;
+}
+
+
+NameShard & GetNameShard(const void *address)
+{
+    return GetNameRegistry().GetShard(address);
+}
+
+
+const std::string * InternName(const std::string &name)
+{
+    return GetNameRegistry().GetArena().Intern(name);
+}
+
+
+void ReleaseName(const std::string *name)
+{
+    GetNameRegistry().GetArena().Release(name);
+}
+
+
+// Stores name at address, and releases the name it replaces.
+void AssignName(
+    std::unordered_map<const void *, Name> &names,
+    const void *address,
+    const Name &name)
+{
+    auto [entry, inserted] = names.try_emplace(address, name);
+
+    if (!inserted)
+    {
+        ReleaseName(entry->second.name);
+        entry->second = name;
+    }
+}
+
+
+std::optional<NameInfo> FindName(const void *address)
+{
+    auto &shard = GetNameShard(address);
+    std::shared_lock lock(shard.mutex);
+
+    auto found = shard.namesByAddress.find(address);
+
+    if (found == shard.namesByAddress.end())
+    {
+        return {};
+    }
+
+    return NameInfo{found->second.parent, !found->second.name->empty()};
+}
+
+
+bool HasEntry(const void *address)
+{
+    auto &shard = GetNameShard(address);
+    std::shared_lock lock(shard.mutex);
+
+    return shard.namesByAddress.count(address) > 0;
+}
+
+
+void SetName(const void *address, const void *parent, const std::string &name)
+{
+    auto interned = InternName(name);
+    auto &shard = GetNameShard(address);
+    std::lock_guard lock(shard.mutex);
+
+    AssignName(shard.namesByAddress, address, Name{parent, interned});
+}
+
+
+} // end anonymous namespace
 
 
 std::string FormatName(
     const void *address,
-    const Name &name,
+    const NameCopy &name,
     int indent)
 {
     if (name.parent != nullptr)
@@ -54,7 +258,7 @@ std::string FormatName(
 
 std::string FormatDeletedName(
     const void *address,
-    const Name &name,
+    const NameCopy &name,
     int indent)
 {
     if (name.parent != nullptr)
@@ -85,7 +289,9 @@ void PexLinkObserver(const void *address, const void *observer)
     assert(HasPexName(address));
     assert(address != observer);
 
-    observerByLinkedAddress[address] = observer;
+    auto &shard = GetNameShard(address);
+    std::lock_guard lock(shard.mutex);
+    shard.observerByLinkedAddress[address] = observer;
 }
 
 
@@ -93,9 +299,14 @@ const void * GetLinkedObserver(const void *address)
 {
     do
     {
-        if (observerByLinkedAddress.count(address))
+        auto &shard = GetNameShard(address);
+        std::shared_lock lock(shard.mutex);
+
+        auto found = shard.observerByLinkedAddress.find(address);
+
+        if (found != shard.observerByLinkedAddress.end())
         {
-            return observerByLinkedAddress[address];
+            return found->second;
         }
     }
     while ((address = GetParent(address)));
@@ -106,38 +317,54 @@ const void * GetLinkedObserver(const void *address)
 
 void PexNameUnique(void *address, const std::string &name)
 {
-    if (namesByAddress.count(address))
+    auto interned = InternName(name);
+    auto &shard = GetNameShard(address);
+    std::lock_guard lock(shard.mutex);
+
+    auto [entry, inserted] =
+        shard.namesByAddress.try_emplace(address, Name{nullptr, interned});
+
+    if (!inserted)
     {
+        ReleaseName(interned);
         throw std::logic_error("Name exists");
     }
-
-    namesByAddress[address] = Name{nullptr, name};
 }
 
 
 void PexName(void *address, const std::string &name)
 {
-    if (namesByAddress.count(address))
-    {
-        auto &entry = namesByAddress[address];
-        entry.name = name;
-    }
-    else
+    auto interned = InternName(name);
+    auto &shard = GetNameShard(address);
+    std::lock_guard lock(shard.mutex);
+
+    auto [entry, inserted] =
+        shard.namesByAddress.try_emplace(address, Name{nullptr, interned});
+
+    if (!inserted)
     {
-        namesByAddress[address] = Name{nullptr, name};
+        // Keep the parent.
+        ReleaseName(entry->second.name);
+        entry->second.name = interned;
     }
 }
 
 
 void ClearPexName(void * address)
 {
-    if (namesByAddress.count(address))
+    auto &shard = GetNameShard(address);
+    std::lock_guard lock(shard.mutex);
+
+    auto found = shard.namesByAddress.find(address);
+
+    if (found != shard.namesByAddress.end())
     {
-        deletedNamesByAddress[address] = namesByAddress[address];
+        // The deleted entry takes over the live entry's hold on the name.
+        AssignName(shard.deletedNamesByAddress, address, found->second);
+        shard.namesByAddress.erase(found);
     }
 
-    namesByAddress.erase(address);
-    observerByLinkedAddress.erase(address);
+    shard.observerByLinkedAddress.erase(address);
 }
 
 
@@ -148,21 +375,12 @@ void PexName(void *address, void *parent, const std::string &name)
         throw std::runtime_error("parent must have unique address");
     }
 
-    if (!namesByAddress.count(parent))
+    if (!HasEntry(parent))
     {
         throw std::runtime_error("disallowed anonymous parent");
     }
 
-    if (namesByAddress.count(address))
-    {
-        auto &entry = namesByAddress[address];
-        entry.parent = parent;
-        entry.name = name;
-    }
-    else
-    {
-        namesByAddress[address] = Name{parent, name};
-    }
+    SetName(address, parent, name);
 }
 
 
@@ -173,19 +391,22 @@ void RegisterPexParent(void *parent, void *child)
         throw std::runtime_error("parent must have unique address");
     }
 
-    if (!namesByAddress.count(parent))
+    if (!HasEntry(parent))
     {
         throw std::runtime_error("disallowed anonymous parent");
     }
 
-    if (namesByAddress.count(child))
-    {
-        auto &name = namesByAddress[child];
-        name.parent = parent;
-    }
-    else
+    auto interned = InternName("");
+    auto &shard = GetNameShard(child);
+    std::lock_guard lock(shard.mutex);
+
+    auto [entry, inserted] =
+        shard.namesByAddress.try_emplace(child, Name{parent, interned});
+
+    if (!inserted)
     {
-        namesByAddress[child] = Name{parent, ""};
+        ReleaseName(interned);
+        entry->second.parent = parent;
     }
 }
 
@@ -197,19 +418,14 @@ bool HasPexName(const void *address)
         return false;
     }
 
-    if (!namesByAddress.count(address))
-    {
-        return false;
-    }
-
-    const auto &entry = namesByAddress[address];
+    auto entry = FindName(address);
 
-    if (entry.name.empty())
+    if (!entry)
     {
         return false;
     }
 
-    return true;
+    return entry->isNamed;
 }
 
 
@@ -220,14 +436,14 @@ bool HasNamedParent(const void *address)
         return false;
     }
 
-    if (!namesByAddress.count(address))
+    auto entry = FindName(address);
+
+    if (!entry)
     {
         return false;
     }
 
-    const auto &entry = namesByAddress[address];
-
-    return HasPexName(entry.parent);
+    return HasPexName(entry->parent);
 }
 
 
@@ -238,14 +454,14 @@ const void * GetParent(const void *address)
         return NULL;
     }
 
-    if (!namesByAddress.count(address))
+    auto entry = FindName(address);
+
+    if (!entry)
     {
         return NULL;
     }
 
-    const auto &entry = namesByAddress[address];
-
-    return entry.parent;
+    return entry->parent;
 }
 
 
@@ -260,17 +476,40 @@ std::string LookupPexName(const void *address, int indent)
         return indentString + "NULL";
     }
 
-    if (namesByAddress.count(address))
+    // Copy the entry before formatting, which looks up the parents.
+    std::optional<NameCopy> name;
+    bool isDeleted = false;
+
     {
-        auto &name = namesByAddress[address];
+        auto &shard = GetNameShard(address);
+        std::shared_lock lock(shard.mutex);
+
+        auto found = shard.namesByAddress.find(address);
 
-        return FormatName(address, name, indent);
+        if (found != shard.namesByAddress.end())
+        {
+            name = NameCopy{found->second.parent, *found->second.name};
+        }
+        else
+        {
+            auto deleted = shard.deletedNamesByAddress.find(address);
+
+            if (deleted != shard.deletedNamesByAddress.end())
+            {
+                name = NameCopy{deleted->second.parent, *deleted->second.name};
+                isDeleted = true;
+            }
+        }
     }
-    else if (deletedNamesByAddress.count(address))
+
+    if (name)
     {
-        auto &name = deletedNamesByAddress[address];
+        if (isDeleted)
+        {
+            return FormatDeletedName(address, *name, indent);
+        }
 
-        return FormatDeletedName(address, name, indent);
+        return FormatName(address, *name, indent);
     }
 
     return fmt::format("{}{}", indentString, address);
@@ -279,8 +518,30 @@ std::string LookupPexName(const void *address, int indent)
 
 void ResetPexNames()
 {
-    namesByAddress.clear();
-    deletedNamesByAddress.clear();
+    GetNameRegistry().ForEachShard(
+        [](NameShard &shard)
+        {
+            std::lock_guard lock(shard.mutex);
+
+            for (auto &entry: shard.namesByAddress)
+            {
+                ReleaseName(entry.second.name);
+            }
+
+            for (auto &entry: shard.deletedNamesByAddress)
+            {
+                ReleaseName(entry.second.name);
+            }
+
+            shard.namesByAddress.clear();
+            shard.deletedNamesByAddress.clear();
+        });
+}
+
+
+size_t GetInternedPexNameCount()
+{
+    return GetNameRegistry().GetArena().GetCount();
 }
 
 
@@ -4,6 +4,7 @@
 // #define ENABLE_PEX_CONCISE_LOG
 // #define USE_OBSERVER_NAME
 // #define ENABLE_PEX_NAMES
+// #define ENABLE_PEX_TRACE
 
 #include <mutex>
 #include <memory>
@@ -76,11 +77,21 @@ const void * GetParent(const void *address);
 
 void ResetPexNames();
 
+// The count of distinct names held by named and deleted nodes.
+size_t GetInternedPexNameCount();
+
 
 } // end namespace pex
 
 
-#ifdef ENABLE_PEX_LOG
+#if defined(ENABLE_PEX_TRACE)
+
+// Log statements are recorded in the trace, and decoded by pex/trace.h.
+#include "pex/detail/trace.h"
+
+#define PEX_LOG(...) PEX_TRACE_LOG(__VA_ARGS__)
+
+#elif defined(ENABLE_PEX_LOG)
 
 #include <iostream>
 #include <jive/path.h>
@@ -108,7 +119,11 @@ void ResetPexNames();
 #endif // ENABLE_PEX_LOG
 
 
-#ifdef ENABLE_PEX_CONCISE_LOG
+#if defined(ENABLE_PEX_TRACE)
+
+#define PEX_CONCISE_LOG(...) PEX_TRACE_LOG(__VA_ARGS__)
+
+#elif defined(ENABLE_PEX_CONCISE_LOG)
 
 #include <iostream>
 #include <jive/path.h>
@@ -62,7 +62,10 @@ struct Mute_
 };
 
 
-using MuteModel = typename ::pex::model::Value<Mute_>;
+// Muting changes which observers are notified, so it is never deferred by a
+// Propagation.
+using MuteModel =
+    ::pex::model::Value_<Mute_, NoFilter, GetAndSetTag, ImmediateTag>;
 using MuteControlType = typename ::pex::control::Value<MuteModel>;
 using MuteMuxType = typename ::pex::control::Mux<MuteModel>;
 using MuteFollowType = typename ::pex::control::Value<MuteMuxType>;
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <algorithm>
 #include <type_traits>
 #include <vector>
 #include <cassert>
@@ -9,15 +8,21 @@
 
 
 #ifndef NDEBUG
-#include <jive/scope_flag.h>
 #include <fields/describe.h>
 #endif
 
 #include "pex/access_tag.h"
+#include "pex/notify_policy.h"
 #include "pex/argument.h"
 #include "pex/error.h"
 #include "pex/detail/log.h"
 #include "pex/detail/observer_name.h"
+#include "pex/detail/connection.h"
+#include "pex/detail/connection_slots.h"
+#include "pex/detail/concurrent_connections.h"
+#include "pex/detail/propagation.h"
+#include "pex/detail/profile.h"
+#include "pex/detail/trace.h"
 
 
 #ifndef NDEBUG
@@ -33,47 +38,69 @@ namespace detail
 {
 
 
-#ifndef NDEBUG
-#define THROW_IF_NOTIFYING                                           \
-    if (this->isNotifying_)                                          \
-    {                                                                \
-        throw PexError(                                              \
-            "Cannot modify connections from notification callback"); \
-    }                                                                \
-
-#define REPORT_NOTIFYING                                             \
-    auto isNotifying = jive::ScopedCountFlag(this->isNotifying_);
-
-#else
-#define THROW_IF_NOTIFYING
-#define REPORT_NOTIFYING
-#endif
+// The number of connections stored in place before NotifyMany_ allocates.
+// Nearly all nodes have fewer observers than this.
+inline constexpr size_t inlineConnectionCount = 2;
+
+
+template<typename Policy, typename ConnectionType>
+struct NotifyConnections_;
+
+template<typename ConnectionType>
+struct NotifyConnections_<SingleThreadedTag, ConnectionType>
+{
+    using Type = ConnectionSlots<ConnectionType, inlineConnectionCount>;
+};
+
+template<typename ConnectionType>
+struct NotifyConnections_<ImmediateTag, ConnectionType>
+{
+    using Type = ConnectionSlots<ConnectionType, inlineConnectionCount>;
+};
 
+template<typename ConnectionType>
+struct NotifyConnections_<ConcurrentTag, ConnectionType>
+{
+    using Type = ConcurrentConnections<ConnectionType>;
+};
+
+template<typename Policy, typename ConnectionType>
+using NotifyConnectionsT =
+    typename NotifyConnections_<Policy, ConnectionType>::Type;
 
-template<typename ConnectionType, typename Access>
+
+template<typename ConnectionType, typename Access, typename Policy>
 class NotifyMany_
 #ifndef NDEBUG
     :
     public LogsObservers
 #endif
 {
+    static_assert(IsNotifyPolicy<Policy>);
+
 public:
     using Observer = typename ConnectionType::Observer;
     using Callable = typename ConnectionType::Callable;
+    using NotifyPolicy = Policy;
 
     NotifyMany_()
         :
 #ifndef NDEBUG
         LogsObservers{},
-        isNotifying_{},
 #endif
-        connections_{}
+        connections_{},
+        propagationNode_{}
     {
 
     }
 
     ~NotifyMany_()
     {
+        if constexpr (NotifyMany_::canSchedule)
+        {
+            this->propagationNode_.Cancel();
+        }
+
         if (!this->connections_.empty())
         {
             std::cout << "WARNING: Active connections destroyed: ";
@@ -101,9 +128,9 @@ public:
         :
 #ifndef NDEBUG
         LogsObservers(other),
-        isNotifying_{},
 #endif
-        connections_(other.connections_)
+        connections_(other.connections_),
+        propagationNode_()
     {
 
     }
@@ -112,17 +139,18 @@ public:
         :
 #ifndef NDEBUG
         LogsObservers(std::move(other)),
-        isNotifying_{},
 #endif
-        connections_(std::move(other.connections_))
+        connections_(std::move(other.connections_)),
+        propagationNode_()
     {
         other.connections_.clear();
     }
 
     NotifyMany_ & operator=(const NotifyMany_ &other)
     {
+        assert(!this->connections_.IsDeferring());
+
 #ifndef NDEBUG
-        assert(!this->isNotifying_);
         this->LogsObservers::operator=(other);
 #endif
         this->connections_ = other.connections_;
@@ -132,8 +160,9 @@ public:
 
     NotifyMany_ & operator=(NotifyMany_ &&other)
     {
+        assert(!this->connections_.IsDeferring());
+
 #ifndef NDEBUG
-        assert(!this->isNotifying_);
         this->LogsObservers::operator=(std::move(other));
 #endif
         this->connections_ = std::move(other.connections_);
@@ -143,14 +172,12 @@ public:
     }
 
     template<typename T>
-    void Connect(T *observer, Callable callable)
+    ConnectionToken Connect(T *observer, Callable callable)
     {
         static_assert(
             HasAccess<GetTag, Access>,
             "Cannot connect observer without read access.");
 
-        THROW_IF_NOTIFYING
-
 #ifdef ENABLE_PEX_NAMES
         if (!HasPexName(observer))
         {
@@ -170,19 +197,54 @@ public:
             ") connecting to ",
             LookupPexName(this));
 
+        [[maybe_unused]] auto lock = this->connections_.LockWriters();
+
 #ifndef NDEBUG
         this->RegisterObserver(observer);
 #endif
 
         // Callbacks will be executed in the order the connections are made.
-        this->connections_.emplace_back(observer, callable);
+        // A connection made from a callback will not be notified until the
+        // next notification.
+        return this->connections_.Emplace(observer, callable);
     }
 
-    /** Remove all registered callbacks for the observer. **/
-    void Disconnect(Observer *observer)
+    /** Connect a callback that is known at compile time.
+     **
+     ** callback is a member function of T, or a function taking a T *.
+     ** Notifications reach it through a plain function pointer, and the
+     ** call to callback can be inlined.
+     **
+     **     model.Connect<&Observer::OnValue_>(this);
+     **/
+    template<auto callback, typename T>
+    ConnectionToken Connect(T *observer)
     {
-        THROW_IF_NOTIFYING
+        static_assert(
+            ConnectionType::hasFunctionPointer,
+            "Bound callbacks require a void observer.");
+
+        return this->Connect(
+            observer,
+            BoundCallback
+            <
+                callback,
+                T,
+                typename ConnectionType::FunctionPointer
+            >);
+    }
 
+    /** Remove all registered callbacks for the observer.
+     **
+     ** It is safe to disconnect from a callback. A connection removed during
+     ** notification will not be called again, but it is only destroyed once
+     ** the notification is complete.
+     **
+     ** Linear in the number of connections. Disconnect by token is constant
+     ** time.
+     **/
+    void Disconnect(Observer *observer)
+    {
         PEX_LOG(
             ObserverName<Observer>,
             " (",
@@ -190,67 +252,90 @@ public:
             ") disconnecting from ",
             LookupPexName(this));
 
-#ifndef NDEBUG
-        auto found = std::find(
-            std::begin(this->connections_),
-            std::end(this->connections_),
-            ConnectionType(observer));
-
-        if (found == std::end(this->connections_))
         {
-            throw std::logic_error(
-                "Attempted disconnection from wrong model");
-        }
-#endif
+            [[maybe_unused]] auto lock = this->connections_.LockWriters();
 
-        std::erase(
-            this->connections_,
-            ConnectionType(observer));
+            [[maybe_unused]] auto erasedCount =
+                this->connections_.Erase(observer);
 
 #ifndef NDEBUG
-        this->RemoveObserver(observer);
+            if (erasedCount == 0)
+            {
+                throw std::logic_error(
+                    "Attempted disconnection from wrong model");
+            }
+
+            this->RemoveObserver(observer);
+#endif
+        }
 
-        for (auto &connection: this->connections_)
+        this->connections_.Synchronize();
+    }
+
+    /** Remove the single connection identified by token. **/
+    void Disconnect(ConnectionToken token)
+    {
         {
-            if (connection.GetObserver() == observer)
+            [[maybe_unused]] auto lock = this->connections_.LockWriters();
+            auto connection = this->connections_.Find(token);
+
+            if (!connection)
             {
                 throw std::logic_error(
-                    "Expected all references to Observer to have been removed");
+                    "Attempted disconnection with an invalid token");
             }
-        }
+
+            [[maybe_unused]] auto observer = connection->GetObserver();
+
+            PEX_LOG(
+                ObserverName<Observer>,
+                " (",
+                LookupPexName(observer),
+                ") disconnecting from ",
+                LookupPexName(this));
+
+            this->connections_.Erase(token);
+
+#ifndef NDEBUG
+            this->RemoveObserver(observer);
 #endif
+        }
+
+        this->connections_.Synchronize();
     }
 
+    // Linear in the number of connections.
     size_t GetNotificationOrder(Observer *observer)
     {
-        if (!this->HasObserver(observer))
+        auto order = this->connections_.GetOrder(observer);
+
+        if (!order)
         {
             throw std::logic_error("Observer not found");
         }
 
-        auto found = std::find(
-            this->connections_.begin(),
-            this->connections_.end(),
-            ConnectionType(observer));
-
-        auto result = std::distance(this->connections_.begin(), found);
-
-        assert(result >= 0);
-
-        return static_cast<size_t>(result);
+        return *order;
     }
 
     // Only make the connection if the observer is not already connected.
+    // Returns the token of the existing connection if there is one.
+    //
+    // The search for an existing connection is linear in the number of
+    // connections. Nodes have few observers, and an index from observer to
+    // token would cost an allocation per node, so none is kept.
     template<typename T>
-    void ConnectOnce(T *observer, Callable callable)
+    ConnectionToken ConnectOnce(T *observer, Callable callable)
     {
-        if (this->HasObserver(observer))
+        [[maybe_unused]] auto lock = this->connections_.LockWriters();
+        auto existing = this->connections_.Find(observer);
+
+        if (existing)
         {
             // This observer has already been added to the connections_.
-            return;
+            return *existing;
         }
 
-        this->Connect(observer, callable);
+        return this->Connect(observer, callable);
     }
 
     size_t GetNotifierCount() const
@@ -263,52 +348,84 @@ public:
         return !this->connections_.empty();
     }
 
+    // Linear in the number of connections.
     bool HasObserver(Observer *observer)
     {
-        auto found = std::find(
-            this->connections_.begin(),
-            this->connections_.end(),
-            ConnectionType(observer));
+        return this->connections_.Find(observer).has_value();
+    }
 
-        return (found != this->connections_.end());
+    bool HasConnection(ConnectionToken token) const
+    {
+        return this->connections_.Contains(token);
     }
 
 protected:
     void ClearConnections_()
     {
-        THROW_IF_NOTIFYING
         this->connections_.clear();
+        this->connections_.Synchronize();
     }
 
 protected:
-#ifndef NDEBUG
-    jive::CountFlag<size_t> isNotifying_;
-#endif
-    std::vector<ConnectionType> connections_;
+    using Connections = NotifyConnectionsT<Policy, ConnectionType>;
+
+    // Notifications are only scheduled by a Propagation on the notifying
+    // thread, so concurrent notifiers always deliver immediately.
+    static constexpr bool canSchedule =
+        std::is_same_v<Policy, SingleThreadedTag>;
+
+    Connections connections_;
+
+    [[no_unique_address]]
+    PropagationNodeT<canSchedule> propagationNode_;
 };
 
 
 // For callbacks without an argument (signals)
-template<typename ConnectionType, typename Access, typename = std::void_t<>>
-class NotifyMany: public NotifyMany_<ConnectionType, Access>
+template
+<
+    typename ConnectionType,
+    typename Access,
+    typename Policy = SingleThreadedTag,
+    typename = std::void_t<>
+>
+class NotifyMany: public NotifyMany_<ConnectionType, Access, Policy>
 {
 protected:
     void Notify_()
     {
-        REPORT_NOTIFYING
-
-        for (auto &connection: this->connections_)
+        if constexpr (NotifyMany::canSchedule)
         {
-            connection();
+            if (PropagationNode::IsScheduling())
+            {
+                this->propagationNode_.Schedule(
+                    [this]()
+                    {
+                        this->Deliver_();
+                    });
+
+                return;
+            }
         }
+
+        this->Deliver_();
     }
 
-    void NotifyMayModify_()
+private:
+    void Deliver_()
     {
-        auto connections = this->connections_;
+        // Changes to the connections made by the callbacks are applied
+        // after the outermost notification returns.
+        typename NotifyMany::Connections::Deferral deferral(
+            this->connections_);
+
+        PEX_PROFILE_NOTIFY(this);
+        PEX_TRACE(TraceKind::notify, this);
 
-        for (auto &connection: connections)
+        for (auto &connection: deferral)
         {
+            PEX_PROFILE_CALLBACK(this, connection.GetObserver());
+            PEX_TRACE(TraceKind::callback, connection.GetObserver());
             connection();
         }
     }
@@ -316,14 +433,15 @@ protected:
 
 
 // Iterates over connections, passing the value to each callback.
-template<typename ConnectionType, typename Access>
+template<typename ConnectionType, typename Access, typename Policy>
 class NotifyMany
 <
     ConnectionType,
     Access,
+    Policy,
     std::void_t<typename ConnectionType::Type>
 >
-    : public NotifyMany_<ConnectionType, Access>
+    : public NotifyMany_<ConnectionType, Access, Policy>
 {
 public:
     using Type = typename ConnectionType::Type;
@@ -331,10 +449,36 @@ public:
 protected:
     void Notify_(Argument<typename ConnectionType::Type> value)
     {
-        REPORT_NOTIFYING
+        if constexpr (NotifyMany::canSchedule)
+        {
+            if (PropagationNode::IsScheduling())
+            {
+                this->propagationNode_.Schedule(
+                    [this, scheduled = Type(value)]()
+                    {
+                        this->Deliver_(scheduled);
+                    });
+
+                return;
+            }
+        }
+
+        this->Deliver_(value);
+    }
+
+private:
+    void Deliver_(Argument<typename ConnectionType::Type> value)
+    {
+        typename NotifyMany::Connections::Deferral deferral(
+            this->connections_);
+
+        PEX_PROFILE_NOTIFY(this);
+        PEX_TRACE(TraceKind::notify, this);
 
-        for (auto &connection: this->connections_)
+        for (auto &connection: deferral)
         {
+            PEX_PROFILE_CALLBACK(this, connection.GetObserver());
+            PEX_TRACE(TraceKind::callback, connection.GetObserver());
             connection(value);
         }
     }
@@ -4,8 +4,11 @@
 #include <optional>
 #include "pex/access_tag.h"
 #include "pex/argument.h"
+#include "pex/notify_policy.h"
 #include "pex/detail/log.h"
 #include "pex/detail/observer_name.h"
+#include "pex/detail/connection_slots.h"
+#include "pex/detail/propagation.h"
 
 #ifndef NDEBUG
 #include <pex/detail/logs_observers.h>
@@ -41,13 +44,15 @@ namespace detail
 {
 
 
-template<typename ConnectionType, typename Access>
+template<typename ConnectionType, typename Access, typename Policy>
 class NotifyOne_
 #ifndef NDEBUG
     :
     public LogsObservers
 #endif
 {
+    static_assert(IsNotifyPolicy<Policy>);
+
 public:
     using Observer = typename ConnectionType::Observer;
     using Callable = typename ConnectionType::Callable;
@@ -57,13 +62,15 @@ public:
 #ifndef NDEBUG
         LogsObservers{},
 #endif
-        connection_{}
+        connection_{},
+        generation_{},
+        propagationNode_{}
     {
 
     }
 
     template<typename T>
-    void Connect(T *observer, Callable callable)
+    ConnectionToken Connect(T *observer, Callable callable)
     {
         static_assert(
             HasAccess<GetTag, Access>,
@@ -105,10 +112,19 @@ public:
 #endif
 
         this->connection_ = ConnectionType(observer, callable);
+
+        // There is only one slot, but the generation still distinguishes
+        // this connection from earlier ones.
+        return {0, ++this->generation_};
     }
 
     ~NotifyOne_()
     {
+        if constexpr (NotifyOne_::canSchedule)
+        {
+            this->propagationNode_.Cancel();
+        }
+
         if (this->connection_)
         {
             std::cout << "Warning: Active connection destroyed: ";
@@ -135,7 +151,9 @@ public:
 #ifndef NDEBUG
         LogsObservers(other),
 #endif
-        connection_(other.connection_)
+        connection_(other.connection_),
+        generation_(other.generation_),
+        propagationNode_()
     {
 
     }
@@ -145,7 +163,9 @@ public:
 #ifndef NDEBUG
         LogsObservers(std::move(other)),
 #endif
-        connection_(std::move(other.connection_))
+        connection_(std::move(other.connection_)),
+        generation_(other.generation_),
+        propagationNode_()
     {
         other.connection_.reset();
     }
@@ -156,6 +176,7 @@ public:
         this->LogsObservers::operator=(other);
 #endif
         this->connection_ = other.connection_;
+        this->generation_ = other.generation_;
 
         return *this;
     }
@@ -166,6 +187,7 @@ public:
         this->LogsObservers::operator=(std::move(other));
 #endif
         this->connection_ = std::move(other.connection_);
+        this->generation_ = other.generation_;
         other.connection_.reset();
 
         return *this;
@@ -209,6 +231,18 @@ public:
         this->connection_.reset();
     }
 
+    /** Remove the connection identified by token. **/
+    void Disconnect(ConnectionToken token)
+    {
+        if (!this->HasConnection(token))
+        {
+            throw std::logic_error(
+                "Attempted disconnection with an invalid token");
+        }
+
+        this->Disconnect(this->connection_->GetObserver());
+    }
+
     bool HasObserver(Observer *observer)
     {
         if (!this->connection_)
@@ -226,14 +260,21 @@ public:
         return this->connection_.has_value();
     }
 
-    void ConnectOnce(Observer *observer, Callable callable)
+    bool HasConnection(ConnectionToken token) const
+    {
+        return this->connection_.has_value()
+            && (token.index == 0)
+            && (token.generation == this->generation_);
+    }
+
+    ConnectionToken ConnectOnce(Observer *observer, Callable callable)
     {
         if (this->HasObserver(observer))
         {
-            return;
+            return {0, this->generation_};
         }
 
-        this->Connect(observer, callable);
+        return this->Connect(observer, callable);
     }
 
 protected:
@@ -253,15 +294,49 @@ protected:
     }
 
 
+    // Only SingleThreadedTag notifiers are scheduled by a Propagation.
+    static constexpr bool canSchedule =
+        std::is_same_v<Policy, SingleThreadedTag>;
+
     std::optional<ConnectionType> connection_;
+    uint32_t generation_;
+
+    [[no_unique_address]]
+    PropagationNodeT<canSchedule> propagationNode_;
 };
 
 
-template<typename ConnectionType, typename Access, typename = std::void_t<>>
-class NotifyOne : public NotifyOne_<ConnectionType, Access>
+template
+<
+    typename ConnectionType,
+    typename Access,
+    typename Policy = SingleThreadedTag,
+    typename = std::void_t<>
+>
+class NotifyOne : public NotifyOne_<ConnectionType, Access, Policy>
 {
 protected:
     void Notify_()
+    {
+        if constexpr (NotifyOne::canSchedule)
+        {
+            if (PropagationNode::IsScheduling())
+            {
+                this->propagationNode_.Schedule(
+                    [this]()
+                    {
+                        this->Deliver_();
+                    });
+
+                return;
+            }
+        }
+
+        this->Deliver_();
+    }
+
+private:
+    void Deliver_()
     {
         if (this->connection_)
         {
@@ -273,20 +348,41 @@ protected:
 
 // Selected if ConnectionType has the member 'Type'.
 // This Notify_ method takes an argument.
-template<typename ConnectionType, typename Access>
+template<typename ConnectionType, typename Access, typename Policy>
 class NotifyOne
 <
     ConnectionType,
     Access,
+    Policy,
     std::void_t<typename ConnectionType::Type>
 >
-    : public NotifyOne_<ConnectionType, Access>
+    : public NotifyOne_<ConnectionType, Access, Policy>
 {
 public:
     using Type = typename ConnectionType::Type;
 
 protected:
     void Notify_(Argument<typename ConnectionType::Type> value)
+    {
+        if constexpr (NotifyOne::canSchedule)
+        {
+            if (PropagationNode::IsScheduling())
+            {
+                this->propagationNode_.Schedule(
+                    [this, scheduled = Type(value)]()
+                    {
+                        this->Deliver_(scheduled);
+                    });
+
+                return;
+            }
+        }
+
+        this->Deliver_(value);
+    }
+
+private:
+    void Deliver_(Argument<typename ConnectionType::Type> value)
     {
         if (this->connection_)
         {
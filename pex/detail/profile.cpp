@@ -0,0 +1,291 @@
+#include "pex/detail/profile.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <fmt/core.h>
+#include "pex/detail/log.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+using ObserverKey = std::pair<const void *, const void *>;
+
+
+// Notifications may come from any thread.
+std::mutex profileMutex;
+std::unordered_map<const void *, NodeProfile> nodeProfiles;
+std::map<ObserverKey, ObserverProfile> observerProfiles;
+
+
+size_t GetBucket(std::chrono::nanoseconds elapsed)
+{
+    auto count = static_cast<uint64_t>(
+        (elapsed.count() > 0) ? elapsed.count() : 1);
+
+    // The index of the highest set bit.
+    auto bucket = static_cast<size_t>(std::bit_width(count) - 1);
+
+    return std::min(bucket, profileBucketCount - 1);
+}
+
+
+void RecordNotify(
+    const void *node,
+    size_t fanOut,
+    std::chrono::nanoseconds elapsed)
+{
+    std::lock_guard lock(profileMutex);
+
+    auto [entry, isNew] = nodeProfiles.try_emplace(node);
+    auto &profile = entry->second;
+
+    if (isNew)
+    {
+        profile.name = LookupPexName(node);
+    }
+
+    ++profile.notifyCount;
+    profile.callbackCount += fanOut;
+    profile.maxFanOut = std::max(profile.maxFanOut, fanOut);
+    profile.totalTime += elapsed;
+}
+
+
+void RecordCallback(
+    const void *node,
+    const void *observer,
+    std::chrono::nanoseconds elapsed)
+{
+    std::lock_guard lock(profileMutex);
+
+    auto [entry, isNew] =
+        observerProfiles.try_emplace(ObserverKey(node, observer));
+
+    auto &profile = entry->second;
+
+    if (isNew)
+    {
+        profile.observer = LookupPexName(observer);
+        profile.node = LookupPexName(node);
+    }
+
+    ++profile.callCount;
+    profile.totalTime += elapsed;
+    profile.maxTime = std::max(profile.maxTime, elapsed);
+    ++profile.histogram[GetBucket(elapsed)];
+}
+
+
+std::string EscapeJson(const std::string &value)
+{
+    std::string result;
+    result.reserve(value.size());
+
+    for (auto c: value)
+    {
+        switch (c)
+        {
+            case '"':
+                result += "\\\"";
+                break;
+
+            case '\\':
+                result += "\\\\";
+                break;
+
+            case '\n':
+                result += "\\n";
+                break;
+
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    result += fmt::format("\\u{:04x}", static_cast<int>(c));
+                }
+                else
+                {
+                    result += c;
+                }
+        }
+    }
+
+    return result;
+}
+
+
+} // end namespace detail
+
+
+std::vector<NodeProfile> GetHottestNodes(size_t count)
+{
+    std::vector<NodeProfile> result;
+
+    {
+        std::lock_guard lock(detail::profileMutex);
+
+        for (auto &entry: detail::nodeProfiles)
+        {
+            result.push_back(entry.second);
+        }
+    }
+
+    auto resultCount = std::min(count, result.size());
+
+    std::partial_sort(
+        std::begin(result),
+        std::next(std::begin(result), static_cast<ptrdiff_t>(resultCount)),
+        std::end(result),
+        [](const NodeProfile &left, const NodeProfile &right)
+        {
+            return left.notifyCount > right.notifyCount;
+        });
+
+    result.resize(resultCount);
+
+    return result;
+}
+
+
+std::vector<ObserverProfile> GetSlowestObservers(size_t count)
+{
+    std::vector<ObserverProfile> result;
+
+    {
+        std::lock_guard lock(detail::profileMutex);
+
+        for (auto &entry: detail::observerProfiles)
+        {
+            result.push_back(entry.second);
+        }
+    }
+
+    auto resultCount = std::min(count, result.size());
+
+    std::partial_sort(
+        std::begin(result),
+        std::next(std::begin(result), static_cast<ptrdiff_t>(resultCount)),
+        std::end(result),
+        [](const ObserverProfile &left, const ObserverProfile &right)
+        {
+            return left.totalTime > right.totalTime;
+        });
+
+    result.resize(resultCount);
+
+    return result;
+}
+
+
+void ReportProfile(std::ostream &output, size_t count)
+{
+    output << "Hottest nodes:\n";
+
+    for (auto &node: GetHottestNodes(count))
+    {
+        output << fmt::format(
+            "  {:>10} notifications, {:>10} callbacks, max fan-out {:>4}, "
+            "{:>12} ns: {}\n",
+            node.notifyCount,
+            node.callbackCount,
+            node.maxFanOut,
+            node.totalTime.count(),
+            node.name);
+    }
+
+    output << "Slowest observers:\n";
+
+    for (auto &observer: GetSlowestObservers(count))
+    {
+        output << fmt::format(
+            "  {:>12} ns total, {:>10} ns max, {:>10} calls: {} from {}\n",
+            observer.totalTime.count(),
+            observer.maxTime.count(),
+            observer.callCount,
+            observer.observer,
+            observer.node);
+    }
+
+    output.flush();
+}
+
+
+void ExportProfileJson(std::ostream &output)
+{
+    auto nodes = GetHottestNodes(std::numeric_limits<size_t>::max());
+    auto observers = GetSlowestObservers(std::numeric_limits<size_t>::max());
+
+    output << "{\n  \"nodes\": [";
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        auto &node = nodes[i];
+
+        output << ((i == 0) ? "\n" : ",\n");
+
+        output << fmt::format(
+            "    {{\"name\": \"{}\", \"notifyCount\": {}, "
+            "\"callbackCount\": {}, \"maxFanOut\": {}, "
+            "\"totalNanoseconds\": {}}}",
+            detail::EscapeJson(node.name),
+            node.notifyCount,
+            node.callbackCount,
+            node.maxFanOut,
+            node.totalTime.count());
+    }
+
+    output << "\n  ],\n  \"observers\": [";
+
+    for (size_t i = 0; i < observers.size(); ++i)
+    {
+        auto &observer = observers[i];
+
+        output << ((i == 0) ? "\n" : ",\n");
+
+        output << fmt::format(
+            "    {{\"observer\": \"{}\", \"node\": \"{}\", "
+            "\"callCount\": {}, \"totalNanoseconds\": {}, "
+            "\"maxNanoseconds\": {}, \"histogram\": [",
+            detail::EscapeJson(observer.observer),
+            detail::EscapeJson(observer.node),
+            observer.callCount,
+            observer.totalTime.count(),
+            observer.maxTime.count());
+
+        for (size_t bucket = 0; bucket < profileBucketCount; ++bucket)
+        {
+            if (bucket > 0)
+            {
+                output << ", ";
+            }
+
+            output << observer.histogram[bucket];
+        }
+
+        output << "]}";
+    }
+
+    output << "\n  ]\n}\n";
+    output.flush();
+}
+
+
+void ResetProfile()
+{
+    std::lock_guard lock(detail::profileMutex);
+    detail::nodeProfiles.clear();
+    detail::observerProfiles.clear();
+}
+
+
+} // end namespace pex
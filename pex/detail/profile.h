@@ -0,0 +1,134 @@
+/**
+  * @file profile.h
+  *
+  * @brief Records notifications and callback times for pex/profile.h.
+  *
+  * Nothing is recorded unless ENABLE_PEX_PROFILE is defined.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <chrono>
+#include "pex/profile.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+void RecordNotify(
+    const void *node,
+    size_t fanOut,
+    std::chrono::nanoseconds elapsed);
+
+void RecordCallback(
+    const void *node,
+    const void *observer,
+    std::chrono::nanoseconds elapsed);
+
+
+using ProfileClock = std::chrono::steady_clock;
+
+
+// Times one Notify_ of node, and counts its callbacks.
+class ProfileNotify
+{
+public:
+    ProfileNotify(const void *node)
+        :
+        node_(node),
+        fanOut_(0),
+        start_(ProfileClock::now())
+    {
+
+    }
+
+    ProfileNotify(const ProfileNotify &) = delete;
+    ProfileNotify & operator=(const ProfileNotify &) = delete;
+
+    ~ProfileNotify()
+    {
+        RecordNotify(
+            this->node_,
+            this->fanOut_,
+            ProfileClock::now() - this->start_);
+    }
+
+    void AddCallback()
+    {
+        ++this->fanOut_;
+    }
+
+private:
+    const void *node_;
+    size_t fanOut_;
+    ProfileClock::time_point start_;
+};
+
+
+// Times one callback made by a node to an observer.
+class ProfileCallback
+{
+public:
+    ProfileCallback(
+        ProfileNotify &notify,
+        const void *node,
+        const void *observer)
+        :
+        node_(node),
+        observer_(observer),
+        start_(ProfileClock::now())
+    {
+        notify.AddCallback();
+    }
+
+    ProfileCallback(const ProfileCallback &) = delete;
+    ProfileCallback & operator=(const ProfileCallback &) = delete;
+
+    ~ProfileCallback()
+    {
+        RecordCallback(
+            this->node_,
+            this->observer_,
+            ProfileClock::now() - this->start_);
+    }
+
+private:
+    const void *node_;
+    const void *observer_;
+    ProfileClock::time_point start_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace pex
+
+
+#ifdef ENABLE_PEX_PROFILE
+
+#define PEX_PROFILE_NOTIFY(node) \
+    ::pex::detail::ProfileNotify pexProfileNotify_(node)
+
+#define PEX_PROFILE_CALLBACK(node, observer) \
+    ::pex::detail::ProfileCallback pexProfileCallback_( \
+        pexProfileNotify_, \
+        node, \
+        observer)
+
+#else
+
+#define PEX_PROFILE_NOTIFY(node)
+#define PEX_PROFILE_CALLBACK(node, observer)
+
+#endif // ENABLE_PEX_PROFILE
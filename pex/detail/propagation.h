@@ -0,0 +1,300 @@
+/**
+  * @file propagation.h
+  *
+  * @brief Schedules the notifications made while a pex::Propagation is in
+  * scope, so that each node notifies once, in depth order.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <functional>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+class PropagationScheduler;
+
+
+// The scheduler of the outermost Propagation on this thread, if any.
+inline thread_local PropagationScheduler *activePropagation = nullptr;
+
+
+// The exception thrown by an observer while the outermost Propagation on
+// this thread was destroyed, until it is taken.
+inline thread_local std::exception_ptr propagationFailure;
+
+
+// The position of a scheduled delivery.
+struct PropagationKey
+{
+    size_t depth;
+    size_t sequence;
+
+    bool operator<(const PropagationKey &other) const
+    {
+        return std::tie(this->depth, this->sequence)
+            < std::tie(other.depth, other.sequence);
+    }
+};
+
+
+/**
+ ** The scheduling state of one notifier.
+ **
+ ** The height is the deepest position at which the node has been notified.
+ ** It only grows, so a node that has been reached through a longer path is
+ ** ordered after the nodes on that path in every later propagation.
+ **
+ ** The node is trivially destructible. The notifier that owns it must Cancel
+ ** it before it is destroyed.
+ **/
+class PropagationNode
+{
+public:
+    PropagationNode()
+        :
+        height_(0),
+        key_()
+    {
+
+    }
+
+    // A copy is a different node, with nothing scheduled.
+    PropagationNode(const PropagationNode &)
+        :
+        PropagationNode()
+    {
+
+    }
+
+    PropagationNode & operator=(const PropagationNode &)
+    {
+        return *this;
+    }
+
+    static bool IsScheduling()
+    {
+        return activePropagation != nullptr;
+    }
+
+    /** Defer deliver until the propagation is flushed.
+     **
+     ** Replaces any delivery already scheduled for this node.
+     ** Only call while IsScheduling().
+     **/
+    void Schedule(std::function<void()> deliver);
+
+    /** Remove the scheduled delivery, if any. **/
+    void Cancel();
+
+    bool IsPending() const
+    {
+        return this->key_.has_value();
+    }
+
+    size_t GetHeight() const
+    {
+        return this->height_;
+    }
+
+private:
+    friend class PropagationScheduler;
+
+    size_t height_;
+
+    // The position of the scheduled delivery, while there is one.
+    std::optional<PropagationKey> key_;
+};
+
+
+static_assert(std::is_trivially_destructible_v<PropagationNode>);
+
+
+// Notifiers that never schedule keep no state.
+class NoPropagationNode
+{
+
+};
+
+
+template<bool canSchedule>
+using PropagationNodeT =
+    std::conditional_t<canSchedule, PropagationNode, NoPropagationNode>;
+
+
+class PropagationScheduler
+{
+public:
+    PropagationScheduler()
+        :
+        pending_(),
+        sequence_(0),
+        depth_(0),
+        isFlushing_(false)
+    {
+
+    }
+
+    PropagationScheduler(const PropagationScheduler &) = delete;
+    PropagationScheduler & operator=(const PropagationScheduler &) = delete;
+
+    void Schedule(PropagationNode &node, std::function<void()> deliver)
+    {
+        // A node notified by the delivery of another node is one level
+        // deeper.
+        size_t depth = (this->isFlushing_) ? this->depth_ + 1 : 0;
+        node.height_ = std::max(node.height_, depth);
+
+        if (node.key_)
+        {
+            auto pending = this->pending_.find(*node.key_);
+            assert(pending != std::end(this->pending_));
+
+            if (node.key_->depth == node.height_)
+            {
+                // Keep the position, and deliver the latest notification.
+                pending->second.deliver = std::move(deliver);
+
+                return;
+            }
+
+            this->pending_.erase(pending);
+        }
+
+        PropagationKey key{node.height_, this->sequence_++};
+        this->pending_.emplace(key, Pending{&node, std::move(deliver)});
+        node.key_ = key;
+    }
+
+    void Cancel(PropagationNode &node)
+    {
+        if (!node.key_)
+        {
+            return;
+        }
+
+        this->pending_.erase(*node.key_);
+        node.key_.reset();
+    }
+
+    /** Deliver the scheduled notifications, shallowest first.
+     **
+     ** Notifications scheduled by a delivery join the queue at a greater
+     ** depth. A node that is notified again after its delivery, because it
+     ** was reached by a longer path than it has been before, is delivered
+     ** again, and its height is raised for the next propagation.
+     **
+     ** If a delivery throws, the deliveries that were still scheduled are
+     ** discarded, and the exception is rethrown.
+     **/
+    void Flush()
+    {
+        if (this->isFlushing_)
+        {
+            return;
+        }
+
+        struct FlushingFlag
+        {
+            PropagationScheduler &scheduler;
+
+            ~FlushingFlag()
+            {
+                this->scheduler.isFlushing_ = false;
+                this->scheduler.depth_ = 0;
+            }
+        };
+
+        this->isFlushing_ = true;
+        FlushingFlag flushingFlag{*this};
+
+        try
+        {
+            while (!this->pending_.empty())
+            {
+                auto next = std::begin(this->pending_);
+                this->depth_ = next->first.depth;
+                auto deliver = std::move(next->second.deliver);
+                next->second.node->key_.reset();
+                this->pending_.erase(next);
+
+                deliver();
+            }
+        }
+        catch (...)
+        {
+            this->Discard();
+            throw;
+        }
+    }
+
+    void Discard()
+    {
+        for (auto &entry: this->pending_)
+        {
+            entry.second.node->key_.reset();
+        }
+
+        this->pending_.clear();
+    }
+
+    size_t GetPendingCount() const
+    {
+        return this->pending_.size();
+    }
+
+private:
+    struct Pending
+    {
+        PropagationNode *node;
+        std::function<void()> deliver;
+    };
+
+    std::map<PropagationKey, Pending> pending_;
+    size_t sequence_;
+    size_t depth_;
+    bool isFlushing_;
+};
+
+
+inline void PropagationNode::Schedule(std::function<void()> deliver)
+{
+    assert(activePropagation);
+    activePropagation->Schedule(*this, std::move(deliver));
+}
+
+
+inline void PropagationNode::Cancel()
+{
+    // A node destroyed before its delivery has no observers left to notify.
+    if (this->key_)
+    {
+        assert(activePropagation);
+        activePropagation->Cancel(*this);
+    }
+}
+
+
+} // end namespace detail
+
+
+} // end namespace pex
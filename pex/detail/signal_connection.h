@@ -34,18 +34,7 @@ public:
 
     void operator()()
     {
-        if constexpr(Base::IsMemberFunction)
-        {
-            static_assert(
-                !std::is_same_v<Observer, void>,
-                "Cannot call member function on void type.");
-
-            (this->observer_->*(this->callable_))();
-        }
-        else
-        {
-            this->callable_(this->observer_);
-        }
+        this->Call_();
     }
 };
 
@@ -0,0 +1,382 @@
+/**
+  * @file small_vector.h
+  *
+  * @brief A vector that stores its first few elements in place, and only
+  * allocates when it outgrows them.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+/**
+ ** Most pex nodes have only a few observers. SmallVector keeps up to
+ ** inlineCount elements inside the object, so building a large model tree
+ ** does not require an allocation per node, and iteration over the elements
+ ** does not leave the node's own memory.
+ **
+ ** Only the subset of the std::vector interface needed by pex is provided.
+ ** Like std::vector, iterators are invalidated by any operation that changes
+ ** the size.
+ **/
+template<typename T, size_t inlineCount>
+class SmallVector
+{
+    static_assert(inlineCount > 0, "Use std::vector for no inline storage.");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    SmallVector()
+        :
+        data_(this->GetInline_()),
+        size_(0),
+        capacity_(inlineCount)
+    {
+
+    }
+
+    ~SmallVector()
+    {
+        this->clear();
+        this->Release_();
+    }
+
+    SmallVector(const SmallVector &other)
+        :
+        SmallVector()
+    {
+        this->CopyFrom_(other);
+    }
+
+    SmallVector(SmallVector &&other) noexcept
+        :
+        SmallVector()
+    {
+        this->MoveFrom_(other);
+    }
+
+    SmallVector & operator=(const SmallVector &other)
+    {
+        if (&other != this)
+        {
+            this->clear();
+            this->CopyFrom_(other);
+        }
+
+        return *this;
+    }
+
+    SmallVector & operator=(SmallVector &&other) noexcept
+    {
+        if (&other != this)
+        {
+            this->clear();
+            this->Release_();
+            this->MoveFrom_(other);
+        }
+
+        return *this;
+    }
+
+    template<typename ...Args>
+    T & emplace_back(Args &&...args)
+    {
+        if (this->size_ == this->capacity_)
+        {
+            return this->GrowAndEmplace_(std::forward<Args>(args)...);
+        }
+
+        T *result = ::new (static_cast<void *>(this->data_ + this->size_))
+            T(std::forward<Args>(args)...);
+
+        ++this->size_;
+
+        return *result;
+    }
+
+    void push_back(const T &value)
+    {
+        this->emplace_back(value);
+    }
+
+    void push_back(T &&value)
+    {
+        this->emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        assert(this->size_ > 0);
+        --this->size_;
+        std::destroy_at(this->data_ + this->size_);
+    }
+
+    /** Remove [first, last), preserving the order of the elements after. **/
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto begin = this->begin();
+        auto target = begin + (first - begin);
+        auto source = begin + (last - begin);
+        auto end = this->end();
+
+        if (target == source)
+        {
+            return target;
+        }
+
+        auto newEnd = std::move(source, end, target);
+        std::destroy(newEnd, end);
+        this->size_ -= static_cast<size_t>(end - newEnd);
+
+        return target;
+    }
+
+    iterator erase(const_iterator position)
+    {
+        return this->erase(position, position + 1);
+    }
+
+    void clear()
+    {
+        std::destroy(this->begin(), this->end());
+        this->size_ = 0;
+    }
+
+    void reserve(size_t count)
+    {
+        if (count > this->capacity_)
+        {
+            this->Grow_(count);
+        }
+    }
+
+    size_t size() const
+    {
+        return this->size_;
+    }
+
+    size_t capacity() const
+    {
+        return this->capacity_;
+    }
+
+    bool empty() const
+    {
+        return this->size_ == 0;
+    }
+
+    /** True while the elements fit in the inline storage. **/
+    bool IsInline() const
+    {
+        return this->data_ == this->GetInline_();
+    }
+
+    T & operator[](size_t index)
+    {
+        assert(index < this->size_);
+        return this->data_[index];
+    }
+
+    const T & operator[](size_t index) const
+    {
+        assert(index < this->size_);
+        return this->data_[index];
+    }
+
+    T & back()
+    {
+        assert(this->size_ > 0);
+        return this->data_[this->size_ - 1];
+    }
+
+    const T & back() const
+    {
+        assert(this->size_ > 0);
+        return this->data_[this->size_ - 1];
+    }
+
+    T * data() { return this->data_; }
+    const T * data() const { return this->data_; }
+
+    iterator begin() { return this->data_; }
+    iterator end() { return this->data_ + this->size_; }
+    const_iterator begin() const { return this->data_; }
+    const_iterator end() const { return this->data_ + this->size_; }
+    const_iterator cbegin() const { return this->data_; }
+    const_iterator cend() const { return this->data_ + this->size_; }
+
+private:
+    T * GetInline_()
+    {
+        return reinterpret_cast<T *>(this->inline_);
+    }
+
+    const T * GetInline_() const
+    {
+        return reinterpret_cast<const T *>(this->inline_);
+    }
+
+    void Grow_(size_t capacity)
+    {
+        assert(capacity > this->size_);
+
+        T *grown = std::allocator<T>().allocate(capacity);
+
+        try
+        {
+            this->Relocate_(grown);
+        }
+        catch (...)
+        {
+            std::allocator<T>().deallocate(grown, capacity);
+            throw;
+        }
+
+        this->Adopt_(grown, capacity);
+    }
+
+    // The arguments may refer to an element of this vector, so the new
+    // element is constructed before the old elements are moved.
+    template<typename ...Args>
+    T & GrowAndEmplace_(Args &&...args)
+    {
+        size_t capacity = this->capacity_ * 2;
+        T *grown = std::allocator<T>().allocate(capacity);
+        T *result;
+
+        try
+        {
+            result = ::new (static_cast<void *>(grown + this->size_))
+                T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::allocator<T>().deallocate(grown, capacity);
+            throw;
+        }
+
+        try
+        {
+            this->Relocate_(grown);
+        }
+        catch (...)
+        {
+            std::destroy_at(result);
+            std::allocator<T>().deallocate(grown, capacity);
+            throw;
+        }
+
+        this->Adopt_(grown, capacity);
+        ++this->size_;
+
+        return *result;
+    }
+
+    // Moves the elements to grown, or copies them when moving could throw.
+    void Relocate_(T *grown)
+    {
+        if constexpr (std::is_nothrow_move_constructible_v<T>)
+        {
+            std::uninitialized_move(this->begin(), this->end(), grown);
+        }
+        else
+        {
+            std::uninitialized_copy(this->begin(), this->end(), grown);
+        }
+    }
+
+    // Destroys the old elements, and takes grown as the storage.
+    void Adopt_(T *grown, size_t capacity)
+    {
+        auto size = this->size_;
+        this->clear();
+        this->Release_();
+
+        this->data_ = grown;
+        this->size_ = size;
+        this->capacity_ = capacity;
+    }
+
+    // Returns heap storage, if any, and resets to the empty inline buffer.
+    // The elements must already have been destroyed.
+    void Release_()
+    {
+        assert(this->size_ == 0);
+
+        if (!this->IsInline())
+        {
+            std::allocator<T>().deallocate(this->data_, this->capacity_);
+            this->data_ = this->GetInline_();
+            this->capacity_ = inlineCount;
+        }
+    }
+
+    void CopyFrom_(const SmallVector &other)
+    {
+        assert(this->empty());
+        this->reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), this->data_);
+        this->size_ = other.size_;
+    }
+
+    void MoveFrom_(SmallVector &other)
+    {
+        assert(this->empty());
+        assert(this->IsInline());
+
+        if (!other.IsInline())
+        {
+            // Take the other's heap storage without touching the elements.
+            this->data_ = other.data_;
+            this->size_ = other.size_;
+            this->capacity_ = other.capacity_;
+
+            other.data_ = other.GetInline_();
+            other.size_ = 0;
+            other.capacity_ = inlineCount;
+
+            return;
+        }
+
+        std::uninitialized_move(other.begin(), other.end(), this->data_);
+        this->size_ = other.size_;
+        other.clear();
+    }
+
+    alignas(T) std::byte inline_[sizeof(T) * inlineCount];
+    T *data_;
+    size_t size_;
+    size_t capacity_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace pex
@@ -0,0 +1,215 @@
+#include "pex/detail/trace.h"
+
+#include <algorithm>
+#include <mutex>
+#include <fmt/core.h>
+#include <jive/path.h>
+#include "pex/detail/log.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+// The mutex is only taken when a thread records its first event, and when
+// the trace is collected or reset.
+struct TraceBuffers
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    size_t threadCount = 0;
+};
+
+
+TraceBuffers & GetTraceBuffers()
+{
+    // Threads may record during static destruction, so the buffers are
+    // never destroyed.
+    static auto traceBuffers = new TraceBuffers();
+
+    return *traceBuffers;
+}
+
+
+std::shared_ptr<TraceBuffer> RegisterTraceBuffer()
+{
+    auto &traceBuffers = GetTraceBuffers();
+    std::lock_guard lock(traceBuffers.mutex);
+
+    auto buffer = std::make_shared<TraceBuffer>(traceBuffers.threadCount++);
+    traceBuffers.buffers.push_back(buffer);
+
+    return buffer;
+}
+
+
+void TraceBuffer::Collect(std::vector<TraceRecord> &records) const
+{
+    auto head = this->head_.load(std::memory_order_acquire);
+    auto start = this->start_.load(std::memory_order_relaxed);
+
+    if (head - start > traceCapacity)
+    {
+        start = head - traceCapacity;
+    }
+
+    for (auto index = start; index < head; ++index)
+    {
+        auto &slot = this->slots_[index % traceCapacity];
+        auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (sequence != 2 * index + 2)
+        {
+            // The writer has already begun to replace this event.
+            continue;
+        }
+
+        // Acquiring each field keeps the second read of the sequence after
+        // them.
+        TraceRecord record{
+            std::chrono::nanoseconds(
+                static_cast<int64_t>(
+                    slot.time.load(std::memory_order_acquire))),
+            this->thread_,
+            static_cast<TraceKind>(slot.kind.load(std::memory_order_acquire)),
+            slot.site.load(std::memory_order_acquire),
+            slot.address.load(std::memory_order_acquire),
+            slot.payload.load(std::memory_order_acquire)};
+
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            continue;
+        }
+
+        records.push_back(record);
+    }
+}
+
+
+const char * GetTraceKindName(TraceKind kind)
+{
+    switch (kind)
+    {
+        case TraceKind::log:
+            return "log";
+
+        case TraceKind::notify:
+            return "notify";
+
+        case TraceKind::callback:
+            return "callback";
+
+        default:
+            return "unknown";
+    }
+}
+
+
+} // end namespace detail
+
+
+std::vector<TraceRecord> CollectTrace()
+{
+    std::vector<TraceRecord> records;
+
+    auto &traceBuffers = detail::GetTraceBuffers();
+
+    {
+        std::lock_guard lock(traceBuffers.mutex);
+
+        for (auto &buffer: traceBuffers.buffers)
+        {
+            buffer->Collect(records);
+        }
+    }
+
+    std::stable_sort(
+        std::begin(records),
+        std::end(records),
+        [](const TraceRecord &first, const TraceRecord &second)
+        {
+            return first.time < second.time;
+        });
+
+    return records;
+}
+
+
+void ReportTrace(std::ostream &output, const std::vector<TraceRecord> &trace)
+{
+    if (trace.empty())
+    {
+        return;
+    }
+
+    auto begin = trace.front().time;
+
+    for (auto &record: trace)
+    {
+        std::string location;
+
+        if (record.site)
+        {
+            location = fmt::format(
+                "{}:{}:{}",
+                jive::path::Base(record.site->file),
+                record.site->function,
+                record.site->line);
+        }
+
+        output << fmt::format(
+            "{:>12} ns  thread {:>3}  {:<8}  {}  {}",
+            (record.time - begin).count(),
+            record.thread,
+            detail::GetTraceKindName(record.kind),
+            location,
+            LookupPexName(record.address));
+
+        if (record.kind == TraceKind::log)
+        {
+            output << fmt::format("  {}", record.payload);
+        }
+
+        output << '\n';
+    }
+
+    output.flush();
+}
+
+
+void ReportTrace(std::ostream &output)
+{
+    ReportTrace(output, CollectTrace());
+}
+
+
+void ResetTrace()
+{
+    auto &traceBuffers = detail::GetTraceBuffers();
+    std::lock_guard lock(traceBuffers.mutex);
+
+    auto &buffers = traceBuffers.buffers;
+
+    // A buffer that is only held here belongs to a thread that has exited.
+    buffers.erase(
+        std::remove_if(
+            std::begin(buffers),
+            std::end(buffers),
+            [](const std::shared_ptr<detail::TraceBuffer> &buffer)
+            {
+                return buffer.use_count() == 1;
+            }),
+        std::end(buffers));
+
+    for (auto &buffer: buffers)
+    {
+        buffer->Discard();
+    }
+}
+
+
+} // end namespace pex
@@ -0,0 +1,211 @@
+/**
+  * @file trace.h
+  *
+  * @brief Records trace events for pex/trace.h.
+  *
+  * Nothing is recorded unless ENABLE_PEX_TRACE is defined.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <type_traits>
+#include "pex/trace.h"
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+/** A ring of events written by one thread.
+ **
+ ** Each slot is guarded by a sequence number, so a reader on another thread
+ ** can copy the slots without stopping the writer, and skip any slot that
+ ** changed while it was read.
+ **/
+class TraceBuffer
+{
+public:
+    TraceBuffer(size_t thread)
+        :
+        thread_(thread),
+        head_(0),
+        start_(0),
+        slots_()
+    {
+
+    }
+
+    void Record(
+        TraceKind kind,
+        const TraceSite *site,
+        const void *address,
+        uint64_t payload)
+    {
+        auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+
+        // Only the owning thread writes head_.
+        auto index = this->head_.load(std::memory_order_relaxed);
+        auto &slot = this->slots_[index % traceCapacity];
+
+        // An odd sequence marks the slot as being written. Each field is
+        // stored with release, so a reader that sees a new field also sees
+        // the odd sequence.
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+
+        slot.time.store(
+            static_cast<uint64_t>(time.count()),
+            std::memory_order_release);
+
+        slot.kind.store(static_cast<uint32_t>(kind), std::memory_order_release);
+        slot.site.store(site, std::memory_order_release);
+        slot.address.store(address, std::memory_order_release);
+        slot.payload.store(payload, std::memory_order_release);
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        this->head_.store(index + 1, std::memory_order_release);
+    }
+
+    // Append the retained events to records.
+    void Collect(std::vector<TraceRecord> &records) const;
+
+    // Later calls to Collect ignore the events recorded so far.
+    void Discard()
+    {
+        this->start_.store(
+            this->head_.load(std::memory_order_acquire),
+            std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> time{0};
+        std::atomic<uint32_t> kind{0};
+        std::atomic<const TraceSite *> site{nullptr};
+        std::atomic<const void *> address{nullptr};
+        std::atomic<uint64_t> payload{0};
+    };
+
+    size_t thread_;
+    std::atomic<uint64_t> head_;
+    std::atomic<uint64_t> start_;
+    std::array<Slot, traceCapacity> slots_;
+};
+
+
+// Creates a buffer for the calling thread, and keeps it for CollectTrace.
+std::shared_ptr<TraceBuffer> RegisterTraceBuffer();
+
+
+inline TraceBuffer & GetTraceBuffer()
+{
+    thread_local std::shared_ptr<TraceBuffer> buffer = RegisterTraceBuffer();
+
+    return *buffer;
+}
+
+
+inline void RecordTrace(
+    TraceKind kind,
+    const TraceSite *site,
+    const void *address,
+    uint64_t payload)
+{
+    GetTraceBuffer().Record(kind, site, address, payload);
+}
+
+
+template<typename T>
+inline constexpr bool isTraceAddress =
+    std::is_pointer_v<T>
+    && std::is_object_v<std::remove_pointer_t<T>>
+    && !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>;
+
+
+// Records the first pointer and the first integer argument of a log
+// statement. Other arguments, including strings, are not recorded.
+template<typename ...Args>
+void TraceLog(const TraceSite *site, const Args &...args)
+{
+    const void *address = nullptr;
+    uint64_t payload = 0;
+    bool hasAddress = false;
+    bool hasPayload = false;
+
+    auto capture = [&](const auto &argument)
+    {
+        using Argument = std::decay_t<decltype(argument)>;
+
+        if constexpr (isTraceAddress<Argument>)
+        {
+            if (!hasAddress)
+            {
+                address = argument;
+                hasAddress = true;
+            }
+        }
+        else if constexpr (std::is_integral_v<Argument>)
+        {
+            if (!hasPayload)
+            {
+                payload = static_cast<uint64_t>(argument);
+                hasPayload = true;
+            }
+        }
+    };
+
+    (capture(args), ...);
+
+    RecordTrace(TraceKind::log, site, address, payload);
+}
+
+
+} // end namespace detail
+
+
+} // end namespace pex
+
+
+#ifdef ENABLE_PEX_TRACE
+
+#define PEX_TRACE_SITE_ \
+    static constexpr ::pex::TraceSite pexTraceSite_{ \
+        __FILE__, \
+        __FUNCTION__, \
+        __LINE__}
+
+#define PEX_TRACE(kind, address) \
+    do \
+    { \
+        PEX_TRACE_SITE_; \
+        ::pex::detail::RecordTrace(kind, &pexTraceSite_, address, 0); \
+    } while (false)
+
+#define PEX_TRACE_LOG(...) \
+    do \
+    { \
+        PEX_TRACE_SITE_; \
+        ::pex::detail::TraceLog(&pexTraceSite_, __VA_ARGS__); \
+    } while (false)
+
+#else
+
+#define PEX_TRACE(kind, address)
+#define PEX_TRACE_LOG(...)
+
+#endif // ENABLE_PEX_TRACE
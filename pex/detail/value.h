@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <concepts>
 #include <type_traits>
 
 
@@ -30,6 +31,13 @@ struct DefinesType<T, std::void_t<typename T::Type>>
     : std::true_type {};
 
 
+template<typename T>
+concept HasEqualTo = requires (const T &left, const T &right)
+{
+    { left == right } -> std::convertible_to<bool>;
+};
+
+
 } // namespace detail
 
 } // namespace pex
@@ -35,18 +35,7 @@ public:
 
     void operator()(Argument<T> value)
     {
-        if constexpr (Base::IsMemberFunction)
-        {
-            static_assert(
-                !std::is_same_v<Observer, void>,
-                "Cannot call member function on void type.");
-
-            (this->observer_->*(this->callable_))(value);
-        }
-        else
-        {
-            this->callable_(this->observer_, value);
-        }
+        this->Call_(value);
     }
 };
 
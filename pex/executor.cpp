@@ -0,0 +1,150 @@
+#include "pex/executor.h"
+
+#include <cassert>
+#include <iterator>
+
+
+namespace pex
+{
+
+
+Executor::~Executor() = default;
+
+
+QueueExecutor::QueueExecutor()
+    :
+    mutex_(),
+    tasks_()
+{
+
+}
+
+
+void QueueExecutor::Post(Task task)
+{
+    std::lock_guard lock(this->mutex_);
+    this->tasks_.push_back(std::move(task));
+}
+
+
+size_t QueueExecutor::Pump()
+{
+    std::deque<Task> tasks;
+
+    {
+        std::lock_guard lock(this->mutex_);
+        std::swap(tasks, this->tasks_);
+    }
+
+    size_t runCount = 0;
+
+    try
+    {
+        for (auto &task: tasks)
+        {
+            ++runCount;
+            task();
+        }
+    }
+    catch (...)
+    {
+        // Keep the tasks that have not run, ahead of those posted since.
+        std::lock_guard lock(this->mutex_);
+        auto unrun = std::next(tasks.begin(), static_cast<ptrdiff_t>(runCount));
+
+        this->tasks_.insert(
+            this->tasks_.begin(),
+            std::make_move_iterator(unrun),
+            std::make_move_iterator(tasks.end()));
+
+        throw;
+    }
+
+    return tasks.size();
+}
+
+
+size_t QueueExecutor::GetPendingCount() const
+{
+    std::lock_guard lock(this->mutex_);
+
+    return this->tasks_.size();
+}
+
+
+ThreadPoolExecutor::ThreadPoolExecutor(size_t threadCount)
+    :
+    mutex_(),
+    hasTask_(),
+    tasks_(),
+    isStopping_(false),
+    threads_()
+{
+    assert(threadCount > 0);
+
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        this->threads_.emplace_back(&ThreadPoolExecutor::Run_, this);
+    }
+}
+
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        this->isStopping_ = true;
+    }
+
+    this->hasTask_.notify_all();
+
+    for (auto &thread: this->threads_)
+    {
+        thread.join();
+    }
+}
+
+
+void ThreadPoolExecutor::Post(Task task)
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        this->tasks_.push_back(std::move(task));
+    }
+
+    this->hasTask_.notify_one();
+}
+
+
+void ThreadPoolExecutor::Run_()
+{
+    while (true)
+    {
+        Task task;
+
+        {
+            std::unique_lock lock(this->mutex_);
+
+            this->hasTask_.wait(
+                lock,
+                [this]()
+                {
+                    return this->isStopping_ || !this->tasks_.empty();
+                });
+
+            if (this->tasks_.empty())
+            {
+                // isStopping_ is set, and the remaining work is done.
+                return;
+            }
+
+            task = std::move(this->tasks_.front());
+            this->tasks_.pop_front();
+        }
+
+        task();
+    }
+}
+
+
+} // end namespace pex
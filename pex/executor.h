@@ -0,0 +1,106 @@
+/**
+  * @file executor.h
+  *
+  * @brief Executors that run the callbacks of asynchronous connections.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace pex
+{
+
+
+class Executor
+{
+public:
+    using Task = std::function<void()>;
+
+    virtual ~Executor();
+
+    /** Schedule task to run. Must be safe to call from any thread. **/
+    virtual void Post(Task task) = 0;
+};
+
+
+/**
+ ** Holds tasks until the owner calls Pump, usually from its own event loop.
+ **/
+class QueueExecutor: public Executor
+{
+public:
+    QueueExecutor();
+
+    void Post(Task task) override;
+
+    /** Run the tasks posted so far, returning the number that were run.
+     **
+     ** Tasks posted while pumping are left for the next call. If a task
+     ** throws, the exception propagates, and the tasks that did not run are
+     ** left for the next call.
+     **/
+    size_t Pump();
+
+    size_t GetPendingCount() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<Task> tasks_;
+};
+
+
+/**
+ ** Runs tasks on a fixed number of worker threads.
+ **
+ ** Tasks that were posted before destruction are run before the threads are
+ ** joined.
+ **/
+class ThreadPoolExecutor: public Executor
+{
+public:
+    explicit ThreadPoolExecutor(size_t threadCount);
+
+    ~ThreadPoolExecutor();
+
+    ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+    ThreadPoolExecutor & operator=(const ThreadPoolExecutor &) = delete;
+
+    void Post(Task task) override;
+
+private:
+    void Run_();
+
+    std::mutex mutex_;
+    std::condition_variable hasTask_;
+    std::deque<Task> tasks_;
+    bool isStopping_;
+    std::vector<std::thread> threads_;
+};
+
+
+/** Runs tasks in order on one dedicated thread. **/
+class ThreadExecutor: public ThreadPoolExecutor
+{
+public:
+    ThreadExecutor()
+        :
+        ThreadPoolExecutor(1)
+    {
+
+    }
+};
+
+
+} // end namespace pex
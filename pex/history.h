@@ -0,0 +1,270 @@
+/**
+  * @file history.h
+  *
+  * @brief Undo and redo for a model, recorded from its notifications.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <deque>
+#include <stdexcept>
+#include <jive/scope_flag.h>
+#include "pex/endpoint.h"
+#include "pex/detail/mute.h"
+#include "pex/detail/history.h"
+
+
+namespace pex
+{
+
+
+/**
+ ** Observes a model, and records each change as the smallest edits that
+ ** reproduce it.
+ **
+ ** Each member of a group, and each list, is observed by its own recorder,
+ ** so a change is recorded from the notifications of the nodes it touched,
+ ** and the model is never compared as a whole. Changes to a group record
+ ** only the members that changed, changes to a list record the items that
+ ** were replaced, inserted, or erased, and changes to any other value record
+ ** the old and new values.
+ **
+ ** The edits recorded before a notification of the model form one change.
+ **
+ ** Undo and Redo replay one change while the model is muted, so observers of
+ ** a group or list receive one notification.
+ **
+ ** The oldest changes are forgotten when the recorded edits exceed the
+ ** memory budget.
+ **/
+template<typename Model>
+class History
+{
+public:
+    static constexpr size_t defaultMemoryBudget = 16 * 1024 * 1024;
+
+    using Control = typename PromoteControl<Model>::Type;
+    using Plain = typename Control::Type;
+
+    History(Model &model, size_t memoryBudget = defaultMemoryBudget)
+        :
+        model_(model),
+        pending_(),
+        recorder_(model, this->pending_),
+        undo_(),
+        redo_(),
+        memoryBudget_(memoryBudget),
+        memoryUsage_(0),
+        isReplaying_(false),
+        endpoint_(
+            PEX_THIS("pex::History"),
+            Control(model),
+            &History::OnModel_)
+    {
+        PEX_MEMBER(endpoint_);
+    }
+
+    History(const History &) = delete;
+    History & operator=(const History &) = delete;
+
+    ~History()
+    {
+        PEX_CLEAR_NAME(this);
+        PEX_CLEAR_NAME(&this->endpoint_);
+    }
+
+    bool CanUndo() const
+    {
+        return !this->undo_.empty();
+    }
+
+    bool CanRedo() const
+    {
+        return !this->redo_.empty();
+    }
+
+    size_t GetUndoCount() const
+    {
+        return this->undo_.size();
+    }
+
+    size_t GetRedoCount() const
+    {
+        return this->redo_.size();
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        return this->memoryUsage_;
+    }
+
+    size_t GetMemoryBudget() const
+    {
+        return this->memoryBudget_;
+    }
+
+    void SetMemoryBudget(size_t memoryBudget)
+    {
+        this->memoryBudget_ = memoryBudget;
+        this->Trim_();
+    }
+
+    void Undo()
+    {
+        if (this->undo_.empty())
+        {
+            throw std::logic_error("Nothing to undo");
+        }
+
+        auto change = std::move(this->undo_.back());
+        this->undo_.pop_back();
+
+        this->Replay_(
+            [&change]()
+            {
+                for (auto edit = change.edits.rbegin();
+                     edit != change.edits.rend();
+                     ++edit)
+                {
+                    (*edit)->Undo();
+                }
+            });
+
+        this->redo_.push_back(std::move(change));
+    }
+
+    void Redo()
+    {
+        if (this->redo_.empty())
+        {
+            throw std::logic_error("Nothing to redo");
+        }
+
+        auto change = std::move(this->redo_.back());
+        this->redo_.pop_back();
+
+        this->Replay_(
+            [&change]()
+            {
+                for (auto &edit: change.edits)
+                {
+                    edit->Redo();
+                }
+            });
+
+        this->undo_.push_back(std::move(change));
+    }
+
+    void Clear()
+    {
+        this->undo_.clear();
+        this->redo_.clear();
+        this->memoryUsage_ = 0;
+    }
+
+private:
+    struct Change
+    {
+        detail::HistoryEdits edits;
+        size_t size;
+    };
+
+    void OnModel_(Argument<Plain>)
+    {
+        if (this->isReplaying_)
+        {
+            return;
+        }
+
+        if (this->pending_.empty())
+        {
+            return;
+        }
+
+        Change change{std::move(this->pending_), 0};
+        this->pending_.clear();
+
+        for (auto &edit: change.edits)
+        {
+            change.size += edit->GetSize();
+        }
+
+        // A new change cannot be followed by the changes that were undone.
+        for (auto &undone: this->redo_)
+        {
+            this->memoryUsage_ -= undone.size;
+        }
+
+        this->redo_.clear();
+
+        this->memoryUsage_ += change.size;
+        this->undo_.push_back(std::move(change));
+        this->Trim_();
+    }
+
+    template<typename Apply>
+    void Replay_(Apply &&apply)
+    {
+        {
+            jive::ScopeFlag isReplaying(this->isReplaying_);
+
+            if constexpr (IsGroupModel<Model> || IsListModel<Model>)
+            {
+                detail::ScopeMute<Model> scopeMute(this->model_, false);
+                apply();
+            }
+            else
+            {
+                apply();
+            }
+        }
+
+        // The recorders kept up with the replayed edits, which are already
+        // in the history.
+        this->pending_.clear();
+    }
+
+    void Trim_()
+    {
+        // Keep the latest change, even when it alone exceeds the budget.
+        while (this->memoryUsage_ > this->memoryBudget_)
+        {
+            if (this->undo_.size() > 1)
+            {
+                this->memoryUsage_ -= this->undo_.front().size;
+                this->undo_.pop_front();
+            }
+            else if (!this->redo_.empty())
+            {
+                this->memoryUsage_ -= this->redo_.front().size;
+                this->redo_.pop_front();
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    Model &model_;
+    detail::HistoryEdits pending_;
+
+    // Connects to the model before endpoint_, so each change is recorded
+    // before the model notifies.
+    detail::HistoryRecorder<Model> recorder_;
+
+    std::deque<Change> undo_;
+    std::deque<Change> redo_;
+    size_t memoryBudget_;
+    size_t memoryUsage_;
+    bool isReplaying_;
+    Endpoint<History, Control> endpoint_;
+};
+
+
+} // end namespace pex
@@ -1,6 +1,8 @@
 #pragma once
 
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <jive/scope_flag.h>
@@ -10,6 +12,9 @@
 #include "pex/signal.h"
 #include "pex/detail/mute.h"
 #include "pex/detail/log.h"
+#include "pex/detail/generation.h"
+#include "pex/detail/item_pool.h"
+#include "pex/snapshot.h"
 #include "pex/reference.h"
 #include "pex/selectors.h"
 #include "pex/terminus.h"
@@ -74,13 +79,35 @@ template<typename T>
 concept HasBaseSignals = HasGetBaseWillDelete<T> && HasGetBaseCreated<T>;
 
 
+/** A run of adjacent items, announced once by the range operations. **/
+struct ListRange
+{
+    size_t first;
+    size_t count;
+
+    size_t GetEnd() const
+    {
+        return this->first + this->count;
+    }
+
+    bool operator==(const ListRange &) const = default;
+};
+
+
 namespace model
 {
 
 
-using ListFlag = Value<bool>;
-using ListCount = Value<size_t>;
-using ListOptionalIndex = Value<std::optional<size_t>>;
+// The count, selection, and member signals change the structure of the list,
+// and controls of the list follow them as they arrive, so they are never
+// deferred by a Propagation.
+template<typename T>
+using ListSignalValue = Value_<T, NoFilter, GetAndSetTag, ImmediateTag>;
+
+using ListFlag = ListSignalValue<bool>;
+using ListCount = ListSignalValue<size_t>;
+using ListOptionalIndex = ListSignalValue<std::optional<size_t>>;
+using ListOptionalRange = ListSignalValue<std::optional<ListRange>>;
 
 
 } // namespace model
@@ -113,6 +140,7 @@ namespace control
 using ListFlag = Value<::pex::model::ListFlag>;
 using ListCount = Value<::pex::model::ListCount>;
 using ListOptionalIndex = Value<::pex::model::ListOptionalIndex>;
+using ListOptionalRange = Value<::pex::model::ListOptionalRange>;
 
 
 } // end namespace control
@@ -125,6 +153,7 @@ namespace mux
 using ListFlag = ::pex::control::Mux<::pex::model::ListFlag>;
 using ListCount = ::pex::control::Mux<::pex::model::ListCount>;
 using ListOptionalIndex = ::pex::control::Mux<::pex::model::ListOptionalIndex>;
+using ListOptionalRange = ::pex::control::Mux<::pex::model::ListOptionalRange>;
 
 
 } // end namespace mux
@@ -140,6 +169,9 @@ using ListCount = ::pex::control::Value<::pex::mux::ListCount>;
 using ListOptionalIndex =
     ::pex::control::Value<::pex::mux::ListOptionalIndex>;
 
+using ListOptionalRange =
+    ::pex::control::Value<::pex::mux::ListOptionalRange>;
+
 
 } // end namespace mux
 
@@ -282,6 +314,7 @@ struct List
         using ListItem = Selector<Member>;
         using Count = ::pex::control::ListCount;
         using ListOptionalIndex = ::pex::control::ListOptionalIndex;
+        using ListOptionalRange = ::pex::control::ListOptionalRange;
         using ListFlag = ::pex::control::ListFlag;
     };
 
@@ -314,6 +347,9 @@ struct List
         using MemberRemoved = ::pex::model::ListOptionalIndex;
         using MemberWillReplace = ::pex::model::ListOptionalIndex;
         using MemberReplaced = ::pex::model::ListOptionalIndex;
+        using MembersAdded = ::pex::model::ListOptionalRange;
+        using MembersWillRemove = ::pex::model::ListOptionalRange;
+        using MembersRemoved = ::pex::model::ListOptionalRange;
         using ListFlag = ::pex::model::ListFlag;
         using Access = GetAndSetTag;
 
@@ -337,10 +373,17 @@ struct List
         Count count;
         Selected selected;
         MemberAdded memberAdded;
+
+        // Notified for items removed one at a time. Truncating the list, by
+        // count or by Set, and EraseRange notify only membersWillRemove and
+        // membersRemoved. Use ListObserver to receive them per item.
         MemberWillRemove memberWillRemove;
         MemberRemoved memberRemoved;
         MemberWillReplace memberWillReplace;
         MemberReplaced memberReplaced;
+        MembersAdded membersAdded;
+        MembersWillRemove membersWillRemove;
+        MembersRemoved membersRemoved;
         ListFlag isNotifying;
 
         Model()
@@ -355,8 +398,20 @@ struct List
             memberRemoved(),
             memberWillReplace(),
             memberReplaced(),
+            membersAdded(),
+            membersWillRemove(),
+            membersRemoved(),
             isNotifying(),
+            generation_(),
+            structureGeneration_(),
+            itemPool_(),
             items_(),
+            borrows_(),
+            snapshotMutex_(),
+            snapshotValues_(),
+            snapshotGeneration_(0),
+            snapshotListGeneration_(0),
+            snapshotItemGenerations_(),
 
             countTerminus_(
                 PEX_THIS(
@@ -376,6 +431,8 @@ struct List
             selectionReceived_(false),
             internalMemberAdded_(),
             internalMemberReplaced_(),
+            internalMembersAdded_(),
+            internalMembersWillRemove_(),
             baseWillDeleteEndpoints_(),
             baseCreatedEndpoints_()
         {
@@ -389,13 +446,19 @@ struct List
             PEX_MEMBER(memberRemoved);
             PEX_MEMBER(memberWillReplace);
             PEX_MEMBER(memberReplaced);
+            PEX_MEMBER(membersAdded);
+            PEX_MEMBER(membersWillRemove);
+            PEX_MEMBER(membersRemoved);
             PEX_MEMBER(isNotifying);
 
+            this->structureGeneration_.SetParent(&this->generation_);
+
             size_t toInitialize = initialCount;
+            this->itemPool_.Reserve(toInitialize);
 
             while (toInitialize--)
             {
-                this->items_.push_back(std::make_unique<ListItem>());
+                this->items_.push_back(this->MakeItem_());
             }
 
             REGISTER_ITEM_NAMES(this, this->items_);
@@ -403,6 +466,8 @@ struct List
             PEX_MEMBER(internalMemberAdded_);
             PEX_MEMBER(internalMemberWillReplace_);
             PEX_MEMBER(internalMemberReplaced_);
+            PEX_MEMBER(internalMembersAdded_);
+            PEX_MEMBER(internalMembersWillRemove_);
             PEX_MEMBER(baseWillDeleteEndpoints_);
             PEX_MEMBER(baseCreatedEndpoints_);
 
@@ -424,12 +489,17 @@ struct List
             PEX_CLEAR_NAME(&memberRemoved);
             PEX_CLEAR_NAME(&memberWillReplace);
             PEX_CLEAR_NAME(&memberReplaced);
+            PEX_CLEAR_NAME(&membersAdded);
+            PEX_CLEAR_NAME(&membersWillRemove);
+            PEX_CLEAR_NAME(&membersRemoved);
             PEX_CLEAR_NAME(&isNotifying);
             CLEAR_ITEM_NAMES(this->items_);
             PEX_CLEAR_NAME(&internalMemberWillRemove_);
             PEX_CLEAR_NAME(&internalMemberAdded_);
             PEX_CLEAR_NAME(&internalMemberWillReplace_);
             PEX_CLEAR_NAME(&internalMemberReplaced_);
+            PEX_CLEAR_NAME(&internalMembersAdded_);
+            PEX_CLEAR_NAME(&internalMembersWillRemove_);
             PEX_CLEAR_NAME(&baseWillDeleteEndpoints_);
             PEX_CLEAR_NAME(&baseCreatedEndpoints_);
         }
@@ -489,8 +559,128 @@ struct List
         }
 
         Type Get() const
+        {
+            if constexpr (detail::ReportsChanges<ListItem>)
+            {
+                std::lock_guard lock(this->snapshotMutex_);
+
+                if (this->IsSnapshotCurrent_())
+                {
+                    // One contiguous copy, without visiting the items.
+                    return *this->snapshotValues_;
+                }
+            }
+
+            return this->GetItems_();
+        }
+
+        /** Get the values of the items as a shared, immutable snapshot.
+         **
+         ** The last snapshot is kept, and is returned again without visiting
+         ** the items while the generation of the list is unchanged. When only
+         ** some items have changed, only those items are read again.
+         **
+         ** Items that do not report every change to the list, like groups
+         ** with a poly member, are read again each time.
+         **/
+        Snapshot<Type> GetSnapshot() const
+        {
+            if constexpr (detail::ReportsChanges<ListItem>)
+            {
+                std::lock_guard lock(this->snapshotMutex_);
+                this->UpdateSnapshot_();
+
+                return Snapshot<Type>(
+                    typename Snapshot<Type>::Pointer(this->snapshotValues_));
+            }
+            else
+            {
+                return Snapshot<Type>(this->GetItems_());
+            }
+        }
+
+        /** Borrow the values of the items, without copying them.
+         **
+         ** In debug builds, removing or setting an item while the ListView
+         ** exists throws std::logic_error.
+         **/
+        ListView<Model> View() const requires detail::HasGetRef<ListItem>
+        {
+            return ListView<Model>(*this, this->borrows_);
+        }
+
+        size_t size() const
+        {
+            return this->items_.size();
+        }
+
+        bool empty() const
+        {
+            return this->items_.empty();
+        }
+
+        /** Advanced by every change to the items, or to the number of
+         ** items.
+         **
+         ** Changes within an item are only counted if the item has a
+         ** generation of its own. Items advance the generation of the list as
+         ** they change, so this does not visit them.
+         **/
+        uint64_t GetGeneration() const
+        {
+            return this->generation_.Get();
+        }
+
+        /** Also advance parent with every change, for a container that holds
+         ** this list.
+         **/
+        void SetGenerationParent(detail::Generation *parent)
+        {
+            this->generation_.SetParent(parent);
+        }
+
+        /** The list can only report the changes its items report. **/
+        static constexpr bool MembersReportChanges()
+        {
+            return detail::ReportsChanges<ListItem>;
+        }
+
+        /** Also refuse changes while parent is borrowed, for a container
+         ** that holds this list.
+         **/
+        void SetBorrowsParent(const detail::Borrows *parent)
+        {
+            this->borrows_.SetParent(parent);
+        }
+
+    private:
+        auto MakeItem_()
+        {
+            static_assert(
+                !detail::HasGetGeneration<ListItem>
+                    || detail::HasGenerationParent<ListItem>,
+                "Items with a generation must report it to the list.");
+
+            auto item = this->itemPool_.Make();
+
+            if constexpr (detail::HasGenerationParent<ListItem>)
+            {
+                item->SetGenerationParent(&this->generation_);
+            }
+
+            // An item cannot be set while the list is viewed.
+            if constexpr (detail::HasBorrowsParent<ListItem>)
+            {
+                item->SetBorrowsParent(&this->borrows_);
+            }
+
+            return item;
+        }
+
+        Type GetItems_() const
         {
             Type result;
+            result.reserve(this->items_.size());
 
             for (auto &item: this->items_)
             {
@@ -505,16 +695,77 @@ struct List
             return result;
         }
 
-        size_t size() const
+        bool IsSnapshotCurrent_() const
         {
-            return this->items_.size();
+            return this->snapshotValues_
+                && this->generation_.Get() == this->snapshotGeneration_;
         }
 
-        bool empty() const
+        void UpdateSnapshot_() const
         {
-            return this->items_.empty();
+            if (this->IsSnapshotCurrent_())
+            {
+                return;
+            }
+
+            // Read before the items, so a change made while they are read is
+            // found by the next update.
+            this->snapshotGeneration_ = this->generation_.Get();
+
+            uint64_t listGeneration = this->structureGeneration_.Get();
+            size_t itemCount = this->items_.size();
+
+            if (
+                !this->snapshotValues_
+                || listGeneration != this->snapshotListGeneration_)
+            {
+                // Items were added or removed since the last snapshot.
+                auto values = std::make_shared<Type>();
+                values->reserve(itemCount);
+                this->snapshotItemGenerations_.resize(itemCount);
+
+                for (size_t index = 0; index < itemCount; ++index)
+                {
+                    auto &item = *this->items_[index];
+                    this->snapshotItemGenerations_[index] = item.GetGeneration();
+                    values->push_back(item.Get());
+                }
+
+                this->snapshotValues_ = values;
+                this->snapshotListGeneration_ = listGeneration;
+
+                return;
+            }
+
+            assert(this->snapshotValues_->size() == itemCount);
+
+            // A snapshot that has been handed out must not change.
+            bool isShared = this->snapshotValues_.use_count() > 1;
+
+            for (size_t index = 0; index < itemCount; ++index)
+            {
+                auto &item = *this->items_[index];
+                auto itemGeneration = item.GetGeneration();
+
+                if (itemGeneration == this->snapshotItemGenerations_[index])
+                {
+                    continue;
+                }
+
+                if (isShared)
+                {
+                    this->snapshotValues_ =
+                        std::make_shared<Type>(*this->snapshotValues_);
+
+                    isShared = false;
+                }
+
+                (*this->snapshotValues_)[index] = item.Get();
+                this->snapshotItemGenerations_[index] = itemGeneration;
+            }
         }
 
+    public:
         // Initialize values without sending notifications.
         void SetInitial(const Type &values)
         {
@@ -561,7 +812,8 @@ struct List
 
                 this->selected.Set({});
 
-                this->items_.push_back(std::make_unique<ListItem>());
+                this->items_.push_back(this->MakeItem_());
+                this->structureGeneration_.Bump();
 
                 if constexpr (HasGetVirtual<ListItem>)
                 {
@@ -627,7 +879,9 @@ struct List
 
                 this->items_.insert(
                     this->items_.begin() + index,
-                    std::make_unique<ListItem>());
+                    this->MakeItem_());
+
+                this->structureGeneration_.Bump();
 
                 if constexpr (HasGetVirtual<ListItem>)
                 {
@@ -692,6 +946,161 @@ struct List
             this->RestoreBaseEndpoints_(index);
         }
 
+        /** Append all of items, and return the index of the first.
+         **
+         ** See InsertRange.
+         **/
+        template<typename Items>
+        size_t AppendRange(const Items &items)
+        {
+            size_t first = this->items_.size();
+            this->InsertRange(first, items);
+
+            return first;
+        }
+
+        /** Insert all of items before index.
+         **
+         ** The items are added to storage at once, and membersAdded is
+         ** notified once with the range of new indices. memberAdded is not
+         ** notified for the items added by a range; ListObserver reports
+         ** them per item.
+         **/
+        template<typename Items>
+        void InsertRange(size_t index, const Items &items)
+        {
+            assert(index <= this->items_.size());
+
+            size_t insertCount = std::size(items);
+
+            if (insertCount == 0)
+            {
+                return;
+            }
+
+            auto scopedFlag = ScopedListFlag(this->isNotifying);
+
+            // Mute while setting item values.
+            auto scopeMute = detail::ScopeMute<Model>(*this, false);
+
+            auto wasSelected = this->selected.Get();
+            ListRange range{index, insertCount};
+
+            // count observers will be notified at the end of this scope.
+            {
+                jive::ScopeFlag ignoreCount(this->ignoreCount_);
+
+                auto deferCount = pex::MakeDefer(this->count);
+                deferCount.Set(this->items_.size() + insertCount);
+
+                if (wasSelected)
+                {
+                    this->selected.Set({});
+                }
+
+                this->ClearInvalidatedEndpoints_(index);
+
+                // Create and set the new items before they are observed.
+                std::vector<ItemPointer> created;
+                created.reserve(insertCount);
+                this->itemPool_.Reserve(insertCount);
+
+                for (auto &item: items)
+                {
+                    created.push_back(this->MakeItem_());
+                    created.back()->Set(item);
+                }
+
+                this->items_.insert(
+                    this->items_.begin() + static_cast<ptrdiff_t>(index),
+                    std::make_move_iterator(created.begin()),
+                    std::make_move_iterator(created.end()));
+
+                this->structureGeneration_.Bump(insertCount);
+
+#ifdef ENABLE_PEX_NAMES
+                for (size_t i = index; i < range.GetEnd(); ++i)
+                {
+                    if constexpr (HasGetVirtual<ListItem>)
+                    {
+                        PEX_MEMBER_ADDRESS(
+                            this->items_[i]->GetVirtual(),
+                            fmt::format("item {}", i));
+                    }
+                    else
+                    {
+                        PEX_MEMBER_ADDRESS(
+                            this->items_[i].get(),
+                            fmt::format("item {}", i));
+                    }
+                }
+#endif
+
+                this->RestoreBaseEndpoints_(index);
+                this->selectionReceived_ = false;
+                this->internalMembersAdded_.Set(range);
+                this->membersAdded.Set(range);
+            }
+
+            if (wasSelected && !this->selectionReceived_)
+            {
+                // Nothing changed the selection in response to membersAdded.
+                if (*wasSelected < index)
+                {
+                    this->selected.Set(wasSelected);
+                }
+                else
+                {
+                    this->selected.Set(*wasSelected + insertCount);
+                }
+            }
+        }
+
+        /** Erase the items from first up to, but not including, last.
+         **
+         ** The items are removed from storage at once, and membersWillRemove
+         ** and membersRemoved are notified once with the erased range.
+         ** memberWillRemove and memberRemoved are not notified for the items
+         ** erased by a range; ListObserver reports them per item.
+         **/
+        void EraseRange(size_t first, size_t last)
+        {
+            assert(first <= last);
+            assert(last <= this->items_.size());
+
+            if (first == last)
+            {
+                return;
+            }
+
+            auto scopedFlag = ScopedListFlag(this->isNotifying);
+
+            auto wasSelected = this->selected.Get();
+
+            if (wasSelected && *wasSelected >= first)
+            {
+                this->selected.Set({});
+            }
+
+            ListRange range{first, last - first};
+
+            {
+                jive::ScopeFlag ignoreCount(this->ignoreCount_);
+                auto deferCount = MakeDefer(this->count);
+                deferCount.Set(this->items_.size() - range.count);
+
+                this->ClearInvalidatedEndpoints_(first);
+                this->RemoveRange_(range);
+                this->RestoreBaseEndpoints_(first);
+            }
+
+            if (wasSelected && *wasSelected >= last)
+            {
+                // The selected item was after the erased range.
+                this->selected.Set(*wasSelected - range.count);
+            }
+        }
+
         // TODO: Make this protected?
         void ResizeWithoutNotify(size_t newSize)
         {
@@ -714,10 +1123,12 @@ struct List
                 size_t toInitialize = newSize - this->items_.size();
                 size_t firstToRestore = this->items_.size();
                 this->selectionReceived_ = false;
+                this->itemPool_.Reserve(toInitialize);
 
                 while (toInitialize--)
                 {
-                    this->items_.push_back(std::make_unique<ListItem>());
+                    this->items_.push_back(this->MakeItem_());
+                    this->structureGeneration_.Bump();
 
                     size_t currentSize = this->items_.size();
 
@@ -778,6 +1189,10 @@ struct List
     private:
         void Remove_(size_t index)
         {
+            // Removal destroys an item, and every ListView of this list
+            // would be left with a dangling reference.
+            this->borrows_.RequireNone();
+
             this->memberWillRemove.Set(index);
 
             // Allow the internal controls to respond to memberWillRemove after
@@ -786,6 +1201,8 @@ struct List
 
             assert(this->baseCreatedEndpoints_.size() <= index);
 
+            this->structureGeneration_.Bump();
+
             jive::SafeErase(this->items_, index);
 
             detail::AccessReference(this->count)
@@ -794,6 +1211,30 @@ struct List
             this->memberRemoved.Set(index);
         }
 
+        void RemoveRange_(const ListRange &range)
+        {
+            this->borrows_.RequireNone();
+
+            this->membersWillRemove.Set(range);
+            this->internalMembersWillRemove_.Set(range);
+
+            assert(this->baseCreatedEndpoints_.size() <= range.first);
+
+            auto first = this->items_.begin()
+                + static_cast<ptrdiff_t>(range.first);
+
+            auto last = first + static_cast<ptrdiff_t>(range.count);
+
+            this->structureGeneration_.Bump(range.count);
+
+            this->items_.erase(first, last);
+
+            detail::AccessReference(this->count)
+                .SetWithoutNotify(this->items_.size());
+
+            this->membersRemoved.Set(range);
+        }
+
         void SetWithoutNotify_(const Type &values)
         {
             // Mute while setting item values.
@@ -837,12 +1278,14 @@ struct List
 
                     // Create and set the new items.
                     size_t toInitialize = valueCount - this->items_.size();
+                    this->itemPool_.Reserve(toInitialize);
 
                     while (toInitialize--)
                     {
                         // Create, set, and notify member added for each new
                         // item.
-                        this->items_.push_back(std::make_unique<ListItem>());
+                        this->items_.push_back(this->MakeItem_());
+                        this->structureGeneration_.Bump();
 
                         size_t currentSize = this->items_.size();
 
@@ -907,12 +1350,10 @@ struct List
 
             // This is a reduction in size.
             // No new elements need to be created.
-            for (size_t i = this->items_.size(); i > count_; --i)
-            {
-                // Call Erase with each removed index.
-                // Calls memberWillRemove/memberRemoved for each item.
-                this->Remove_(i - 1);
-            }
+            // The tail is released at once, and observers receive one
+            // membersWillRemove/membersRemoved pair for the whole range.
+            this->RemoveRange_(
+                ListRange{count_, this->items_.size() - count_});
         }
 
         void OnCount_(size_t count_)
@@ -950,10 +1391,12 @@ struct List
                 size_t firstToRestore = this->items_.size();
 
                 this->selectionReceived_ = false;
+                this->itemPool_.Reserve(toInitialize);
 
                 while (toInitialize--)
                 {
-                    this->items_.push_back(std::make_unique<ListItem>());
+                    this->items_.push_back(this->MakeItem_());
+                    this->structureGeneration_.Bump();
 
                     size_t currentSize = this->items_.size();
 
@@ -1054,8 +1497,9 @@ struct List
         {
             if constexpr (HasBaseSignals<ListItem>)
             {
-                assert(this->baseWillDeleteEndpoints_.size() > firstToClear);
-                assert(this->baseCreatedEndpoints_.size() > firstToClear);
+                // Inserting at the end of the list invalidates no endpoints.
+                assert(this->baseWillDeleteEndpoints_.size() >= firstToClear);
+                assert(this->baseCreatedEndpoints_.size() >= firstToClear);
 
                 this->baseWillDeleteEndpoints_.resize(firstToClear);
                 this->baseCreatedEndpoints_.resize(firstToClear);
@@ -1067,7 +1511,31 @@ struct List
         using BaseActionTerminus =
             ::pex::Terminus<void, ::pex::control::DefaultSignal>;
 
-        std::vector<std::unique_ptr<ListItem>> items_;
+        using ItemPool = detail::ItemPool<ListItem>;
+        using ItemPointer = typename ItemPool::Pointer;
+
+        // Advanced by the items, through their generation parent, and by
+        // structureGeneration_. Declared before the items, so it outlives
+        // them.
+        detail::Generation generation_;
+
+        // Advanced when items are added or removed.
+        detail::Generation structureGeneration_;
+
+        // The pool is declared before items_, so it outlives them.
+        ItemPool itemPool_;
+        std::vector<ItemPointer> items_;
+
+        [[no_unique_address]]
+        detail::Borrows borrows_;
+
+        // The values returned by GetSnapshot, and the generations of the list
+        // and of each item when they were read.
+        mutable std::mutex snapshotMutex_;
+        mutable std::shared_ptr<Type> snapshotValues_;
+        mutable uint64_t snapshotGeneration_;
+        mutable uint64_t snapshotListGeneration_;
+        mutable std::vector<uint64_t> snapshotItemGenerations_;
 
         using CountTerminus =
             ::pex::Terminus<Model, typename ControlTypes::Count>;
@@ -1083,6 +1551,8 @@ struct List
         MemberAdded internalMemberAdded_;
         MemberWillReplace internalMemberWillReplace_;
         MemberReplaced internalMemberReplaced_;
+        MembersAdded internalMembersAdded_;
+        MembersWillRemove internalMembersWillRemove_;
 
         TerminusVector<BaseActionTerminus> baseWillDeleteEndpoints_;
         TerminusVector<BaseActionTerminus> baseCreatedEndpoints_;
@@ -1106,6 +1576,7 @@ struct List
         using ListItem = typename Types::ListItem;
         using Count = typename Types::Count;
         using ListOptionalIndex = typename Types::ListOptionalIndex;
+        using ListOptionalRange = typename Types::ListOptionalRange;
 
         template<typename T>
         using Selector = typename Types::template Selector<T>;
@@ -1116,6 +1587,9 @@ struct List
         using MemberRemoved = ListOptionalIndex;
         using MemberWillReplace = ListOptionalIndex;
         using MemberReplaced = ListOptionalIndex;
+        using MembersAdded = ListOptionalRange;
+        using MembersWillRemove = ListOptionalRange;
+        using MembersRemoved = ListOptionalRange;
         using ListFlag = typename Types::ListFlag;
 
         using MemberWillRemoveTerminus =
@@ -1146,6 +1620,20 @@ struct List
                 detail::PromoteCopyable<MemberReplaced>
             >;
 
+        using MembersWillRemoveTerminus =
+            ::pex::Terminus
+            <
+                Control_,
+                detail::PromoteCopyable<MembersWillRemove>
+            >;
+
+        using MembersAddedTerminus =
+            ::pex::Terminus
+            <
+                Control_,
+                detail::PromoteCopyable<MembersAdded>
+            >;
+
         using Vector = std::vector<ListItem>;
         using Iterator = typename Vector::iterator;
         using ConstIterator = typename Vector::const_iterator;
@@ -1175,6 +1663,9 @@ struct List
         MemberRemoved memberRemoved;
         MemberWillReplace memberWillReplace;
         MemberReplaced memberReplaced;
+        MembersAdded membersAdded;
+        MembersWillRemove membersWillRemove;
+        MembersRemoved membersRemoved;
         ListFlag isNotifying;
 
         Control_()
@@ -1187,13 +1678,18 @@ struct List
             memberRemoved(),
             memberWillReplace(),
             memberReplaced(),
+            membersAdded(),
+            membersWillRemove(),
+            membersRemoved(),
             isNotifying(),
             upstream_(nullptr),
             items_(),
             memberWillRemoveTerminus_(),
             memberAddedTerminus_(),
             memberWillReplaceTerminus_(),
-            memberReplacedTerminus_()
+            memberReplacedTerminus_(),
+            membersWillRemoveTerminus_(),
+            membersAddedTerminus_()
         {
             PEX_NAME(
                 fmt::format(
@@ -1211,6 +1707,9 @@ struct List
             memberRemoved(upstream.memberRemoved),
             memberWillReplace(upstream.memberWillReplace),
             memberReplaced(upstream.memberReplaced),
+            membersAdded(upstream.membersAdded),
+            membersWillRemove(upstream.membersWillRemove),
+            membersRemoved(upstream.membersRemoved),
             isNotifying(upstream.isNotifying),
             upstream_(&upstream),
             items_(),
@@ -1238,7 +1737,17 @@ struct List
             memberReplacedTerminus_(
                 this,
                 MemberReplaced(this->upstream_->internalMemberReplaced_),
-                &Control_::OnMemberReplaced_)
+                &Control_::OnMemberReplaced_),
+
+            membersWillRemoveTerminus_(
+                this,
+                MembersWillRemove(this->upstream_->internalMembersWillRemove_),
+                &Control_::OnMembersWillRemove_),
+
+            membersAddedTerminus_(
+                this,
+                MembersAdded(this->upstream_->internalMembersAdded_),
+                &Control_::OnMembersAdded_)
         {
             assert(this->upstream_ != nullptr);
 
@@ -1258,6 +1767,9 @@ struct List
             memberRemoved(other.memberRemoved),
             memberWillReplace(other.memberWillReplace),
             memberReplaced(other.memberReplaced),
+            membersAdded(other.membersAdded),
+            membersWillRemove(other.membersWillRemove),
+            membersRemoved(other.membersRemoved),
             isNotifying(other.isNotifying),
             upstream_(other.upstream_),
             items_(other.items_),
@@ -1285,7 +1797,17 @@ struct List
             memberReplacedTerminus_(
                 this,
                 MemberReplaced(this->upstream_->internalMemberReplaced_),
-                &Control_::OnMemberReplaced_)
+                &Control_::OnMemberReplaced_),
+
+            membersWillRemoveTerminus_(
+                this,
+                MembersWillRemove(this->upstream_->internalMembersWillRemove_),
+                &Control_::OnMembersWillRemove_),
+
+            membersAddedTerminus_(
+                this,
+                MembersAdded(this->upstream_->internalMembersAdded_),
+                &Control_::OnMembersAdded_)
         {
             assert(other.upstream_ != nullptr);
             assert(this->memberAddedTerminus_.HasModel());
@@ -1314,6 +1836,9 @@ struct List
             this->memberRemoved = other.memberRemoved;
             this->memberWillReplace = other.memberWillReplace;
             this->memberReplaced = other.memberReplaced;
+            this->membersAdded = other.membersAdded;
+            this->membersWillRemove = other.membersWillRemove;
+            this->membersRemoved = other.membersRemoved;
             this->isNotifying = other.isNotifying;
             this->upstream_ = other.upstream_;
 
@@ -1345,6 +1870,14 @@ struct List
                 this,
                 other.memberReplacedTerminus_);
 
+            this->membersWillRemoveTerminus_.RequireAssign(
+                this,
+                other.membersWillRemoveTerminus_);
+
+            this->membersAddedTerminus_.RequireAssign(
+                this,
+                other.membersAddedTerminus_);
+
             if (this->HasModel())
             {
                 assert(this->memberWillRemoveTerminus_.HasModel());
@@ -1448,6 +1981,16 @@ struct List
             return this->upstream_->Get();
         }
 
+        auto View() const requires detail::HasView<Upstream>
+        {
+            return this->upstream_->View();
+        }
+
+        Snapshot<Type> GetSnapshot() const
+        {
+            return this->upstream_->GetSnapshot();
+        }
+
         void Set(const Type &values)
         {
             this->upstream_->Set(values);
@@ -1490,6 +2033,21 @@ struct List
                 return false;
             }
 
+            if (!this->membersAdded.HasModel())
+            {
+                return false;
+            }
+
+            if (!this->membersWillRemove.HasModel())
+            {
+                return false;
+            }
+
+            if (!this->membersRemoved.HasModel())
+            {
+                return false;
+            }
+
             if (!this->isNotifying.HasModel())
             {
                 return false;
@@ -1520,6 +2078,30 @@ struct List
             return this->upstream_->Append(item);
         }
 
+        template<typename Items>
+        std::optional<size_t> AppendRange(const Items &items)
+        {
+            if (!this->upstream_)
+            {
+                return {};
+            }
+
+            return this->upstream_->AppendRange(items);
+        }
+
+        template<typename Items>
+        void InsertRange(size_t index, const Items &items)
+        {
+            assert(this->upstream_);
+            this->upstream_->InsertRange(index, items);
+        }
+
+        void EraseRange(size_t first, size_t last)
+        {
+            assert(this->upstream_);
+            this->upstream_->EraseRange(first, last);
+        }
+
         void Notify()
         {
 #ifndef NDEBUG
@@ -1531,6 +2113,17 @@ struct List
             this->upstream_->Notify();
         }
 
+        uint64_t GetGeneration() const
+        {
+#ifndef NDEBUG
+            if (!this->upstream_)
+            {
+                throw std::logic_error("List::Control is uninitialized");
+            }
+#endif
+            return this->upstream_->GetGeneration();
+        }
+
     private:
         void SetWithoutNotify_(const Type &values)
         {
@@ -1602,6 +2195,62 @@ struct List
             this->items_.at(*index) = ListItem((*this->upstream_)[*index]);
         }
 
+        void OnMembersWillRemove_(const std::optional<ListRange> &range)
+        {
+            if (!range)
+            {
+                return;
+            }
+
+            auto first =
+                this->items_.begin() + static_cast<ptrdiff_t>(range->first);
+
+            this->items_.erase(
+                first,
+                first + static_cast<ptrdiff_t>(range->count));
+        }
+
+        void OnMembersAdded_(const std::optional<ListRange> &range)
+        {
+            if (!range)
+            {
+                return;
+            }
+
+            Vector added;
+            added.reserve(range->count);
+
+            for (size_t index = range->first; index < range->GetEnd(); ++index)
+            {
+                added.emplace_back((*this->upstream_)[index]);
+            }
+
+            this->items_.insert(
+                this->items_.begin() + static_cast<ptrdiff_t>(range->first),
+                std::make_move_iterator(added.begin()),
+                std::make_move_iterator(added.end()));
+
+#ifdef ENABLE_PEX_NAMES
+            for (size_t index = range->first; index < range->GetEnd(); ++index)
+            {
+                if constexpr (HasGetVirtual<ListItem>)
+                {
+                    pex::PexName(
+                        this->items_.at(index).GetVirtual(),
+                        this,
+                        fmt::format("item {}", index));
+                }
+                else
+                {
+                    pex::PexName(
+                        &this->items_.at(index),
+                        this,
+                        fmt::format("item {}", index));
+                }
+            }
+#endif
+        }
+
     protected:
         Upstream *upstream_;
         Vector items_;
@@ -1611,6 +2260,8 @@ struct List
         MemberAddedTerminus memberAddedTerminus_;
         MemberWillReplaceTerminus memberWillReplaceTerminus_;
         MemberReplacedTerminus memberReplacedTerminus_;
+        MembersWillRemoveTerminus membersWillRemoveTerminus_;
+        MembersAddedTerminus membersAddedTerminus_;
     };
 
 
@@ -1647,6 +2298,7 @@ struct List
         using Type = std::vector<Item>;
         using Count = ::pex::mux::ListCount;
         using ListOptionalIndex = ::pex::mux::ListOptionalIndex;
+        using ListOptionalRange = ::pex::mux::ListOptionalRange;
 
 
         using Selected = ListOptionalIndex;
@@ -1655,11 +2307,17 @@ struct List
         using MemberRemoved = ListOptionalIndex;
         using MemberWillReplace = ListOptionalIndex;
         using MemberReplaced = ListOptionalIndex;
+        using MembersAdded = ListOptionalRange;
+        using MembersWillRemove = ListOptionalRange;
+        using MembersRemoved = ListOptionalRange;
         using ListFlag = ::pex::mux::ListFlag;
 
         using CopyableOptionalIndex =
             detail::PromoteCopyable<ListOptionalIndex>;
 
+        using CopyableOptionalRange =
+            detail::PromoteCopyable<ListOptionalRange>;
+
         using MemberWillRemoveTerminus =
             ::pex::Terminus
             <
@@ -1688,6 +2346,13 @@ struct List
                 CopyableOptionalIndex
             >;
 
+        using MembersRangeTerminus =
+            ::pex::Terminus
+            <
+                Mux,
+                CopyableOptionalRange
+            >;
+
         using Access = GetAndSetTag;
 
         using Defer = DeferList<Member, Selector, Mux>;
@@ -1709,6 +2374,9 @@ struct List
         MemberRemoved memberRemoved;
         MemberWillReplace memberWillReplace;
         MemberReplaced memberReplaced;
+        MembersAdded membersAdded;
+        MembersWillRemove membersWillRemove;
+        MembersRemoved membersRemoved;
         ListFlag isNotifying;
 
         Mux()
@@ -1721,6 +2389,9 @@ struct List
             memberRemoved(),
             memberWillReplace(),
             memberReplaced(),
+            membersAdded(),
+            membersWillRemove(),
+            membersRemoved(),
             isNotifying(),
             items_(),
 
@@ -1728,11 +2399,15 @@ struct List
             internalMemberAdded_(),
             internalMemberWillReplace_(),
             internalMemberReplaced_(),
+            internalMembersAdded_(),
+            internalMembersWillRemove_(),
 
             memberWillRemoveTerminus_(),
             memberAddedTerminus_(),
             memberWillReplaceTerminus_(),
-            memberReplacedTerminus_()
+            memberReplacedTerminus_(),
+            membersWillRemoveTerminus_(),
+            membersAddedTerminus_()
         {
             PEX_NAME(
                 fmt::format(
@@ -1744,12 +2419,17 @@ struct List
             PEX_MEMBER(memberRemoved);
             PEX_MEMBER(memberWillReplace);
             PEX_MEMBER(memberReplaced);
+            PEX_MEMBER(membersAdded);
+            PEX_MEMBER(membersWillRemove);
+            PEX_MEMBER(membersRemoved);
             PEX_MEMBER(isNotifying);
 
             PEX_MEMBER(internalMemberWillRemove_);
             PEX_MEMBER(internalMemberAdded_);
             PEX_MEMBER(internalMemberWillReplace_);
             PEX_MEMBER(internalMemberReplaced_);
+            PEX_MEMBER(internalMembersAdded_);
+            PEX_MEMBER(internalMembersWillRemove_);
         }
 
         Mux(Upstream &upstream)
@@ -1762,6 +2442,9 @@ struct List
             memberRemoved(upstream.memberRemoved),
             memberWillReplace(upstream.memberWillReplace),
             memberReplaced(upstream.memberReplaced),
+            membersAdded(upstream.membersAdded),
+            membersWillRemove(upstream.membersWillRemove),
+            membersRemoved(upstream.membersRemoved),
             isNotifying(upstream.isNotifying),
             upstream_(&upstream),
             items_(),
@@ -1770,6 +2453,8 @@ struct List
             internalMemberAdded_(upstream.internalMemberAdded_),
             internalMemberWillReplace_(upstream.internalMemberWillReplace_),
             internalMemberReplaced_(upstream.internalMemberReplaced_),
+            internalMembersAdded_(upstream.internalMembersAdded_),
+            internalMembersWillRemove_(upstream.internalMembersWillRemove_),
 
             memberWillRemoveTerminus_(
 
@@ -1794,7 +2479,17 @@ struct List
             memberReplacedTerminus_(
                 this,
                 MemberReplaced(this->upstream_->internalMemberReplaced_),
-                &Mux::OnMemberReplaced_)
+                &Mux::OnMemberReplaced_),
+
+            membersWillRemoveTerminus_(
+                this,
+                MembersWillRemove(this->upstream_->internalMembersWillRemove_),
+                &Mux::OnMembersWillRemove_),
+
+            membersAddedTerminus_(
+                this,
+                MembersAdded(this->upstream_->internalMembersAdded_),
+                &Mux::OnMembersAdded_)
         {
             assert(this->upstream_ != nullptr);
 
@@ -1941,6 +2636,9 @@ struct List
             this->memberRemoved.ChangeUpstream(upstream.memberRemoved);
             this->memberWillReplace.ChangeUpstream(upstream.memberWillReplace);
             this->memberReplaced.ChangeUpstream(upstream.memberReplaced);
+            this->membersAdded.ChangeUpstream(upstream.membersAdded);
+            this->membersWillRemove.ChangeUpstream(upstream.membersWillRemove);
+            this->membersRemoved.ChangeUpstream(upstream.membersRemoved);
             this->isNotifying.ChangeUpstream(upstream.isNotifying);
 
             this->internalMemberWillRemove_.ChangeUpstream(
@@ -1955,6 +2653,12 @@ struct List
             this->internalMemberReplaced_.ChangeUpstream(
                 upstream.internalMemberReplaced_);
 
+            this->internalMembersAdded_.ChangeUpstream(
+                upstream.internalMembersAdded_);
+
+            this->internalMembersWillRemove_.ChangeUpstream(
+                upstream.internalMembersWillRemove_);
+
             this->memberWillRemoveTerminus_.Emplace(
                 this,
                 CopyableOptionalIndex(this->internalMemberWillRemove_),
@@ -1974,6 +2678,16 @@ struct List
                 this,
                 CopyableOptionalIndex(this->internalMemberReplaced_),
                 &Mux::OnMemberReplaced_);
+
+            this->membersWillRemoveTerminus_.Emplace(
+                this,
+                CopyableOptionalRange(this->internalMembersWillRemove_),
+                &Mux::OnMembersWillRemove_);
+
+            this->membersAddedTerminus_.Emplace(
+                this,
+                CopyableOptionalRange(this->internalMembersAdded_),
+                &Mux::OnMembersAdded_);
         }
 
         ~Mux()
@@ -1984,12 +2698,17 @@ struct List
             PEX_CLEAR_NAME(&memberRemoved);
             PEX_CLEAR_NAME(&memberWillReplace);
             PEX_CLEAR_NAME(&memberReplaced);
+            PEX_CLEAR_NAME(&membersAdded);
+            PEX_CLEAR_NAME(&membersWillRemove);
+            PEX_CLEAR_NAME(&membersRemoved);
             PEX_CLEAR_NAME(&isNotifying);
 
             PEX_CLEAR_NAME(&internalMemberWillRemove_);
             PEX_CLEAR_NAME(&internalMemberAdded_);
             PEX_CLEAR_NAME(&internalMemberWillReplace_);
             PEX_CLEAR_NAME(&internalMemberReplaced_);
+            PEX_CLEAR_NAME(&internalMembersAdded_);
+            PEX_CLEAR_NAME(&internalMembersWillRemove_);
 
             CLEAR_ITEM_NAMES(this->items_);
         }
@@ -2051,6 +2770,16 @@ struct List
             return this->upstream_->Get();
         }
 
+        auto View() const requires detail::HasView<Upstream>
+        {
+            return this->upstream_->View();
+        }
+
+        Snapshot<Type> GetSnapshot() const
+        {
+            return this->upstream_->GetSnapshot();
+        }
+
         void Set(const Type &values)
         {
             this->upstream_->Set(values);
@@ -2070,6 +2799,30 @@ struct List
             return this->upstream_->Append(item);
         }
 
+        template<typename Items>
+        std::optional<size_t> AppendRange(const Items &items)
+        {
+            if (!this->upstream_)
+            {
+                return {};
+            }
+
+            return this->upstream_->AppendRange(items);
+        }
+
+        template<typename Items>
+        void InsertRange(size_t index, const Items &items)
+        {
+            assert(this->upstream_);
+            this->upstream_->InsertRange(index, items);
+        }
+
+        void EraseRange(size_t first, size_t last)
+        {
+            assert(this->upstream_);
+            this->upstream_->EraseRange(first, last);
+        }
+
         bool HasModel() const
         {
             if (!this->upstream_)
@@ -2132,6 +2885,16 @@ struct List
                 return false;
             }
 
+            if (!this->internalMembersAdded_.HasModel())
+            {
+                return false;
+            }
+
+            if (!this->internalMembersWillRemove_.HasModel())
+            {
+                return false;
+            }
+
             for (auto &item: this->items_)
             {
                 if (!item->HasModel())
@@ -2156,6 +2919,17 @@ struct List
             this->upstream_->Notify();
         }
 
+        uint64_t GetGeneration() const
+        {
+#ifndef NDEBUG
+            if (!this->upstream_)
+            {
+                throw std::logic_error("List::Control is uninitialized");
+            }
+#endif
+            return this->upstream_->GetGeneration();
+        }
+
     private:
         void SetWithoutNotify_(const Type &values)
         {
@@ -2228,6 +3002,63 @@ struct List
                 std::make_unique<ListItem>((*this->upstream_)[*index]);
         }
 
+        void OnMembersWillRemove_(const std::optional<ListRange> &range)
+        {
+            if (!range)
+            {
+                return;
+            }
+
+            auto first =
+                this->items_.begin() + static_cast<ptrdiff_t>(range->first);
+
+            this->items_.erase(
+                first,
+                first + static_cast<ptrdiff_t>(range->count));
+        }
+
+        void OnMembersAdded_(const std::optional<ListRange> &range)
+        {
+            if (!range)
+            {
+                return;
+            }
+
+            std::vector<std::unique_ptr<ListItem>> added;
+            added.reserve(range->count);
+
+            for (size_t index = range->first; index < range->GetEnd(); ++index)
+            {
+                added.push_back(
+                    std::make_unique<ListItem>((*this->upstream_)[index]));
+            }
+
+            this->items_.insert(
+                this->items_.begin() + static_cast<ptrdiff_t>(range->first),
+                std::make_move_iterator(added.begin()),
+                std::make_move_iterator(added.end()));
+
+#ifdef ENABLE_PEX_NAMES
+            for (size_t index = range->first; index < range->GetEnd(); ++index)
+            {
+                if constexpr (HasGetVirtual<ListItem>)
+                {
+                    pex::PexName(
+                        this->items_.at(index)->GetVirtual(),
+                        this,
+                        fmt::format("item {}", index));
+                }
+                else
+                {
+                    pex::PexName(
+                        this->items_.at(index).get(),
+                        this,
+                        fmt::format("item {}", index));
+                }
+            }
+#endif
+        }
+
     private:
         Upstream *upstream_;
         std::vector<std::unique_ptr<ListItem>> items_;
@@ -2236,11 +3067,15 @@ struct List
         MemberAdded internalMemberAdded_;
         MemberWillReplace internalMemberWillReplace_;
         MemberReplaced internalMemberReplaced_;
+        MembersAdded internalMembersAdded_;
+        MembersWillRemove internalMembersWillRemove_;
 
         MemberWillRemoveTerminus memberWillRemoveTerminus_;
         MemberAddedTerminus memberAddedTerminus_;
         MemberWillReplaceTerminus memberWillReplaceTerminus_;
         MemberReplacedTerminus memberReplacedTerminus_;
+        MembersRangeTerminus membersWillRemoveTerminus_;
+        MembersRangeTerminus membersAddedTerminus_;
     };
 
 
@@ -2252,6 +3087,7 @@ struct List
         using ListItem = Selector<Member>;
         using Count = ::pex::follow::ListCount;
         using ListOptionalIndex = ::pex::follow::ListOptionalIndex;
+        using ListOptionalRange = ::pex::follow::ListOptionalRange;
         using ListFlag = ::pex::follow::ListFlag;
     };
 
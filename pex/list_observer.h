@@ -8,6 +8,20 @@ namespace pex
 {
 
 
+/**
+ ** Connects an observer to the per-item signals of a list.
+ **
+ ** Edits to a range of items, including truncation by count or by Set, are
+ ** reported by the list with one range signal, and the list does not
+ ** notify its own memberWillRemove or memberRemoved for them. ListObserver
+ ** reports them to the observer as per-item signals: memberAdded for each
+ ** added index in order, and memberWillRemove and memberRemoved for each
+ ** removed index, last first, as if the items had been removed one at a
+ ** time from the back.
+ **
+ ** The items still exist when memberWillRemove is reported, so every
+ ** memberWillRemove of a range is reported before its first memberRemoved.
+ **/
 template<typename Observer, typename Upstream_>
 class ListObserver
 {
@@ -44,13 +58,22 @@ public:
     using MemberReplacedCallable =
         typename MemberReplacedEndpoint::Callable;
 
+    using OptionalRange = typename ListControl::MembersAdded::Type;
+
     ListObserver()
         :
         memberAdded(),
         memberWillRemove(),
         memberRemoved(),
         memberWillReplace(),
-        memberReplaced()
+        memberReplaced(),
+        observer_(nullptr),
+        memberAddedCallable_(),
+        memberWillRemoveCallable_(),
+        memberRemovedCallable_(),
+        membersAdded_(),
+        membersWillRemove_(),
+        membersRemoved_()
     {
 
     }
@@ -87,7 +110,27 @@ public:
         memberReplaced(
             observer,
             listControl.memberReplaced,
-            memberReplacedCallable)
+            memberReplacedCallable),
+
+        observer_(observer),
+        memberAddedCallable_(memberAddedCallable),
+        memberWillRemoveCallable_(memberWillRemoveCallable),
+        memberRemovedCallable_(memberRemovedCallable),
+
+        membersAdded_(
+            this,
+            listControl.membersAdded,
+            &ListObserver::OnMembersAdded_),
+
+        membersWillRemove_(
+            this,
+            listControl.membersWillRemove,
+            &ListObserver::OnMembersWillRemove_),
+
+        membersRemoved_(
+            this,
+            listControl.membersRemoved,
+            &ListObserver::OnMembersRemoved_)
     {
 
     }
@@ -120,9 +163,18 @@ public:
         memberWillRemove(std::move(other.memberWillRemove)),
         memberRemoved(std::move(other.memberRemoved)),
         memberWillReplace(std::move(other.memberWillReplace)),
-        memberReplaced(std::move(other.memberReplaced))
+        memberReplaced(std::move(other.memberReplaced)),
+        observer_(other.observer_),
+        memberAddedCallable_(other.memberAddedCallable_),
+        memberWillRemoveCallable_(other.memberWillRemoveCallable_),
+        memberRemovedCallable_(other.memberRemovedCallable_),
+
+        // The range endpoints observe this ListObserver, not the observer.
+        membersAdded_(this, other.membersAdded_),
+        membersWillRemove_(this, other.membersWillRemove_),
+        membersRemoved_(this, other.membersRemoved_)
     {
-
+        other.DisconnectRanges_();
     }
 
     ListObserver & operator=(ListObserver &&other)
@@ -132,6 +184,8 @@ public:
         this->memberRemoved = std::move(other.memberRemoved);
         this->memberWillReplace = std::move(other.memberWillReplace);
         this->memberReplaced = std::move(other.memberReplaced);
+        this->AssignRanges_(other.observer_, other);
+        other.DisconnectRanges_();
 
         return *this;
     }
@@ -144,6 +198,7 @@ public:
         this->memberRemoved.Assign(observer, other.memberRemoved);
         this->memberWillReplace.Assign(observer, other.memberWillReplace);
         this->memberReplaced.Assign(observer, other.memberReplaced);
+        this->AssignRanges_(observer, other);
 
         return *this;
     }
@@ -153,6 +208,90 @@ public:
     MemberRemovedEndpoint memberRemoved;
     MemberWillReplaceEndpoint memberWillReplace;
     MemberReplacedEndpoint memberReplaced;
+
+private:
+    using IndexConnection =
+        typename MakeConnection
+        <
+            Observer,
+            typename ListControl::MemberAdded
+        >::Connection;
+
+    void AssignRanges_(Observer *observer, const ListObserver &other)
+    {
+        this->observer_ = observer;
+        this->memberAddedCallable_ = other.memberAddedCallable_;
+        this->memberWillRemoveCallable_ = other.memberWillRemoveCallable_;
+        this->memberRemovedCallable_ = other.memberRemovedCallable_;
+        this->membersAdded_.Assign(this, other.membersAdded_);
+        this->membersWillRemove_.Assign(this, other.membersWillRemove_);
+        this->membersRemoved_.Assign(this, other.membersRemoved_);
+    }
+
+    void DisconnectRanges_()
+    {
+        this->membersAdded_.Disconnect();
+        this->membersWillRemove_.Disconnect();
+        this->membersRemoved_.Disconnect();
+    }
+
+    void Call_(MemberAddedCallable callable, size_t index)
+    {
+        IndexConnection(this->observer_, callable)(index);
+    }
+
+    void OnMembersAdded_(const OptionalRange &range)
+    {
+        if (!range)
+        {
+            return;
+        }
+
+        for (size_t index = range->first; index < range->GetEnd(); ++index)
+        {
+            this->Call_(this->memberAddedCallable_, index);
+        }
+    }
+
+    void OnMembersWillRemove_(const OptionalRange &range)
+    {
+        if (!range)
+        {
+            return;
+        }
+
+        // Every item in the range still exists, so each index refers to the
+        // item that will be removed.
+        for (size_t index = range->GetEnd(); index-- > range->first;)
+        {
+            this->Call_(this->memberWillRemoveCallable_, index);
+        }
+    }
+
+    void OnMembersRemoved_(const OptionalRange &range)
+    {
+        if (!range)
+        {
+            return;
+        }
+
+        // The same indices as memberWillRemove, in the same order.
+        for (size_t index = range->GetEnd(); index-- > range->first;)
+        {
+            this->Call_(this->memberRemovedCallable_, index);
+        }
+    }
+
+    using RangeEndpoint =
+        Endpoint<ListObserver, typename ListControl::MembersAdded>;
+
+    Observer *observer_;
+    MemberAddedCallable memberAddedCallable_;
+    MemberWillRemoveCallable memberWillRemoveCallable_;
+    MemberRemovedCallable memberRemovedCallable_;
+    RangeEndpoint membersAdded_;
+    RangeEndpoint membersWillRemove_;
+    RangeEndpoint membersRemoved_;
 };
 
 
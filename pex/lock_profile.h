@@ -0,0 +1,66 @@
+/**
+  * @file lock_profile.h
+  *
+  * @brief Reports the lock wait and hold times recorded when pex is built
+  * with ENABLE_PEX_LOCK_PROFILE.
+  *
+  * Each READ_LOCK, WRITE_LOCK and MOVE_LOCK call site is measured
+  * separately. A report ranked by total wait time is written to std::cout
+  * at exit.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+// #define ENABLE_PEX_LOCK_PROFILE
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "pex/profile.h"
+
+
+namespace pex
+{
+
+
+struct LockProfile
+{
+    std::string fileName;
+    int line;
+
+    // ReadLock or WriteLock.
+    std::string lockName;
+
+    uint64_t acquireCount;
+
+    // Acquisitions that had to wait for another thread.
+    uint64_t contendedCount;
+
+    std::chrono::nanoseconds totalWait;
+    std::chrono::nanoseconds maxWait;
+    std::chrono::nanoseconds totalHold;
+    std::chrono::nanoseconds maxHold;
+
+    // Only contended acquisitions are counted in the wait histogram.
+    ProfileHistogram waitHistogram;
+    ProfileHistogram holdHistogram;
+};
+
+
+/** Call sites with the most total wait time, up to count. **/
+std::vector<LockProfile> GetLockProfiles(size_t count);
+
+/** Write a table of the count call sites with the most total wait time. **/
+void ReportLockProfile(std::ostream &output, size_t count = 10);
+
+void ResetLockProfile();
+
+
+} // end namespace pex
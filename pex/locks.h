@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cassert>
+#include <iostream>
 #include <optional>
 #include <ostream>
 #include <thread>
@@ -7,6 +9,7 @@
 
 #include <jive/path.h>
 #include "pex/log.h"
+#include "pex/detail/lock_profile.h"
 
 
 namespace pex
@@ -164,11 +167,77 @@ private:
 };
 
 
-#ifdef ENABLE_LOG_LOCKS
+/** Measures the wait and hold times of a lock for its call site.
+ **
+ ** An uncontended lock is acquired by try_lock, and is not timed until it
+ ** is held.
+ **/
+template<typename LockType>
+class ProfileLock
+{
+public:
+    using Lock = typename LockType::Lock;
+
+    ProfileLock(detail::LockSite &site, Mutex &mutex)
+        :
+        site_(site),
+        lock_(mutex, std::defer_lock),
+        lockedAt_()
+    {
+        this->lock();
+    }
+
+    ProfileLock(const ProfileLock &) = delete;
+
+    ~ProfileLock()
+    {
+        if (this->lock_.owns_lock())
+        {
+            this->unlock();
+        }
+    }
+
+    void lock()
+    {
+        if (this->lock_.try_lock())
+        {
+            this->lockedAt_ = detail::LockClock::now();
+            this->site_.RecordAcquire(std::chrono::nanoseconds(0), false);
+
+            return;
+        }
+
+        auto start = detail::LockClock::now();
+        this->lock_.lock();
+        this->lockedAt_ = detail::LockClock::now();
+
+        this->site_.RecordAcquire(this->lockedAt_ - start, true);
+    }
+
+    void unlock()
+    {
+        auto held = detail::LockClock::now() - this->lockedAt_;
+        this->lock_.unlock();
+        this->site_.RecordHold(held);
+    }
+
+private:
+    detail::LockSite &site_;
+    Lock lock_;
+    detail::LockClock::time_point lockedAt_;
+};
+
+
+#if defined(ENABLE_LOG_LOCKS)
 
 using WriteLock = LogLock<ExclusiveLock>;
 using ReadLock = LogLock<SharedLock>;
 
+#elif defined(ENABLE_PEX_LOCK_PROFILE)
+
+using WriteLock = ProfileLock<ExclusiveLock>;
+using ReadLock = ProfileLock<SharedLock>;
+
 #else
 
 using WriteLock = typename ExclusiveLock::Lock;
@@ -180,7 +249,7 @@ using ReadLock = typename SharedLock::Lock;
 } // end namespace pex
 
 
-#ifdef ENABLE_LOG_LOCKS
+#if defined(ENABLE_LOG_LOCKS)
 
 #define WRITE_LOCK(mutex) pex::WriteLock lock( \
     jive::path::Base(__FILE__), \
@@ -197,6 +266,32 @@ using ReadLock = typename SharedLock::Lock;
     __LINE__, \
     mutex)
 
+#elif defined(ENABLE_PEX_LOCK_PROFILE)
+
+// Each call site has its own static LockSite.
+#define PEX_LOCK_SITE_(LockType) \
+    []() -> pex::detail::LockSite & \
+    { \
+        static pex::detail::LockSite site( \
+            __FILE__, \
+            __LINE__, \
+            pex::LockType::name); \
+\
+        return site; \
+    }()
+
+#define WRITE_LOCK(mutex) pex::WriteLock lock( \
+    PEX_LOCK_SITE_(ExclusiveLock), \
+    mutex)
+
+#define READ_LOCK(mutex) pex::ReadLock lock( \
+    PEX_LOCK_SITE_(SharedLock), \
+    mutex)
+
+#define MOVE_LOCK(mutex) pex::WriteLock( \
+    PEX_LOCK_SITE_(ExclusiveLock), \
+    mutex)
+
 #else
 
 #define WRITE_LOCK(mutex) pex::WriteLock lock(mutex)
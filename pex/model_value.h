@@ -21,9 +21,13 @@
 #include "pex/detail/value_connection.h"
 #include "pex/detail/filters.h"
 #include "pex/detail/value.h"
+#include "pex/detail/generation.h"
+#include "pex/detail/element_changes.h"
 #include "pex/access_tag.h"
+#include "pex/notify_policy.h"
 #include "pex/transaction.h"
 #include "pex/detail/require_has_value.h"
+#include "pex/view.h"
 
 
 namespace pex
@@ -39,6 +43,12 @@ class ValueContainerReference;
 template<typename>
 class KeyValueContainerReference;
 
+template<typename>
+class DeferValueContainer;
+
+template<typename>
+class DeferKeyValueContainer;
+
 template<typename>
 class ConstReference;
 
@@ -62,12 +72,27 @@ namespace model
 // Model must use unbound callbacks so it can send notifications to
 // different observer types.
 // All observers are stored as void *.
-template<typename T, typename Filter_, typename Access_ = GetAndSetTag>
+//
+// NotifyPolicy_ selects how connections are synchronized. Use ConcurrentTag
+// when this model is set on one thread and observed from others. Controls
+// adopt the NotifyPolicy of their upstream.
+template
+<
+    typename T,
+    typename Filter_,
+    typename Access_ = GetAndSetTag,
+    typename NotifyPolicy_ = SingleThreadedTag
+>
 class Value_
     :
     //Callback values will be the type returned by the Filter, or T if
     // the filter is void.
-    public detail::NotifyMany<ValueConnection<void, T, Filter_>, Access_>
+    public detail::NotifyMany
+    <
+        ValueConnection<void, T, Filter_>,
+        Access_,
+        NotifyPolicy_
+    >
 {
     static_assert(!std::is_void_v<T>);
     static_assert(detail::FilterIsNoneOrValid<T, Filter_, SetTag>);
@@ -80,6 +105,7 @@ public:
 
     // All model nodes have writable access.
     using Access = Access_;
+    using NotifyPolicy = NotifyPolicy_;
 
     template<typename>
     friend class ::pex::Transaction;
@@ -105,7 +131,9 @@ public:
     Value_()
         :
         filter_{},
-        value_{this->FilterOnSet_(Type{})}
+        value_{this->FilterOnSet_(Type{})},
+        borrows_{},
+        generation_{}
     {
         PEX_LOG(this);
     }
@@ -113,7 +141,9 @@ public:
     explicit Value_(Type value)
         :
         filter_{},
-        value_{this->FilterOnSet_(value)}
+        value_{this->FilterOnSet_(std::move(value))},
+        borrows_{},
+        generation_{}
     {
         PEX_LOG(this);
     }
@@ -121,7 +151,9 @@ public:
     Value_(Type value, Filter filter)
         :
         filter_{filter},
-        value_{this->FilterOnSet_(value)}
+        value_{this->FilterOnSet_(std::move(value))},
+        borrows_{},
+        generation_{}
     {
         PEX_LOG(this);
     }
@@ -129,13 +161,15 @@ public:
     Value_(Filter filter)
         :
         filter_{filter},
-        value_{this->FilterOnSet_(Type{})}
+        value_{this->FilterOnSet_(Type{})},
+        borrows_{},
+        generation_{}
     {
         PEX_LOG(this);
     }
 
-    Value_(const Value_<Type, Filter> &) = delete;
-    Value_(Value_<Type, Filter> &&) = delete;
+    Value_(const Value_ &) = delete;
+    Value_(Value_ &&) = delete;
 
     ~Value_()
     {
@@ -149,11 +183,110 @@ public:
         this->Notify();
     }
 
+    /** Move the value into storage and notify interfaces **/
+    void Set(Type &&value)
+        requires (HasAccess<SetTag, Access> && MovableArgument<Type>)
+    {
+        this->SetWithoutNotify_(std::move(value));
+        this->Notify();
+    }
+
+    /** Set the value, and notify interfaces only if the filtered value
+     ** differs from the current value.
+     **
+     ** Types without operator== cannot be compared, so they always notify.
+     **
+     ** Returns true if interfaces were notified.
+     **/
+    bool SetIfChanged(Argument<Type> value)
+        requires (HasAccess<SetTag, Access>)
+    {
+        if constexpr (detail::HasEqualTo<Type>)
+        {
+            if constexpr (std::is_same_v<NoFilter, Filter>)
+            {
+                if (value == this->value_)
+                {
+                    return false;
+                }
+
+                this->borrows_.RequireNone();
+                this->value_ = value;
+                this->generation_.Bump();
+            }
+            else
+            {
+                auto filtered = this->FilterOnSet_(value);
+
+                if (filtered == this->value_)
+                {
+                    return false;
+                }
+
+                this->borrows_.RequireNone();
+                this->value_ = std::move(filtered);
+                this->generation_.Bump();
+            }
+        }
+        else
+        {
+            this->SetWithoutNotify_(value);
+        }
+
+        this->Notify();
+
+        return true;
+    }
+
     Type Get() const
     {
         return this->value_;
     }
 
+    /** The stored value, without a copy.
+     **
+     ** The reference is invalidated by the next Set.
+     **/
+    const Type & GetRef() const
+    {
+        return this->value_;
+    }
+
+    /** Borrow the stored value.
+     **
+     ** In debug builds, setting the value while the View exists throws
+     ** std::logic_error.
+     **/
+    pex::View<Type> View() const
+    {
+        return pex::View<Type>(this->value_, this->borrows_);
+    }
+
+    /** Advanced by every change to the stored value.
+     **
+     ** Safe to read from any thread.
+     **/
+    uint64_t GetGeneration() const
+    {
+        return this->generation_.Get();
+    }
+
+    /** Also advance parent with every change, for a container that holds
+     ** this model.
+     **/
+    void SetGenerationParent(detail::Generation *parent)
+    {
+        this->generation_.SetParent(parent);
+    }
+
+    /** Also refuse changes while parent is borrowed, for a container that
+     ** holds this model.
+     **/
+    void SetBorrowsParent(const detail::Borrows *parent)
+    {
+        this->borrows_.SetParent(parent);
+    }
+
     explicit operator Type () const
     {
         return this->value_;
@@ -166,6 +299,13 @@ public:
         return *this;
     }
 
+    Value_ & operator=(Type &&value)
+        requires (HasAccess<SetTag, Access> && MovableArgument<Type>)
+    {
+        this->Set(std::move(value));
+        return *this;
+    }
+
     void SetFilter(Filter filter)
     {
         this->filter_ = filter;
@@ -193,6 +333,8 @@ public:
 protected:
     void SetWithoutNotify_(Argument<Type> value)
     {
+        this->borrows_.RequireNone();
+
         if constexpr (std::is_same_v<NoFilter, Filter>)
         {
             this->value_ = value;
@@ -201,13 +343,43 @@ protected:
         {
             this->value_ = this->FilterOnSet_(value);
         }
+
+        this->generation_.Bump();
+    }
+
+    void SetWithoutNotify_(Type &&value) requires MovableArgument<Type>
+    {
+        this->borrows_.RequireNone();
+
+        if constexpr (std::is_same_v<NoFilter, Filter>)
+        {
+            this->value_ = std::move(value);
+        }
+        else
+        {
+            this->value_ = this->FilterOnSet_(std::move(value));
+        }
+
+        this->generation_.Bump();
     }
 
     Type FilterOnSet_(Argument<Type> value) const
+    {
+        return this->ApplySetFilter_(value);
+    }
+
+    Type FilterOnSet_(Type &&value) const requires MovableArgument<Type>
+    {
+        return this->ApplySetFilter_(std::move(value));
+    }
+
+    // Value is Argument<Type> or Type &&, which is moved into the filter.
+    template<typename Value>
+    Type ApplySetFilter_(Value &&value) const
     {
         if constexpr (std::is_same_v<NoFilter, Filter>)
         {
-            return value;
+            return std::forward<Value>(value);
         }
         else if constexpr (detail::SetterIsMember<Type, Filter>)
         {
@@ -218,11 +390,11 @@ protected:
                     return {};
                 }
 
-                return this->filter_.Set(*value);
+                return this->filter_.Set(*std::forward<Value>(value));
             }
             else
             {
-                return this->filter_.Set(value);
+                return this->filter_.Set(std::forward<Value>(value));
             }
         }
         else
@@ -236,11 +408,11 @@ protected:
                     return {};
                 }
 
-                return Filter::Set(*value);
+                return Filter::Set(*std::forward<Value>(value));
             }
             else
             {
-                return Filter::Set(value);
+                return Filter::Set(std::forward<Value>(value));
             }
         }
     }
@@ -289,6 +461,11 @@ protected:
 
     Filter filter_;
     Type value_;
+
+    [[no_unique_address]]
+    detail::Borrows borrows_;
+
+    detail::Generation generation_;
 };
 
 
@@ -311,6 +488,7 @@ public:
 
     ~Publisher()
     {
+        this->model_.generation_.Bump();
         this->model_.Notify();
     }
 
@@ -320,21 +498,29 @@ private:
 };
 
 
+/** A container with a second channel for element observers.
+ **
+ ** Set(index, value) sends element observers only the element that changed.
+ **/
 template<typename T>
-class ValueContainer: public Value_<T, NoFilter>
+class ValueContainer
+    :
+    public Value_<T, NoFilter>,
+    public detail::ElementNotifier<size_t, typename T::value_type>
 {
 public:
     static constexpr bool isValueContainer = true;
 
     using Base = Value_<T, NoFilter>;
+    using Elements = detail::ElementNotifier<size_t, typename T::value_type>;
 
     using Base::Base;
-    using Base::Set;
     using Base::Get;
 
     using Type = typename Base::Type;
     using ValueType = typename Type::value_type;
     using Access = typename Base::Access;
+    using ElementChanges = typename Elements::ElementChanges;
 
     template<typename>
     friend class ::pex::Transaction;
@@ -348,6 +534,9 @@ public:
     template<typename>
     friend class ::pex::KeyValueContainerReference;
 
+    template<typename>
+    friend class ::pex::DeferValueContainer;
+
     template<typename>
     friend class ::pex::ConstReference;
 
@@ -357,12 +546,79 @@ public:
     template<typename, typename>
     friend class Publisher;
 
-    /** Set the value and notify interfaces **/
+    /** Replace the whole container.
+     **
+     ** Element observers receive a reset.
+     **/
+    void Set(Argument<Type> value) requires (HasAccess<SetTag, Access>)
+    {
+        this->SetWithoutNotify_(value);
+        this->Notify();
+    }
+
+    void Set(Type &&value)
+        requires (HasAccess<SetTag, Access> && MovableArgument<Type>)
+    {
+        this->SetWithoutNotify_(std::move(value));
+        this->Notify();
+    }
+
+    bool SetIfChanged(Argument<Type> value)
+        requires (HasAccess<SetTag, Access>)
+    {
+        if constexpr (detail::HasEqualTo<Type>)
+        {
+            if (value == this->value_)
+            {
+                return false;
+            }
+        }
+
+        this->SetWithoutNotify_(value);
+        this->Notify();
+
+        return true;
+    }
+
+    ValueContainer & operator=(Argument<Type> value)
+        requires (HasAccess<SetTag, Access>)
+    {
+        this->Set(value);
+        return *this;
+    }
+
+    ValueContainer & operator=(Type &&value)
+        requires (HasAccess<SetTag, Access> && MovableArgument<Type>)
+    {
+        this->Set(std::move(value));
+        return *this;
+    }
+
+    /** Notify interfaces, and send element observers a reset, because the
+     ** changed elements are not known.
+     **/
+    void Notify()
+    {
+        this->NotifyReset_();
+        this->Base::Notify();
+    }
+
+    /** Notify element observers of changes that have already been made, then
+     ** notify interfaces.
+     **/
+    void Notify(const ElementChanges &changes)
+    {
+        this->NotifyElements_(changes);
+        this->Base::Notify();
+    }
+
+    /** Set one element, and notify interfaces **/
     void Set(size_t index, Argument<ValueType> value)
         requires (HasAccess<SetTag, Access>)
     {
         this->SetWithoutNotify_(index, value);
-        this->Notify();
+        this->NotifyElement_(index, this->value_[index]);
+        this->Base::Notify();
     }
 
     Type Get(size_t index) const
@@ -397,27 +653,46 @@ protected:
 
     void SetWithoutNotify_(size_t index, Argument<ValueType> value)
     {
+        this->borrows_.RequireNone();
         this->value_[index] = value;
+        this->generation_.Bump();
     }
 };
 
 
+/** A keyed container with a second channel for element observers.
+ **
+ ** Set(key, value) sends element observers only the element that changed.
+ **/
 template<typename T>
-class KeyValueContainer: public Value_<T, NoFilter>
+class KeyValueContainer
+    :
+    public Value_<T, NoFilter>,
+    public detail::ElementNotifier
+    <
+        typename T::key_type,
+        typename T::mapped_type
+    >
 {
 public:
     static constexpr bool isKeyValueContainer = true;
 
     using Base = Value_<T, NoFilter>;
 
+    using Elements = detail::ElementNotifier
+    <
+        typename T::key_type,
+        typename T::mapped_type
+    >;
+
     using Base::Base;
-    using Base::Set;
     using Base::Get;
 
     using Type = typename Base::Type;
     using MappedType = typename Type::mapped_type;
     using KeyType = typename Type::key_type;
     using Access = typename Base::Access;
+    using ElementChanges = typename Elements::ElementChanges;
 
     template<typename>
     friend class ::pex::Transaction;
@@ -431,6 +706,9 @@ public:
     template<typename>
     friend class ::pex::KeyValueContainerReference;
 
+    template<typename>
+    friend class ::pex::DeferKeyValueContainer;
+
     template<typename>
     friend class ::pex::ConstReference;
 
@@ -440,12 +718,79 @@ public:
     template<typename, typename>
     friend class Publisher;
 
-    /** Set the value and notify interfaces **/
+    /** Replace the whole container.
+     **
+     ** Element observers receive a reset.
+     **/
+    void Set(Argument<Type> value) requires (HasAccess<SetTag, Access>)
+    {
+        this->SetWithoutNotify_(value);
+        this->Notify();
+    }
+
+    void Set(Type &&value)
+        requires (HasAccess<SetTag, Access> && MovableArgument<Type>)
+    {
+        this->SetWithoutNotify_(std::move(value));
+        this->Notify();
+    }
+
+    bool SetIfChanged(Argument<Type> value)
+        requires (HasAccess<SetTag, Access>)
+    {
+        if constexpr (detail::HasEqualTo<Type>)
+        {
+            if (value == this->value_)
+            {
+                return false;
+            }
+        }
+
+        this->SetWithoutNotify_(value);
+        this->Notify();
+
+        return true;
+    }
+
+    KeyValueContainer & operator=(Argument<Type> value)
+        requires (HasAccess<SetTag, Access>)
+    {
+        this->Set(value);
+        return *this;
+    }
+
+    KeyValueContainer & operator=(Type &&value)
+        requires (HasAccess<SetTag, Access> && MovableArgument<Type>)
+    {
+        this->Set(std::move(value));
+        return *this;
+    }
+
+    /** Notify interfaces, and send element observers a reset, because the
+     ** changed elements are not known.
+     **/
+    void Notify()
+    {
+        this->NotifyReset_();
+        this->Base::Notify();
+    }
+
+    /** Notify element observers of changes that have already been made, then
+     ** notify interfaces.
+     **/
+    void Notify(const ElementChanges &changes)
+    {
+        this->NotifyElements_(changes);
+        this->Base::Notify();
+    }
+
+    /** Set one element, and notify interfaces **/
     void Set(const KeyType &key, Argument<MappedType> value)
         requires (HasAccess<SetTag, Access>)
     {
         this->SetWithoutNotify_(key, value);
-        this->Notify();
+        this->NotifyElement_(key, this->value_.at(key));
+        this->Base::Notify();
     }
 
     Type Get(const KeyType &key) const
@@ -478,7 +823,9 @@ protected:
 
     void SetWithoutNotify_(const KeyType &key, Argument<MappedType> value)
     {
+        this->borrows_.RequireNone();
         this->value_[key] = value;
+        this->generation_.Bump();
     }
 };
 
@@ -489,6 +836,9 @@ using Value = Value_<T, NoFilter>;
 template<typename T, typename Filter>
 using FilteredValue = Value_<T, Filter>;
 
+template<typename T>
+using ConcurrentValue = Value_<T, NoFilter, GetAndSetTag, ConcurrentTag>;
+
 
 template<typename T, typename Filter_>
 class LockedValue: public Value_<T, Filter_>
@@ -522,7 +872,7 @@ public:
 
     explicit LockedValue(Type value)
         :
-        Base(value),
+        Base(std::move(value)),
         mutex_()
     {
 
@@ -530,7 +880,7 @@ public:
 
     LockedValue(Type value, Filter filter)
         :
-        Base(value, filter),
+        Base(std::move(value), filter),
         mutex_()
     {
 
@@ -556,6 +906,76 @@ public:
         return this->value_;
     }
 
+    // A reference would escape the lock.
+    const Type & GetRef() const = delete;
+    pex::View<Type> View() const = delete;
+
+    // Base::Set would call the unlocked Base::SetWithoutNotify_.
+    void Set(Argument<Type> value)
+    {
+        this->SetWithoutNotify_(value);
+        this->Notify();
+    }
+
+    void Set(Type &&value) requires MovableArgument<Type>
+    {
+        this->SetWithoutNotify_(std::move(value));
+        this->Notify();
+    }
+
+    LockedValue & operator=(Argument<Type> value)
+    {
+        this->Set(value);
+        return *this;
+    }
+
+    LockedValue & operator=(Type &&value) requires MovableArgument<Type>
+    {
+        this->Set(std::move(value));
+        return *this;
+    }
+
+    bool SetIfChanged(Argument<Type> value)
+    {
+        if constexpr (detail::HasEqualTo<Type>)
+        {
+            if constexpr (std::is_same_v<NoFilter, Filter_>)
+            {
+                std::lock_guard lock(this->mutex_);
+
+                if (value == this->value_)
+                {
+                    return false;
+                }
+
+                this->value_ = value;
+                this->generation_.Bump();
+            }
+            else
+            {
+                auto filteredValue = this->FilterOnSet_(value);
+
+                std::lock_guard lock(this->mutex_);
+
+                if (filteredValue == this->value_)
+                {
+                    return false;
+                }
+
+                this->value_ = std::move(filteredValue);
+                this->generation_.Bump();
+            }
+        }
+        else
+        {
+            this->SetWithoutNotify_(value);
+        }
+
+        this->Notify();
+
+        return true;
+    }
+
 protected:
     void SetWithoutNotify_(Argument<Type> value)
     {
@@ -563,13 +983,33 @@ protected:
         {
             std::lock_guard lock(this->mutex_);
             this->value_ = value;
+            this->generation_.Bump();
         }
         else
         {
             auto filteredValue = this->FilterOnSet_(value);
 
             std::lock_guard lock(this->mutex_);
-            this->value_ = filteredValue;
+            this->value_ = std::move(filteredValue);
+            this->generation_.Bump();
+        }
+    }
+
+    void SetWithoutNotify_(Type &&value) requires MovableArgument<Type>
+    {
+        if constexpr (std::is_same_v<NoFilter, Filter_>)
+        {
+            std::lock_guard lock(this->mutex_);
+            this->value_ = std::move(value);
+            this->generation_.Bump();
+        }
+        else
+        {
+            auto filteredValue = this->FilterOnSet_(std::move(value));
+
+            std::lock_guard lock(this->mutex_);
+            this->value_ = std::move(filteredValue);
+            this->generation_.Bump();
         }
     }
 
@@ -640,6 +1080,24 @@ public:
         return this->model_->Get();
     }
 
+    const Type & GetRef() const requires detail::HasGetRef<Model>
+    {
+        REQUIRE_HAS_VALUE(this->model_);
+        return this->model_->GetRef();
+    }
+
+    pex::View<Type> View() const requires detail::HasView<Model>
+    {
+        REQUIRE_HAS_VALUE(this->model_);
+        return this->model_->View();
+    }
+
+    uint64_t GetGeneration() const requires detail::HasGetGeneration<Model>
+    {
+        REQUIRE_HAS_VALUE(this->model_);
+        return this->model_->GetGeneration();
+    }
+
     void Set(Argument<Type> value)
     {
         static_assert(HasAccess<SetTag, typename Model::Access>);
@@ -648,7 +1106,23 @@ public:
         this->model_->Set(value);
     }
 
-    void Connect(void *observer, Callable callable)
+    void Set(Type &&value) requires MovableArgument<Type>
+    {
+        static_assert(HasAccess<SetTag, typename Model::Access>);
+
+        REQUIRE_HAS_VALUE(this->model_);
+        this->model_->Set(std::move(value));
+    }
+
+    bool SetIfChanged(Argument<Type> value)
+    {
+        static_assert(HasAccess<SetTag, typename Model::Access>);
+
+        REQUIRE_HAS_VALUE(this->model_);
+        return this->model_->SetIfChanged(value);
+    }
+
+    detail::ConnectionToken Connect(void *observer, Callable callable)
     {
         if (this->model_)
         {
@@ -658,11 +1132,13 @@ public:
                 " to ",
                 LookupPexName(this->model_));
 
-            this->model_->Connect(observer, callable);
+            return this->model_->Connect(observer, callable);
         }
+
+        return {};
     }
 
-    void ConnectOnce(void *observer, Callable callable)
+    detail::ConnectionToken ConnectOnce(void *observer, Callable callable)
     {
         if (this->model_)
         {
@@ -672,8 +1148,10 @@ public:
                 " to ",
                 LookupPexName(this->model_));
 
-            this->model_->ConnectOnce(observer, callable);
+            return this->model_->ConnectOnce(observer, callable);
         }
+
+        return {};
     }
 
     void Disconnect(void *observer)
@@ -685,6 +1163,14 @@ public:
         }
     }
 
+    void Disconnect(detail::ConnectionToken token)
+    {
+        if (this->model_)
+        {
+            this->model_->Disconnect(token);
+        }
+    }
+
     bool HasModel() const
     {
         return (this->model_ != nullptr);
@@ -717,6 +1203,11 @@ protected:
         this->model_->SetWithoutNotify_(value);
     }
 
+    void SetWithoutNotify_(Type &&value) requires MovableArgument<Type>
+    {
+        this->model_->SetWithoutNotify_(std::move(value));
+    }
+
     const Model & GetModel_() const
     {
         if (!this->HasModel())
@@ -753,16 +1244,56 @@ public:
     template<typename>
     friend class ::pex::ValueContainerReference;
 
+    template<typename>
+    friend class ::pex::DeferValueContainer;
+
     using Type = typename Base::Type;
     using ValueType = typename Type::value_type;
     using Access = typename Model_::Access;
+    using ElementChanges = typename Model_::ElementChanges;
+    using ElementCallable = typename Model_::ElementCallable;
 
     /** Set the value and notify interfaces **/
     void Set(size_t index, Argument<ValueType> value)
         requires (HasAccess<SetTag, Access>)
     {
-        this->SetWithoutNotify_(index, value);
-        this->Notify();
+        REQUIRE_HAS_VALUE(this->model_);
+        this->model_->Set(index, value);
+    }
+
+    detail::ConnectionToken ConnectElements(
+        void *observer,
+        ElementCallable callable)
+    {
+        if (this->model_)
+        {
+            return this->model_->ConnectElements(observer, callable);
+        }
+
+        return {};
+    }
+
+    void DisconnectElements(void *observer)
+    {
+        if (this->model_)
+        {
+            this->model_->DisconnectElements(observer);
+        }
+    }
+
+    void DisconnectElements(detail::ConnectionToken token)
+    {
+        if (this->model_)
+        {
+            this->model_->DisconnectElements(token);
+        }
+    }
+
+    using Base::Notify;
+
+    void Notify(const ElementChanges &changes)
+    {
+        this->model_->Notify(changes);
     }
 
     Type Get(size_t index) const
@@ -815,6 +1346,8 @@ public:
     using MappedType = typename Type::mapped_type;
     using KeyType = typename Type::key_type;
     using Access = typename Model_::Access;
+    using ElementChanges = typename Model_::ElementChanges;
+    using ElementCallable = typename Model_::ElementCallable;
 
     template<typename>
     friend class ::pex::Reference;
@@ -828,12 +1361,50 @@ public:
     template<typename>
     friend class ::pex::KeyValueContainerReference;
 
+    template<typename>
+    friend class ::pex::DeferKeyValueContainer;
+
     /** Set the value and notify interfaces **/
     void Set(const KeyType &key, Argument<MappedType> value)
         requires (HasAccess<SetTag, Access>)
     {
-        this->SetWithoutNotify_(key, value);
-        this->Notify();
+        REQUIRE_HAS_VALUE(this->model_);
+        this->model_->Set(key, value);
+    }
+
+    detail::ConnectionToken ConnectElements(
+        void *observer,
+        ElementCallable callable)
+    {
+        if (this->model_)
+        {
+            return this->model_->ConnectElements(observer, callable);
+        }
+
+        return {};
+    }
+
+    void DisconnectElements(void *observer)
+    {
+        if (this->model_)
+        {
+            this->model_->DisconnectElements(observer);
+        }
+    }
+
+    void DisconnectElements(detail::ConnectionToken token)
+    {
+        if (this->model_)
+        {
+            this->model_->DisconnectElements(token);
+        }
+    }
+
+    using Base::Notify;
+
+    void Notify(const ElementChanges &changes)
+    {
+        this->model_->Notify(changes);
     }
 
     Type Get(const KeyType &key) const
@@ -154,7 +154,7 @@ public:
                 // Notify that the base_ will be replaced.
                 this->baseWillDelete_.Trigger();
 
-                this->internalBaseWillDelete_.TriggerMayModify();
+                this->internalBaseWillDelete_.Trigger();
             }
 
             // Create the right kind of ModelBase for this value.
@@ -170,9 +170,9 @@ public:
             this->superModel_->SetValueWithoutNotify(value);
 
             // Create the new control before signaling the rest of the library.
-            // Use the slower TriggerMayModify to allow the new ControlWrapper
-            // to connect itself to this signal.
-            this->internalBaseCreated_.TriggerMayModify();
+            // The new ControlWrapper may connect itself to this signal from
+            // the callback.
+            this->internalBaseCreated_.Trigger();
 
             this->baseCreated_.Trigger();
         }
@@ -0,0 +1,64 @@
+/**
+  * @file notify_policy.h
+  *
+  * @brief Tags to select how a node synchronizes its connections.
+  *
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+
+#include <type_traits>
+
+
+namespace pex
+{
+
+
+struct NotifyPolicyTag {};
+
+// Connections and notifications happen on one thread.
+// There is no synchronization, and this is the default.
+struct SingleThreadedTag: NotifyPolicyTag {};
+
+// Notifications may happen on one thread while other threads connect and
+// disconnect. Notifications never wait for connection changes.
+struct ConcurrentTag: NotifyPolicyTag {};
+
+// Like SingleThreadedTag, but notifications are always delivered
+// immediately, even while a pex::Propagation is in scope.
+// Used by structural signals, like the member signals of lists, that other
+// nodes must observe in order to stay in sync.
+struct ImmediateTag: NotifyPolicyTag {};
+
+
+template<typename T>
+concept IsNotifyPolicy = std::is_base_of_v<NotifyPolicyTag, T>;
+
+
+template<typename T>
+struct NotifyPolicy_
+{
+    using Type = SingleThreadedTag;
+};
+
+
+template<typename T>
+    requires IsNotifyPolicy<typename T::NotifyPolicy>
+struct NotifyPolicy_<T>
+{
+    using Type = typename T::NotifyPolicy;
+};
+
+
+// The notify policy declared by T, or SingleThreadedTag.
+template<typename T>
+using NotifyPolicyT = typename NotifyPolicy_<T>::Type;
+
+
+} // end namespace pex
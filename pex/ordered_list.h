@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <numeric>
 #include <fields/fields.h>
 #include "pex/group.h"
 #include "pex/reference.h"
@@ -193,6 +194,9 @@ struct OrderedListCustom
         using MemberWillRemove = control::ListOptionalIndex;
         using MemberWillReplace = control::ListOptionalIndex;
         using MemberReplaced = control::ListOptionalIndex;
+        using MembersAdded = control::ListOptionalRange;
+        using MembersWillRemove = control::ListOptionalRange;
+        using MembersRemoved = control::ListOptionalRange;
         using Count = control::ListCount;
 
     private:
@@ -202,12 +206,18 @@ struct OrderedListCustom
         using MemberAddedEndpoint = Endpoint<Model, MemberAdded>;
         using MemberWillReplaceEndpoint = Endpoint<Model, MemberWillReplace>;
         using MemberReplacedEndpoint = Endpoint<Model, MemberReplaced>;
+        using MembersAddedEndpoint = Endpoint<Model, MembersAdded>;
+        using MembersWillRemoveEndpoint = Endpoint<Model, MembersWillRemove>;
+        using MembersRemovedEndpoint = Endpoint<Model, MembersRemoved>;
 
         MemberAddedEndpoint memberAddedEndpoint_;
         MemberWillRemoveEndpoint memberWillRemoveEndpoint_;
         MemberRemovedEndpoint memberRemovedEndpoint_;
         MemberWillReplaceEndpoint memberWillReplaceEndpoint_;
         MemberReplacedEndpoint memberReplacedEndpoint_;
+        MembersAddedEndpoint membersAddedEndpoint_;
+        MembersWillRemoveEndpoint membersWillRemoveEndpoint_;
+        MembersRemovedEndpoint membersRemovedEndpoint_;
 
     public:
         Selected selected;
@@ -217,6 +227,9 @@ struct OrderedListCustom
         MemberRemoved memberRemoved;
         MemberWillReplace memberWillReplace;
         MemberReplaced memberReplaced;
+        MembersAdded membersAdded;
+        MembersWillRemove membersWillRemove;
+        MembersRemoved membersRemoved;
 
         using Indices = ModelSelector<IndicesList>;
 
@@ -252,6 +265,21 @@ struct OrderedListCustom
                 this->list.memberReplaced,
                 &Model::OnListMemberReplaced_),
 
+            membersAddedEndpoint_(
+                this,
+                this->list.membersAdded,
+                &Model::OnListMembersAdded_),
+
+            membersWillRemoveEndpoint_(
+                this,
+                this->list.membersWillRemove,
+                &Model::OnListMembersWillRemove_),
+
+            membersRemovedEndpoint_(
+                this,
+                this->list.membersRemoved,
+                &Model::OnListMembersRemoved_),
+
             selected(this->list.selected),
             count(this->list.count),
             memberAdded(this->list.memberAdded),
@@ -259,6 +287,9 @@ struct OrderedListCustom
             memberRemoved(this->list.memberRemoved),
             memberWillReplace(this->list.memberWillReplace),
             memberReplaced(this->list.memberReplaced),
+            membersAdded(this->list.membersAdded),
+            membersWillRemove(this->list.membersWillRemove),
+            membersRemoved(this->list.membersRemoved),
             moveToTopEndpoints_(),
             moveUpEndpoints_(),
             moveDownEndpoints_(),
@@ -783,6 +814,109 @@ struct OrderedListCustom
             this->RestoreConnections_(removed);
         }
 
+        void OnListMembersAdded_(const std::optional<ListRange> &addedRange)
+        {
+            if (!addedRange)
+            {
+                return;
+            }
+
+            auto range = *addedRange;
+
+            if (this->indices.size() >= this->list.count.Get())
+            {
+                // The indices were set before the items were added.
+                if constexpr (hasOrder)
+                {
+                    this->ClearInvalidatedConnections_(range.first);
+                    this->RestoreConnections_(range.first);
+                }
+
+                return;
+            }
+
+            auto previous = this->indices.Get();
+
+            std::transform(
+                std::cbegin(previous),
+                std::cend(previous),
+                std::begin(previous),
+                [&range](size_t value)
+                {
+                    if (value >= range.first)
+                    {
+                        return value + range.count;
+                    }
+
+                    return value;
+                });
+
+            std::vector<size_t> added(range.count);
+            std::iota(std::begin(added), std::end(added), range.first);
+
+            previous.insert(
+                previous.begin() + static_cast<ssize_t>(range.first),
+                std::begin(added),
+                std::end(added));
+
+            detail::AccessReference(this->indices).SetWithoutNotify(previous);
+            assert(this->indices.size() == previous.size());
+
+            this->ClearInvalidatedConnections_(range.first);
+            this->RestoreConnections_(range.first);
+        }
+
+        void OnListMembersWillRemove_(
+            const std::optional<ListRange> &removedRange)
+        {
+            if constexpr (!hasOrder)
+            {
+                return;
+            }
+
+            if (!removedRange)
+            {
+                return;
+            }
+
+            this->ClearInvalidatedConnections_(removedRange->first);
+        }
+
+        void OnListMembersRemoved_(const std::optional<ListRange> &removedRange)
+        {
+            if (!removedRange)
+            {
+                return;
+            }
+
+            auto range = *removedRange;
+            auto previous = this->indices.Get();
+
+            std::erase_if(
+                previous,
+                [&range](size_t index)
+                {
+                    return index >= range.first && index < range.GetEnd();
+                });
+
+            std::transform(
+                std::cbegin(previous),
+                std::cend(previous),
+                std::begin(previous),
+                [&range](size_t value)
+                {
+                    if (value >= range.GetEnd())
+                    {
+                        return value - range.count;
+                    }
+
+                    return value;
+                });
+
+            detail::AccessReference(this->indices).SetWithoutNotify(previous);
+            this->RestoreConnections_(range.first);
+        }
+
     private:
 
         using MoveOrderEndpoint =
@@ -1154,6 +1288,9 @@ struct OrderedListCustom
         using MemberRemoved = typename List::MemberRemoved;
         using MemberWillReplace = typename List::MemberWillReplace;
         using MemberReplaced = typename List::MemberReplaced;
+        using MembersAdded = typename List::MembersAdded;
+        using MembersWillRemove = typename List::MembersWillRemove;
+        using MembersRemoved = typename List::MembersRemoved;
         using Count = typename List::Count;
         using ListItem = typename List::ListItem;
         using Upstream = typename Base::Upstream;
@@ -1172,6 +1309,9 @@ struct OrderedListCustom
         MemberRemoved memberRemoved;
         MemberWillReplace memberWillReplace;
         MemberReplaced memberReplaced;
+        MembersAdded membersAdded;
+        MembersWillRemove membersWillRemove;
+        MembersRemoved membersRemoved;
 
         Mux()
             :
@@ -1183,7 +1323,10 @@ struct OrderedListCustom
             memberWillRemove(),
             memberRemoved(),
             memberWillReplace(),
-            memberReplaced()
+            memberReplaced(),
+            membersAdded(),
+            membersWillRemove(),
+            membersRemoved()
         {
             PEX_NAME("OrderedList::Mux");
         }
@@ -1198,7 +1341,10 @@ struct OrderedListCustom
             memberWillRemove(this->upstream_->list.memberWillRemove),
             memberRemoved(this->upstream_->list.memberRemoved),
             memberWillReplace(this->upstream_->list.memberWillReplace),
-            memberReplaced(this->upstream_->list.memberReplaced)
+            memberReplaced(this->upstream_->list.memberReplaced),
+            membersAdded(this->upstream_->list.membersAdded),
+            membersWillRemove(this->upstream_->list.membersWillRemove),
+            membersRemoved(this->upstream_->list.membersRemoved)
         {
             PEX_NAME("OrderedList::Mux");
 
@@ -1234,6 +1380,13 @@ struct OrderedListCustom
             this->memberReplaced.ChangeUpstream(
                 upstream.list.memberReplaced);
 
+            this->membersAdded.ChangeUpstream(upstream.list.membersAdded);
+
+            this->membersWillRemove.ChangeUpstream(
+                upstream.list.membersWillRemove);
+
+            this->membersRemoved.ChangeUpstream(upstream.list.membersRemoved);
+
             this->upstream_ = &upstream;
         }
 
@@ -1313,6 +1466,9 @@ struct OrderedListCustom
         using MemberRemoved = control::ListOptionalIndex;
         using MemberWillReplace = control::ListOptionalIndex;
         using MemberReplaced = control::ListOptionalIndex;
+        using MembersAdded = control::ListOptionalRange;
+        using MembersWillRemove = control::ListOptionalRange;
+        using MembersRemoved = control::ListOptionalRange;
         using Count = typename List::Count;
         using ListItem = typename List::ListItem;
         using Upstream = typename Base::Upstream;
@@ -1338,6 +1494,9 @@ struct OrderedListCustom
         MemberRemoved memberRemoved;
         MemberWillReplace memberWillReplace;
         MemberReplaced memberReplaced;
+        MembersAdded membersAdded;
+        MembersWillRemove membersWillRemove;
+        MembersRemoved membersRemoved;
 
         Control()
             :
@@ -1349,7 +1508,10 @@ struct OrderedListCustom
             memberWillRemove(),
             memberRemoved(),
             memberWillReplace(),
-            memberReplaced()
+            memberReplaced(),
+            membersAdded(),
+            membersWillRemove(),
+            membersRemoved()
         {
             PEX_NAME("OrderedList::Control");
         }
@@ -1364,7 +1526,10 @@ struct OrderedListCustom
             memberWillRemove(this->upstream_->list.memberWillRemove),
             memberRemoved(this->upstream_->list.memberRemoved),
             memberWillReplace(this->upstream_->list.memberWillReplace),
-            memberReplaced(this->upstream_->list.memberReplaced)
+            memberReplaced(this->upstream_->list.memberReplaced),
+            membersAdded(this->upstream_->list.membersAdded),
+            membersWillRemove(this->upstream_->list.membersWillRemove),
+            membersRemoved(this->upstream_->list.membersRemoved)
         {
             PEX_NAME("OrderedList::Control");
 
@@ -1382,7 +1547,10 @@ struct OrderedListCustom
             memberWillRemove(this->upstream_->list.memberWillRemove),
             memberRemoved(this->upstream_->list.memberRemoved),
             memberWillReplace(this->upstream_->list.memberWillReplace),
-            memberReplaced(this->upstream_->list.memberReplaced)
+            memberReplaced(this->upstream_->list.memberReplaced),
+            membersAdded(this->upstream_->list.membersAdded),
+            membersWillRemove(this->upstream_->list.membersWillRemove),
+            membersRemoved(this->upstream_->list.membersRemoved)
         {
             PEX_NAME("OrderedList::Control");
         }
@@ -1403,6 +1571,9 @@ struct OrderedListCustom
             this->memberRemoved = other.memberRemoved;
             this->memberWillReplace = other.memberWillReplace;
             this->memberReplaced = other.memberReplaced;
+            this->membersAdded = other.membersAdded;
+            this->membersWillRemove = other.membersWillRemove;
+            this->membersRemoved = other.membersRemoved;
 
             return *this;
         }
@@ -1424,7 +1595,14 @@ struct OrderedListCustom
                 upstream.list.memberWillReplace);
 
             this->memberReplaced.ChangeUpstream(
-                upstream.upstream.list.memberReplaced);
+                upstream.list.memberReplaced);
+
+            this->membersAdded.ChangeUpstream(upstream.list.membersAdded);
+
+            this->membersWillRemove.ChangeUpstream(
+                upstream.list.membersWillRemove);
+
+            this->membersRemoved.ChangeUpstream(upstream.list.membersRemoved);
 
             this->upstream_ = &upstream;
         }
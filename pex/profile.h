@@ -0,0 +1,77 @@
+/**
+  * @file profile.h
+  *
+  * @brief Reports the notification counts and callback times recorded when
+  * pex is built with ENABLE_PEX_PROFILE.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+// #define ENABLE_PEX_PROFILE
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace pex
+{
+
+
+// Bucket i counts callbacks that took at least 2^i and less than 2^(i + 1)
+// nanoseconds. The first bucket also counts faster callbacks, and the last
+// counts everything slower.
+inline constexpr size_t profileBucketCount = 32;
+
+using ProfileHistogram = std::array<uint64_t, profileBucketCount>;
+
+
+struct NodeProfile
+{
+    // The node's name from LookupPexName when it first notified.
+    std::string name;
+    uint64_t notifyCount;
+
+    // The total number of callbacks made, and the most made by one Notify_.
+    uint64_t callbackCount;
+    size_t maxFanOut;
+
+    std::chrono::nanoseconds totalTime;
+};
+
+
+struct ObserverProfile
+{
+    std::string observer;
+    std::string node;
+    uint64_t callCount;
+    std::chrono::nanoseconds totalTime;
+    std::chrono::nanoseconds maxTime;
+    ProfileHistogram histogram;
+};
+
+
+/** Nodes with the most notifications, up to count. **/
+std::vector<NodeProfile> GetHottestNodes(size_t count);
+
+/** Observer connections with the most total callback time, up to count. **/
+std::vector<ObserverProfile> GetSlowestObservers(size_t count);
+
+/** Write a table of the count hottest nodes and slowest observers. **/
+void ReportProfile(std::ostream &output, size_t count = 10);
+
+/** Write everything that was recorded as JSON. **/
+void ExportProfileJson(std::ostream &output);
+
+void ResetProfile();
+
+
+} // end namespace pex
@@ -0,0 +1,143 @@
+/**
+  * @file propagation.h
+  *
+  * @brief Glitch-free propagation of the changes made within a scope.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <exception>
+#include <optional>
+#include <utility>
+#include "pex/detail/propagation.h"
+
+
+namespace pex
+{
+
+
+/**
+ ** While a Propagation exists, values are changed immediately, but their
+ ** notifications are scheduled instead of delivered.
+ **
+ ** When the outermost Propagation on the thread goes out of scope, each
+ ** node that was notified delivers its latest notification once, ordered
+ ** by its depth in the graph. Nodes notified during delivery, like filtered
+ ** controls, derived values, and group aggregates, are scheduled in turn,
+ ** so an observer of a derived node runs after the nodes it depends on have
+ ** all been updated.
+ **
+ ** Depth is learned as notifications flow, and remembered by each node. The
+ ** first propagation through a new path may deliver a node twice; later
+ ** propagations deliver it once.
+ **
+ ** Only affects nodes that use the SingleThreadedTag notify policy, on the
+ ** thread that created the Propagation. The structural signals of lists and
+ ** the mute nodes of groups use the ImmediateTag, and are always delivered
+ ** immediately, so controls and connections stay in sync with their models.
+ ** The members of lists and groups are scheduled like any other node.
+ **
+ ** If the scope is left by an exception, scheduled notifications are
+ ** discarded.
+ **
+ ** If an observer throws while notifications are delivered, the
+ ** notifications that had not been delivered yet are discarded: those
+ ** scheduled at the same depth after the observer that threw, and all of
+ ** those at a greater depth. Their observers are not told of the changes,
+ ** though the values have changed. Flush delivers within the scope, and
+ ** rethrows the exception to its caller. The destructor cannot throw, so
+ ** it keeps the exception for TakeFailure instead.
+ **/
+class Propagation
+{
+public:
+    Propagation()
+        :
+        scheduler_(),
+        uncaughtExceptions_(std::uncaught_exceptions())
+    {
+        if (!detail::activePropagation)
+        {
+            this->scheduler_.emplace();
+            detail::activePropagation = &(*this->scheduler_);
+        }
+    }
+
+    Propagation(const Propagation &) = delete;
+    Propagation & operator=(const Propagation &) = delete;
+
+    ~Propagation()
+    {
+        if (!this->scheduler_)
+        {
+            // A nested Propagation is flushed by the outermost.
+            return;
+        }
+
+        // Observers notified by the flush are scheduled in turn, so the
+        // scheduler stays active until the flush has ended, however it ends.
+        struct Deactivate
+        {
+            ~Deactivate()
+            {
+                detail::activePropagation = nullptr;
+            }
+        };
+
+        Deactivate deactivate;
+
+        if (std::uncaught_exceptions() > this->uncaughtExceptions_)
+        {
+            this->scheduler_->Discard();
+
+            return;
+        }
+
+        try
+        {
+            this->scheduler_->Flush();
+        }
+        catch (...)
+        {
+            detail::propagationFailure = std::current_exception();
+        }
+    }
+
+    /** Deliver the notifications scheduled so far.
+     **
+     ** If an observer throws, the notifications that were not delivered are
+     ** discarded, and the exception is rethrown.
+     **/
+    void Flush()
+    {
+        if (this->scheduler_)
+        {
+            this->scheduler_->Flush();
+        }
+    }
+
+    static bool IsActive()
+    {
+        return detail::activePropagation != nullptr;
+    }
+
+    /** Take the exception thrown by an observer while the last outermost
+     ** Propagation on this thread was destroyed, if any.
+     **/
+    static std::exception_ptr TakeFailure()
+    {
+        return std::exchange(detail::propagationFailure, nullptr);
+    }
+
+private:
+    std::optional<detail::PropagationScheduler> scheduler_;
+    int uncaughtExceptions_;
+};
+
+
+} // end namespace pex
@@ -534,6 +534,27 @@ public:
     // hold a reference to a model value.
     bool HasModel() const { return true; }
 
+    uint64_t GetGeneration() const
+    {
+        return this->value.GetGeneration()
+            + this->minimum.GetGeneration()
+            + this->maximum.GetGeneration();
+    }
+
+    void SetGenerationParent(detail::Generation *parent)
+    {
+        this->value.SetGenerationParent(parent);
+        this->minimum.SetGenerationParent(parent);
+        this->maximum.SetGenerationParent(parent);
+    }
+
+    void SetBorrowsParent(const detail::Borrows *parent)
+    {
+        this->value.SetBorrowsParent(parent);
+        this->minimum.SetBorrowsParent(parent);
+        this->maximum.SetBorrowsParent(parent);
+    }
+
     LimitType GetMaximum() const
     {
         return this->maximum.Get();
@@ -1018,6 +1039,13 @@ public:
             && this->maximum.HasModel();
     }
 
+    uint64_t GetGeneration() const
+    {
+        return this->value.GetGeneration()
+            + this->minimum.GetGeneration()
+            + this->maximum.GetGeneration();
+    }
+
     Bounds<LimitType> GetBounds()
     {
         return {
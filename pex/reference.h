@@ -120,6 +120,11 @@ public:
         this->pex_->Set(value);
     }
 
+    void Set(Type &&value) requires MovableArgument<Type>
+    {
+        this->pex_->Set(std::move(value));
+    }
+
     void Clear()
     {
         this->pex_ = nullptr;
@@ -136,6 +141,11 @@ protected:
         this->pex_->SetWithoutNotify_(value);
     }
 
+    void SetWithoutNotify_(Type &&value) requires MovableArgument<Type>
+    {
+        this->pex_->SetWithoutNotify_(std::move(value));
+    }
+
     void SetWithoutFilter_(Argument<Type> value)
     {
         this->pex_->SetWithoutFilter_(value);
@@ -257,7 +267,7 @@ public:
     void Set(const KeyType &key, Argument<MappedType> value)
         requires (HasAccess<SetTag, Access>)
     {
-        this->Set(key, value);
+        this->pex_->Set(key, value);
     }
 
     Type Get(const KeyType &key) const
@@ -314,11 +324,22 @@ public:
         this->Notify();
     }
 
+    void Set(Type &&value) requires MovableArgument<Type>
+    {
+        this->SetWithoutNotify_(std::move(value));
+        this->Notify();
+    }
+
     void SetWithoutNotify(Argument<Type> value)
     {
         this->SetWithoutNotify_(value);
     }
 
+    void SetWithoutNotify(Type &&value) requires MovableArgument<Type>
+    {
+        this->SetWithoutNotify_(std::move(value));
+    }
+
     void SetWithoutFilter(Argument<Type> value)
     {
         this->SetWithoutFilter_(value);
@@ -411,6 +432,12 @@ public:
         this->SetWithoutNotify_(value);
     }
 
+    void Set(Type &&value) requires MovableArgument<Type>
+    {
+        this->isChanged_ = true;
+        this->SetWithoutNotify_(std::move(value));
+    }
+
     Defer & operator=(Argument<Type> value)
     {
         this->isChanged_ = true;
@@ -418,6 +445,13 @@ public:
         return *this;
     }
 
+    Defer & operator=(Type &&value) requires MovableArgument<Type>
+    {
+        this->isChanged_ = true;
+        this->SetWithoutNotify_(std::move(value));
+        return *this;
+    }
+
     ~Defer()
     {
         // Notify on destruction
@@ -450,13 +484,15 @@ public:
     using Type = typename Base::Type;
     using ValueType = typename Type::value_type;
     using Access = typename Pex::Access;
+    using ElementChanges = typename Pex::ElementChanges;
 
     using Base::Base;
 
     DeferValueContainer()
         :
         Base(),
-        isChanged_(false)
+        isChanged_(false),
+        changes_()
     {
 
     }
@@ -464,7 +500,8 @@ public:
     DeferValueContainer(Pex &pex)
         :
         Base(pex),
-        isChanged_(false)
+        isChanged_(false),
+        changes_()
     {
 
     }
@@ -472,9 +509,11 @@ public:
     DeferValueContainer(DeferValueContainer &&other)
         :
         Base(std::move(other)),
-        isChanged_(other.isChanged_)
+        isChanged_(other.isChanged_),
+        changes_(std::move(other.changes_))
     {
         other.isChanged_ = false;
+        other.changes_.clear();
     }
 
     DeferValueContainer & operator=(DeferValueContainer &&other)
@@ -486,6 +525,9 @@ public:
 
         Base::operator=(std::move(other));
         this->isChanged_ = other.isChanged_;
+        this->changes_ = std::move(other.changes_);
+        other.isChanged_ = false;
+        other.changes_.clear();
 
         return *this;
     }
@@ -493,6 +535,7 @@ public:
     void Set(Argument<Type> value)
     {
         this->isChanged_ = true;
+        this->changes_.MarkReset();
         this->SetWithoutNotify_(value);
     }
 
@@ -501,11 +544,13 @@ public:
     {
         this->isChanged_ = true;
         this->pex_->SetWithoutNotify_(index, value);
+        this->changes_.Add(index, value);
     }
 
     DeferValueContainer & operator=(Argument<Type> value)
     {
         this->isChanged_ = true;
+        this->changes_.MarkReset();
         this->SetWithoutNotify_(value);
         return *this;
     }
@@ -516,12 +561,18 @@ public:
         this->Notify();
     }
 
+    /** Notify once for every deferred change.
+     **
+     ** Element observers receive the elements set by this Defer in one
+     ** change set, or a reset if the whole container was set.
+     **/
     void Notify()
     {
         if (this->pex_ && this->isChanged_)
         {
-            this->Base::Notify();
+            this->pex_->Notify(this->changes_);
             this->isChanged_ = false;
+            this->changes_.clear();
         }
 
         this->pex_ = nullptr;
@@ -529,6 +580,7 @@ public:
 
 private:
     bool isChanged_;
+    ElementChanges changes_;
 };
 
 
@@ -541,13 +593,15 @@ public:
     using KeyType = typename Type::key_type;
     using MappedType = typename Type::mapped_type;
     using Access = typename Pex::Access;
+    using ElementChanges = typename Pex::ElementChanges;
 
     using Base::Base;
 
     DeferKeyValueContainer()
         :
         Base(),
-        isChanged_(false)
+        isChanged_(false),
+        changes_()
     {
 
     }
@@ -555,7 +609,8 @@ public:
     DeferKeyValueContainer(Pex &pex)
         :
         Base(pex),
-        isChanged_(false)
+        isChanged_(false),
+        changes_()
     {
 
     }
@@ -563,9 +618,11 @@ public:
     DeferKeyValueContainer(DeferKeyValueContainer &&other)
         :
         Base(std::move(other)),
-        isChanged_(other.isChanged_)
+        isChanged_(other.isChanged_),
+        changes_(std::move(other.changes_))
     {
         other.isChanged_ = false;
+        other.changes_.clear();
     }
 
     DeferKeyValueContainer & operator=(DeferKeyValueContainer &&other)
@@ -577,6 +634,9 @@ public:
 
         Base::operator=(std::move(other));
         this->isChanged_ = other.isChanged_;
+        this->changes_ = std::move(other.changes_);
+        other.isChanged_ = false;
+        other.changes_.clear();
 
         return *this;
     }
@@ -584,6 +644,7 @@ public:
     void Set(Argument<Type> value)
     {
         this->isChanged_ = true;
+        this->changes_.MarkReset();
         this->SetWithoutNotify_(value);
     }
 
@@ -592,11 +653,13 @@ public:
     {
         this->isChanged_ = true;
         this->pex_->SetWithoutNotify_(key, value);
+        this->changes_.Add(key, value);
     }
 
     DeferKeyValueContainer & operator=(Argument<Type> value)
     {
         this->isChanged_ = true;
+        this->changes_.MarkReset();
         this->SetWithoutNotify_(value);
         return *this;
     }
@@ -607,12 +670,18 @@ public:
         this->Notify();
     }
 
+    /** Notify once for every deferred change.
+     **
+     ** Element observers receive the elements set by this Defer in one
+     ** change set, or a reset if the whole container was set.
+     **/
     void Notify()
     {
         if (this->pex_ && this->isChanged_)
         {
-            this->Base::Notify();
+            this->pex_->Notify(this->changes_);
             this->isChanged_ = false;
+            this->changes_.clear();
         }
 
         this->pex_ = nullptr;
@@ -620,6 +689,7 @@ public:
 
 private:
     bool isChanged_;
+    ElementChanges changes_;
 };
 
 
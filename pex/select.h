@@ -225,6 +225,23 @@ public:
         return Control(this->selection_);
     }
 
+    uint64_t GetGeneration() const
+    {
+        return this->value_.GetGeneration() + this->choices_.GetGeneration();
+    }
+
+    void SetGenerationParent(detail::Generation *parent)
+    {
+        this->value_.SetGenerationParent(parent);
+        this->choices_.SetGenerationParent(parent);
+    }
+
+    void SetBorrowsParent(const detail::Borrows *parent)
+    {
+        this->value_.SetBorrowsParent(parent);
+        this->choices_.SetBorrowsParent(parent);
+    }
+
     void SetChoices(const std::vector<Type> &choices)
     {
         static_assert(
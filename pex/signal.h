@@ -56,9 +56,11 @@ public:
         this->Notify_();
     }
 
+    // Callbacks may modify the connections during any Trigger, so this is
+    // the same as Trigger. It remains for existing callers.
     void TriggerMayModify()
     {
-        this->NotifyMayModify_();
+        this->Notify_();
     }
 
     explicit operator DescribeSignal () const
@@ -94,6 +96,7 @@ public:
     {
         Upstream *upstream_;
         Signal *observer_;
+        detail::ConnectionToken token_;
 
     public:
         using FunctionPointer = void (*)(void *);
@@ -104,9 +107,10 @@ public:
             FunctionPointer callable)
             :
             upstream_(upstream),
-            observer_(observer)
+            observer_(observer),
+            token_(this->upstream_->Connect(observer, callable))
         {
-            this->upstream_->ConnectOnce(observer, callable);
+
         }
 
         ~UpstreamConnection()
@@ -117,7 +121,7 @@ public:
                 " from ",
                 LookupPexName(this->upstream_));
 
-            this->upstream_->Disconnect(this->observer_);
+            this->upstream_->Disconnect(this->token_);
         }
     };
 
@@ -274,7 +278,7 @@ public:
         this->upstreamConnection_.reset();
     }
 
-    void Connect(void *observer, Callable callable)
+    detail::ConnectionToken Connect(void *observer, Callable callable)
     {
         if (!this->upstreamConnection_)
         {
@@ -284,10 +288,24 @@ public:
                 &Signal::OnModelSignaled_);
         }
 
-        this->Base::Connect(observer, callable);
+        return this->Base::Connect(observer, callable);
     }
 
-    void ConnectOnce(void *observer, Callable callable)
+    // Connect a callback that is known at compile time.
+    template<auto callback, typename T>
+    detail::ConnectionToken Connect(T *observer)
+    {
+        return this->Connect(
+            observer,
+            detail::BoundCallback
+            <
+                callback,
+                T,
+                typename detail::SignalConnection<void>::FunctionPointer
+            >);
+    }
+
+    detail::ConnectionToken ConnectOnce(void *observer, Callable callable)
     {
         if (!this->upstreamConnection_)
         {
@@ -297,7 +315,7 @@ public:
                 &Signal::OnModelSignaled_);
         }
 
-        this->Base::ConnectOnce(observer, callable);
+        return this->Base::ConnectOnce(observer, callable);
     }
 
     void Disconnect(void *observer)
@@ -312,6 +330,16 @@ public:
         }
     }
 
+    void Disconnect(detail::ConnectionToken token)
+    {
+        this->Base::Disconnect(token);
+
+        if (!this->HasConnection())
+        {
+            this->upstreamConnection_.reset();
+        }
+    }
+
     template<typename, typename>
     friend class Signal;
 
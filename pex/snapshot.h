@@ -0,0 +1,127 @@
+/**
+  * @file snapshot.h
+  *
+  * @brief An immutable, shared value for models with large payloads.
+  *
+  * A model::Value<Snapshot<T>> stores a std::shared_ptr<const T>. Setting
+  * the model allocates one new snapshot, and observers, controls, and other
+  * threads that keep the value share that allocation instead of copying T.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include "pex/detail/value.h"
+#include "pex/model_value.h"
+
+
+namespace pex
+{
+
+
+template<typename T>
+class Snapshot
+{
+public:
+    using Type = T;
+    using Pointer = std::shared_ptr<const T>;
+
+    Snapshot()
+        :
+        pointer_(std::make_shared<const T>())
+    {
+
+    }
+
+    Snapshot(const T &value)
+        :
+        pointer_(std::make_shared<const T>(value))
+    {
+
+    }
+
+    Snapshot(T &&value)
+        :
+        pointer_(std::make_shared<const T>(std::move(value)))
+    {
+
+    }
+
+    explicit Snapshot(Pointer pointer)
+        :
+        pointer_(std::move(pointer))
+    {
+        if (!this->pointer_)
+        {
+            throw std::logic_error("Snapshot requires a value");
+        }
+    }
+
+    const T & Get() const
+    {
+        return *this->pointer_;
+    }
+
+    const T & operator*() const
+    {
+        return *this->pointer_;
+    }
+
+    const T * operator->() const
+    {
+        return this->pointer_.get();
+    }
+
+    operator const T & () const
+    {
+        return *this->pointer_;
+    }
+
+    // Share ownership of the snapshot beyond the lifetime of this value.
+    const Pointer & GetPointer() const
+    {
+        return this->pointer_;
+    }
+
+    bool IsSharedWith(const Snapshot &other) const
+    {
+        return this->pointer_ == other.pointer_;
+    }
+
+    // Snapshots compare by value, so SetIfChanged can skip equal payloads.
+    // A shared snapshot is equal to itself without comparing T.
+    bool operator==(const Snapshot &other) const
+        requires detail::HasEqualTo<T>
+    {
+        return this->pointer_ == other.pointer_
+            || *this->pointer_ == *other.pointer_;
+    }
+
+private:
+    Pointer pointer_;
+};
+
+
+namespace model
+{
+
+
+template<typename T>
+using SnapshotValue = Value_<Snapshot<T>, NoFilter>;
+
+// Get copies the snapshot pointer while holding the lock, so readers on
+// other threads only wait for a reference count.
+template<typename T>
+using LockedSnapshotValue = LockedValue<Snapshot<T>, NoFilter>;
+
+
+} // end namespace model
+
+
+} // end namespace pex
@@ -5,6 +5,7 @@
 #include "pex/detail/value_connection.h"
 #include "pex/detail/signal_connection.h"
 #include "pex/reference.h"
+#include "pex/notify_policy.h"
 // #include "pex/promote_control.h"
 
 
@@ -83,7 +84,12 @@ struct MakeConnection
     using Notifier =
         ValueNotifier
             <
-                detail::NotifyOne<Connection, typename Control::Access>
+                detail::NotifyOne
+                <
+                    Connection,
+                    typename Control::Access,
+                    NotifyPolicyT<Control>
+                >
             >;
 
     using Callable = typename Connection::Callable;
@@ -101,7 +107,15 @@ struct MakeConnection
     using Connection = detail::SignalConnection<Observer>;
 
     using Notifier =
-        SignalNotifier<detail::NotifyOne<Connection, GetAndSetTag>>;
+        SignalNotifier
+        <
+            detail::NotifyOne
+            <
+                Connection,
+                GetAndSetTag,
+                NotifyPolicyT<Control>
+            >
+        >;
 
     using Callable = typename Connection::Callable;
 };
@@ -0,0 +1,88 @@
+/**
+  * @file trace.h
+  *
+  * @brief Decodes the binary trace recorded when pex is built with
+  * ENABLE_PEX_TRACE.
+  *
+  * Each thread records into its own ring buffer, keeping the most recent
+  * traceCapacity events. Recording takes no locks and formats nothing.
+  * Names are resolved when the trace is reported.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+// #define ENABLE_PEX_TRACE
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+
+namespace pex
+{
+
+
+// The number of events retained for each thread.
+inline constexpr size_t traceCapacity = 4096;
+
+
+enum class TraceKind: uint32_t
+{
+    // A PEX_LOG or PEX_CONCISE_LOG statement.
+    log,
+
+    // A node began notifying its observers.
+    notify,
+
+    // A node called one observer.
+    callback
+};
+
+
+// The source location of a trace point, stored once per call site.
+struct TraceSite
+{
+    const char *file;
+    const char *function;
+    int line;
+};
+
+
+struct TraceRecord
+{
+    // Time since the steady_clock epoch.
+    std::chrono::nanoseconds time;
+
+    // Threads are numbered in the order they first record an event.
+    size_t thread;
+
+    TraceKind kind;
+    const TraceSite *site;
+
+    // For log events, the first pointer argument, and the first integer
+    // argument. For notify and callback events, the node or the observer.
+    const void *address;
+    uint64_t payload;
+};
+
+
+/** The events retained by every thread, ordered by time. **/
+std::vector<TraceRecord> CollectTrace();
+
+/** Write one line for each record, with names from LookupPexName. **/
+void ReportTrace(std::ostream &output, const std::vector<TraceRecord> &trace);
+
+/** Collect and report the trace. **/
+void ReportTrace(std::ostream &output);
+
+/** Discard the recorded events, and the buffers of threads that exited. **/
+void ResetTrace();
+
+
+} // end namespace pex
@@ -16,7 +16,12 @@
 #pragma once
 
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "pex/argument.h"
 #include "pex/detail/require_has_value.h"
+#include "pex/propagation.h"
 
 
 namespace pex
@@ -55,6 +60,14 @@ public:
         this->model_->SetWithoutNotify_(value);
     }
 
+    Transaction(Model &model, Type &&value) requires MovableArgument<Type>
+        :
+        model_(&model),
+        oldValue_(model.Get())
+    {
+        this->model_->SetWithoutNotify_(std::move(value));
+    }
+
     Transaction(const Transaction &) = delete;
     Transaction & operator=(const Transaction &) = delete;
 
@@ -65,6 +78,10 @@ public:
             "Direct access to underlying value is incompatible with filters.");
 
         REQUIRE_HAS_VALUE(this->model_);
+
+        // The value may be changed through the reference.
+        this->model_->generation_.Bump();
+
         return this->model_->value_;
     }
 
@@ -80,11 +97,18 @@ public:
         this->model_->SetWithoutNotify_(value);
     }
 
+    void Set(Type &&value) requires MovableArgument<Type>
+    {
+        REQUIRE_HAS_VALUE(this->model_);
+        this->model_->SetWithoutNotify_(std::move(value));
+    }
+
     void Commit()
     {
         if (nullptr != this->model_)
         {
-            this->model_->Notify_(this->model_->value_);
+            // Containers also send their element observers a reset.
+            this->model_->Notify();
             this->model_ = nullptr;
         }
     }
@@ -94,7 +118,7 @@ public:
         // Revert on destruction
         if (nullptr != this->model_)
         {
-            this->model_->SetWithoutNotify_(this->oldValue_);
+            this->model_->SetWithoutNotify_(std::move(this->oldValue_));
         }
     }
 
@@ -103,4 +127,136 @@ public:
 };
 
 
+/**
+ ** Stages changes to any number of models, of any type, as one unit.
+ **
+ ** Each model is changed without publishing when it is added. Commit
+ ** publishes every change in a single Propagation, so observers only see the
+ ** new values together, and nodes derived from several of the models are
+ ** notified once, after the nodes they depend on.
+ **
+ ** If the TransactionGroup goes out of scope without a call to Commit, every
+ ** model is reverted, in the reverse order that they were added, and nothing
+ ** is published.
+ **
+ **/
+class TransactionGroup
+{
+public:
+    TransactionGroup()
+        :
+        staged_(),
+        byModel_()
+    {
+
+    }
+
+    TransactionGroup(const TransactionGroup &) = delete;
+    TransactionGroup & operator=(const TransactionGroup &) = delete;
+
+    ~TransactionGroup()
+    {
+        // Revert on destruction
+        while (!this->staged_.empty())
+        {
+            this->staged_.pop_back();
+        }
+    }
+
+    /** Returns the transaction for model, staging it if it is new. **/
+    template<typename Model>
+    Transaction<Model> & Add(Model &model)
+    {
+        // A model and its first member may share an address, so the type
+        // of the staged transaction is checked as well.
+        auto [first, last] = this->byModel_.equal_range(&model);
+
+        for (auto found = first; found != last; ++found)
+        {
+            auto existing = dynamic_cast<Staged_<Model> *>(found->second);
+
+            if (existing)
+            {
+                return existing->transaction;
+            }
+        }
+
+        auto staged = std::make_unique<Staged_<Model>>(model);
+        auto &result = staged->transaction;
+        this->byModel_.emplace(&model, staged.get());
+        this->staged_.push_back(std::move(staged));
+
+        return result;
+    }
+
+    template<typename Model>
+    void Set(Model &model, Argument<typename Model::Type> value)
+    {
+        this->Add(model).Set(value);
+    }
+
+    template<typename Model>
+    void Set(Model &model, typename Model::Type &&value)
+        requires MovableArgument<typename Model::Type>
+    {
+        this->Add(model).Set(std::move(value));
+    }
+
+    size_t GetCount() const
+    {
+        return this->staged_.size();
+    }
+
+    void Commit()
+    {
+        // A Propagation already in scope delivers these notifications
+        // with its own.
+        Propagation propagation;
+
+        for (auto &staged: this->staged_)
+        {
+            staged->Commit();
+        }
+
+        this->staged_.clear();
+        this->byModel_.clear();
+
+        // Observers may throw, so deliver before the destructor.
+        propagation.Flush();
+    }
+
+private:
+    class StagedBase_
+    {
+    public:
+        virtual ~StagedBase_() = default;
+        virtual void Commit() = 0;
+    };
+
+    template<typename Model>
+    class Staged_: public StagedBase_
+    {
+    public:
+        Staged_(Model &model)
+            :
+            transaction(model)
+        {
+
+        }
+
+        void Commit() override
+        {
+            this->transaction.Commit();
+        }
+
+        Transaction<Model> transaction;
+    };
+
+    std::vector<std::unique_ptr<StagedBase_>> staged_;
+
+    // Finds the staged transaction of a model without searching staged_.
+    std::unordered_multimap<const void *, StagedBase_ *> byModel_;
+};
+
+
 } // namespace pex
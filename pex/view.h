@@ -0,0 +1,321 @@
+/**
+  * @file view.h
+  *
+  * @brief Borrowed, read-only access to the value stored in a model.
+  *
+  * GetRef returns a const reference to the stored value. A View also holds
+  * that reference, and in debug builds, changing the value while the View
+  * exists throws std::logic_error.
+  *
+  * @author Jive Helix (jivehelix@gmail.com)
+  * @date 16 Oct 2026
+  * @copyright Jive Helix
+  * Licensed under the MIT license. See LICENSE file.
+**/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+
+namespace pex
+{
+
+
+namespace detail
+{
+
+
+#ifndef NDEBUG
+
+// Counts the Views of a value, so that changes can be refused while any
+// exist. A value held by a container also refuses changes while the
+// container is viewed.
+class Borrows
+{
+public:
+    Borrows()
+        :
+        count_(0),
+        parent_(nullptr)
+    {
+
+    }
+
+    // A copy of a model value has not been borrowed.
+    Borrows(const Borrows &)
+        :
+        count_(0),
+        parent_(nullptr)
+    {
+
+    }
+
+    Borrows & operator=(const Borrows &)
+    {
+        return *this;
+    }
+
+    void Borrow() const
+    {
+        ++this->count_;
+    }
+
+    void Return() const
+    {
+        --this->count_;
+    }
+
+    void RequireNone() const
+    {
+        if (this->count_ > 0)
+        {
+            throw std::logic_error("Cannot modify a value while it is viewed");
+        }
+
+        if (this->parent_)
+        {
+            this->parent_->RequireNone();
+        }
+    }
+
+    void SetParent(const Borrows *parent)
+    {
+        this->parent_ = parent;
+    }
+
+private:
+    mutable std::atomic<size_t> count_;
+    const Borrows *parent_;
+};
+
+#else
+
+class Borrows
+{
+public:
+    void Borrow() const {}
+    void Return() const {}
+    void RequireNone() const {}
+    void SetParent(const Borrows *) {}
+};
+
+#endif
+
+
+// Holds a borrow of a value for its lifetime.
+class Borrow
+{
+public:
+    Borrow(const Borrows &borrows)
+        :
+        borrows_(&borrows)
+    {
+        this->borrows_->Borrow();
+    }
+
+    Borrow(const Borrow &other)
+        :
+        borrows_(other.borrows_)
+    {
+        this->borrows_->Borrow();
+    }
+
+    Borrow & operator=(const Borrow &other)
+    {
+        other.borrows_->Borrow();
+        this->borrows_->Return();
+        this->borrows_ = other.borrows_;
+
+        return *this;
+    }
+
+    ~Borrow()
+    {
+        this->borrows_->Return();
+    }
+
+private:
+    const Borrows *borrows_;
+};
+
+
+// Nodes that can refuse changes while a container that holds them is
+// viewed.
+template<typename T>
+concept HasBorrowsParent = requires (T &t, const Borrows *parent)
+{
+    { t.SetBorrowsParent(parent) };
+};
+
+
+template<typename T>
+concept HasGetRef = requires (const T &t)
+{
+    t.GetRef();
+};
+
+
+template<typename T>
+concept HasView = requires (const T &t)
+{
+    t.View();
+};
+
+
+} // end namespace detail
+
+
+/**
+ ** A const reference to a model's value.
+ **
+ ** The View must not outlive the model.
+ **/
+template<typename T>
+class View
+{
+public:
+    View(const T &value, const detail::Borrows &borrows)
+        :
+        value_(&value),
+        borrow_(borrows)
+    {
+
+    }
+
+    const T & Get() const
+    {
+        return *this->value_;
+    }
+
+    const T & operator*() const
+    {
+        return *this->value_;
+    }
+
+    const T * operator->() const
+    {
+        return this->value_;
+    }
+
+private:
+    const T *value_;
+    detail::Borrow borrow_;
+};
+
+
+/**
+ ** Indexed access to the values of a list's items, without copying them.
+ **
+ ** In debug builds, removing an item, or setting the value of an item, while
+ ** the ListView exists throws std::logic_error.
+ **/
+template<typename ListModel>
+class ListView
+{
+public:
+    using Item = typename ListModel::Item;
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Item;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Item *;
+        using reference = const Item &;
+
+        Iterator()
+            :
+            list_(nullptr),
+            index_(0)
+        {
+
+        }
+
+        Iterator(const ListModel &list, size_t index)
+            :
+            list_(&list),
+            index_(index)
+        {
+
+        }
+
+        reference operator*() const
+        {
+            return this->list_->at(this->index_).GetRef();
+        }
+
+        pointer operator->() const
+        {
+            return &this->operator*();
+        }
+
+        Iterator & operator++()
+        {
+            ++this->index_;
+
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++this->index_;
+
+            return result;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return this->list_ == other.list_ && this->index_ == other.index_;
+        }
+
+    private:
+        const ListModel *list_;
+        size_t index_;
+    };
+
+    ListView(const ListModel &list, const detail::Borrows &borrows)
+        :
+        list_(&list),
+        borrow_(borrows)
+    {
+
+    }
+
+    size_t size() const
+    {
+        return this->list_->size();
+    }
+
+    bool empty() const
+    {
+        return this->list_->empty();
+    }
+
+    const Item & operator[](size_t index) const
+    {
+        return this->list_->at(index).GetRef();
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(*this->list_, 0);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(*this->list_, this->list_->size());
+    }
+
+private:
+    const ListModel *list_;
+    detail::Borrow borrow_;
+};
+
+
+} // end namespace pex
@@ -0,0 +1,261 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "pex/async_endpoint.h"
+
+
+namespace
+{
+
+
+using Model = pex::model::Value<int>;
+
+
+class Consumer
+{
+public:
+    Consumer()
+        :
+        values(),
+        signalCount(0),
+        threadIds()
+    {
+        PEX_NAME("Consumer");
+    }
+
+    ~Consumer()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    void OnValue(int value)
+    {
+        std::lock_guard lock(this->mutex_);
+        this->values.push_back(value);
+        this->threadIds.push_back(std::this_thread::get_id());
+        this->received_.notify_all();
+    }
+
+    void OnValueOrThrow(int value)
+    {
+        if (value < 0)
+        {
+            throw std::runtime_error("negative value");
+        }
+
+        this->OnValue(value);
+    }
+
+    void OnSignal()
+    {
+        ++this->signalCount;
+    }
+
+    void WaitFor(size_t count)
+    {
+        std::unique_lock lock(this->mutex_);
+
+        this->received_.wait(
+            lock,
+            [this, count]()
+            {
+                return this->values.size() >= count;
+            });
+    }
+
+    std::vector<int> values;
+    std::atomic<int> signalCount;
+    std::vector<std::thread::id> threadIds;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable received_;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("AsyncEndpoint waits for the executor", "[async]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    pex::QueueExecutor executor;
+    Consumer consumer;
+
+    pex::AsyncEndpoint<Consumer, Model> endpoint(
+        &consumer,
+        model,
+        &Consumer::OnValue,
+        executor);
+
+    model.Set(1);
+    model.Set(2);
+    model.Set(3);
+
+    REQUIRE(consumer.values.empty());
+    REQUIRE(endpoint.GetPendingCount() == 3);
+
+    // One task drains all of the values, in order.
+    REQUIRE(executor.Pump() == 1);
+    REQUIRE(consumer.values == std::vector<int>{1, 2, 3});
+    REQUIRE(endpoint.GetPendingCount() == 0);
+
+    model.Set(4);
+    REQUIRE(executor.Pump() == 1);
+    REQUIRE(consumer.values == std::vector<int>{1, 2, 3, 4});
+}
+
+
+TEST_CASE("AsyncEndpoint can keep only the latest value", "[async]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    pex::QueueExecutor executor;
+    Consumer consumer;
+
+    pex::AsyncEndpoint<Consumer, Model> endpoint(
+        &consumer,
+        model,
+        &Consumer::OnValue,
+        executor,
+        pex::Coalesce::latest);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        model.Set(i);
+    }
+
+    REQUIRE(endpoint.GetPendingCount() == 1);
+    executor.Pump();
+    REQUIRE(consumer.values == std::vector<int>{99});
+}
+
+
+TEST_CASE("AsyncEndpoint coalesces signals", "[async]")
+{
+    pex::model::Signal signal;
+    PEX_ROOT(signal);
+
+    pex::QueueExecutor executor;
+    Consumer consumer;
+
+    pex::AsyncEndpoint<Consumer, pex::model::Signal> endpoint(
+        &consumer,
+        signal,
+        &Consumer::OnSignal,
+        executor,
+        pex::Coalesce::latest);
+
+    signal.Trigger();
+    signal.Trigger();
+    executor.Pump();
+
+    REQUIRE(consumer.signalCount == 1);
+}
+
+
+TEST_CASE("AsyncEndpoint keeps draining after the observer throws", "[async]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    pex::QueueExecutor executor;
+    Consumer consumer;
+
+    {
+        pex::AsyncEndpoint<Consumer, Model> endpoint(
+            &consumer,
+            model,
+            &Consumer::OnValueOrThrow,
+            executor);
+
+        model.Set(1);
+        model.Set(-1);
+        model.Set(2);
+
+        REQUIRE_THROWS_AS(executor.Pump(), std::runtime_error);
+        REQUIRE(consumer.values == std::vector<int>{1});
+
+        // The rest of the queue was scheduled again.
+        REQUIRE(endpoint.GetPendingCount() == 1);
+        REQUIRE(executor.GetPendingCount() == 1);
+        REQUIRE(executor.Pump() == 1);
+        REQUIRE(consumer.values == std::vector<int>{1, 2});
+
+        model.Set(3);
+        REQUIRE(executor.Pump() == 1);
+        REQUIRE(consumer.values == std::vector<int>{1, 2, 3});
+
+        model.Set(-2);
+        REQUIRE_THROWS_AS(executor.Pump(), std::runtime_error);
+
+        // Destruction cancels the queue without waiting on the failed
+        // callback.
+    }
+
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE("Destroying an AsyncEndpoint discards its queue", "[async]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    pex::QueueExecutor executor;
+    Consumer consumer;
+
+    {
+        pex::AsyncEndpoint<Consumer, Model> endpoint(
+            &consumer,
+            model,
+            &Consumer::OnValue,
+            executor);
+
+        model.Set(1);
+        REQUIRE(executor.GetPendingCount() == 1);
+    }
+
+    REQUIRE(!model.HasConnections());
+
+    // The task outlives the endpoint, but delivers nothing.
+    REQUIRE(executor.Pump() == 1);
+    REQUIRE(consumer.values.empty());
+}
+
+
+TEST_CASE("AsyncEndpoint delivers on the executor's thread", "[async]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    Consumer consumer;
+    pex::ThreadExecutor executor;
+
+    pex::AsyncEndpoint<Consumer, Model> endpoint(
+        &consumer,
+        model,
+        &Consumer::OnValue,
+        executor);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        model.Set(i);
+    }
+
+    consumer.WaitFor(10);
+
+    REQUIRE(consumer.values == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+    for (auto &threadId: consumer.threadIds)
+    {
+        REQUIRE(threadId != std::this_thread::get_id());
+    }
+}
@@ -0,0 +1,282 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "pex/model_value.h"
+#include "pex/control_value.h"
+
+
+namespace
+{
+
+
+using Model = pex::model::ConcurrentValue<int>;
+using Control = pex::control::Value<Model>;
+
+
+struct Counter
+{
+    Counter()
+        :
+        count(0),
+        isAlive(true),
+        calledWhileDead(false)
+    {
+        PEX_NAME("Counter");
+    }
+
+    ~Counter()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    static void OnValue(void *context, int)
+    {
+        auto self = static_cast<Counter *>(context);
+
+        if (!self->isAlive)
+        {
+            self->calledWhileDead = true;
+        }
+
+        ++self->count;
+    }
+
+    std::atomic<int> count;
+    std::atomic<bool> isAlive;
+    std::atomic<bool> calledWhileDead;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Controls adopt the notify policy of the model", "[concurrent]")
+{
+    STATIC_REQUIRE(
+        std::is_same_v<pex::NotifyPolicyT<Model>, pex::ConcurrentTag>);
+
+    STATIC_REQUIRE(
+        std::is_same_v<pex::NotifyPolicyT<Control>, pex::ConcurrentTag>);
+
+    STATIC_REQUIRE(
+        std::is_same_v
+        <
+            pex::NotifyPolicyT<pex::model::Value<int>>,
+            pex::SingleThreadedTag
+        >);
+}
+
+
+TEST_CASE("Concurrent notifiers connect and disconnect", "[concurrent]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    Counter first;
+    Counter second;
+
+    auto firstToken = model.Connect(&first, &Counter::OnValue);
+    Control control(model);
+    control.Connect(&second, &Counter::OnValue);
+
+    REQUIRE(model.HasConnection(firstToken));
+    REQUIRE(model.GetNotifierCount() == 2);
+
+    model.Set(1);
+    REQUIRE(first.count == 1);
+    REQUIRE(second.count == 1);
+    REQUIRE(control.Get() == 1);
+
+    model.Disconnect(firstToken);
+    REQUIRE(!model.HasConnection(firstToken));
+
+    model.Set(2);
+    REQUIRE(first.count == 1);
+    REQUIRE(second.count == 2);
+
+    control.Disconnect(&second);
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE(
+    "Concurrent notifiers allow changes from callbacks",
+    "[concurrent]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    Counter first;
+    Counter second;
+
+    struct Reconnector
+    {
+        static void OnValue(void *context, int)
+        {
+            auto self = static_cast<Reconnector *>(context);
+            self->model.Disconnect(self);
+            self->model.Connect(self->counter, &Counter::OnValue);
+        }
+
+        Model &model;
+        Counter *counter;
+    };
+
+    Reconnector reconnector{model, &second};
+    PEX_ROOT(reconnector);
+
+    model.Connect(&reconnector, &Reconnector::OnValue);
+    model.Connect(&first, &Counter::OnValue);
+
+    // The connection made from the callback is notified next time.
+    model.Set(1);
+    REQUIRE(first.count == 1);
+    REQUIRE(second.count == 0);
+    REQUIRE(!model.HasObserver(&reconnector));
+
+    model.Set(2);
+    REQUIRE(first.count == 2);
+    REQUIRE(second.count == 1);
+
+    model.Disconnect(&first);
+    model.Disconnect(&second);
+    REQUIRE(!model.HasConnections());
+    PEX_CLEAR_NAME(&reconnector);
+}
+
+
+TEST_CASE(
+    "Disconnected observers are not called from another thread",
+    "[concurrent]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    Counter steady;
+    model.Connect(&steady, &Counter::OnValue);
+
+    std::atomic<bool> isRunning(true);
+
+    std::thread notifier(
+        [&]()
+        {
+            int value = 0;
+
+            while (isRunning)
+            {
+                model.Set(value++);
+            }
+        });
+
+    std::vector<std::unique_ptr<Counter>> retired;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        auto counter = std::make_unique<Counter>();
+        auto token = model.Connect(counter.get(), &Counter::OnValue);
+
+        while (counter->count == 0)
+        {
+            std::this_thread::yield();
+        }
+
+        model.Disconnect(token);
+
+        // Once Disconnect returns, the callback must not be running or run
+        // again.
+        counter->isAlive = false;
+        retired.push_back(std::move(counter));
+    }
+
+    isRunning = false;
+    notifier.join();
+
+    for (auto &counter: retired)
+    {
+        REQUIRE(!counter->calledWhileDead);
+    }
+
+    REQUIRE(steady.count > 0);
+    model.Disconnect(&steady);
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE(
+    "Disconnecting from another node's callback waits for its readers",
+    "[concurrent]")
+{
+    Model first;
+    Model second;
+    PEX_ROOT(first);
+    PEX_ROOT(second);
+
+    struct Blocker
+    {
+        static void OnValue(void *context, int)
+        {
+            auto self = static_cast<Blocker *>(context);
+            self->hasEntered = true;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+            if (!self->isAlive)
+            {
+                self->calledWhileDead = true;
+            }
+        }
+
+        std::atomic<bool> hasEntered{false};
+        std::atomic<bool> isAlive{true};
+        std::atomic<bool> calledWhileDead{false};
+    };
+
+    struct Disconnector
+    {
+        static void OnValue(void *context, int)
+        {
+            auto self = static_cast<Disconnector *>(context);
+
+            // Called from a notification of first, so only a reader of
+            // second on this thread could excuse Disconnect from waiting.
+            self->model.Disconnect(self->blocker);
+            self->blocker->isAlive = false;
+        }
+
+        Model &model;
+        Blocker *blocker;
+    };
+
+    Blocker blocker;
+    PEX_ROOT(blocker);
+
+    Disconnector disconnector{second, &blocker};
+    PEX_ROOT(disconnector);
+
+    second.Connect(&blocker, &Blocker::OnValue);
+    first.Connect(&disconnector, &Disconnector::OnValue);
+
+    std::thread notifier(
+        [&]()
+        {
+            second.Set(1);
+        });
+
+    while (!blocker.hasEntered)
+    {
+        std::this_thread::yield();
+    }
+
+    first.Set(1);
+    notifier.join();
+
+    REQUIRE(!blocker.calledWhileDead);
+
+    first.Disconnect(&disconnector);
+    REQUIRE(!second.HasConnections());
+    PEX_CLEAR_NAME(&blocker);
+    PEX_CLEAR_NAME(&disconnector);
+}
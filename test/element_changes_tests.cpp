@@ -0,0 +1,207 @@
+#include <catch2/catch.hpp>
+#include <map>
+#include <string>
+#include <vector>
+#include <pex/model_value.h>
+#include <pex/control_value.h>
+#include <pex/selectors.h>
+#include <pex/reference.h>
+#include <pex/propagation.h>
+#include <pex/transaction.h>
+
+
+namespace
+{
+
+
+template<typename Model>
+struct ElementRecorder
+{
+    using ElementChanges = typename Model::ElementChanges;
+    using Type = typename Model::Type;
+
+    ElementRecorder(Model &model)
+        :
+        model_(model),
+        changes(),
+        wholeCount(0)
+    {
+        PEX_NAME("ElementRecorder");
+        this->model_.ConnectElements(this, &ElementRecorder::OnElements);
+        this->model_.Connect(this, &ElementRecorder::OnWhole);
+    }
+
+    ~ElementRecorder()
+    {
+        this->model_.DisconnectElements(this);
+        this->model_.Disconnect(this);
+        PEX_CLEAR_NAME(this);
+    }
+
+    static void OnElements(void *context, const ElementChanges &changes)
+    {
+        static_cast<ElementRecorder *>(context)->changes.push_back(changes);
+    }
+
+    static void OnWhole(void *context, const Type &)
+    {
+        ++static_cast<ElementRecorder *>(context)->wholeCount;
+    }
+
+    Model &model_;
+    std::vector<ElementChanges> changes;
+    size_t wholeCount;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("ValueContainer sends only the changed element", "[element_changes]")
+{
+    using Model = pex::ModelSelector<std::vector<int>>;
+
+    Model model(std::vector<int>(100, 0));
+    PEX_ROOT(model);
+
+    ElementRecorder<Model> recorder(model);
+
+    model.Set(42, 7);
+
+    REQUIRE(recorder.wholeCount == 1);
+    REQUIRE(recorder.changes.size() == 1);
+    REQUIRE(!recorder.changes[0].isReset);
+    REQUIRE(recorder.changes[0].elements.size() == 1);
+    REQUIRE(recorder.changes[0].elements[0].first == 42);
+    REQUIRE(recorder.changes[0].elements[0].second == 7);
+
+    // Replacing the whole container is a reset.
+    model.Set(std::vector<int>(3, 1));
+
+    REQUIRE(recorder.wholeCount == 2);
+    REQUIRE(recorder.changes.size() == 2);
+    REQUIRE(recorder.changes[1].isReset);
+    REQUIRE(recorder.changes[1].elements.empty());
+}
+
+
+TEST_CASE("KeyValueContainer sends the changed key", "[element_changes]")
+{
+    using Model = pex::ModelSelector<std::map<std::string, int>>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    ElementRecorder<Model> recorder(model);
+
+    model.Set("foo", 42);
+
+    REQUIRE(recorder.wholeCount == 1);
+    REQUIRE(recorder.changes.size() == 1);
+    REQUIRE(recorder.changes[0].elements.size() == 1);
+    REQUIRE(recorder.changes[0].elements[0].first == "foo");
+    REQUIRE(recorder.changes[0].elements[0].second == 42);
+}
+
+
+TEST_CASE("Defer batches element changes", "[element_changes]")
+{
+    using Model = pex::ModelSelector<std::vector<int>>;
+
+    Model model(std::vector<int>(10, 0));
+    PEX_ROOT(model);
+
+    ElementRecorder<Model> recorder(model);
+
+    {
+        auto defer = pex::MakeDefer(model);
+        defer.Set(1, 10);
+        defer.Set(5, 50);
+        REQUIRE(recorder.changes.empty());
+    }
+
+    REQUIRE(recorder.wholeCount == 1);
+    REQUIRE(recorder.changes.size() == 1);
+    REQUIRE(!recorder.changes[0].isReset);
+    REQUIRE(recorder.changes[0].elements.size() == 2);
+    REQUIRE(recorder.changes[0].elements[0].first == 1);
+    REQUIRE(recorder.changes[0].elements[1].first == 5);
+    REQUIRE(recorder.changes[0].elements[1].second == 50);
+
+    {
+        // Setting the whole container discards the elements.
+        auto defer = pex::MakeDefer(model);
+        defer.Set(2, 20);
+        defer.Set(std::vector<int>(4, 3));
+    }
+
+    REQUIRE(recorder.wholeCount == 2);
+    REQUIRE(recorder.changes.size() == 2);
+    REQUIRE(recorder.changes[1].isReset);
+}
+
+
+TEST_CASE("Controls connect to element changes", "[element_changes]")
+{
+    using Model = pex::ModelSelector<std::vector<int>>;
+    using Control = pex::ControlSelector<std::vector<int>>;
+
+    Model model(std::vector<int>(4, 0));
+    PEX_ROOT(model);
+
+    Control control(model);
+    ElementRecorder<Control> recorder(control);
+
+    control.Set(3, 9);
+
+    REQUIRE(recorder.changes.size() == 1);
+    REQUIRE(recorder.changes[0].elements[0].first == 3);
+    REQUIRE(model.Get()[3] == 9);
+}
+
+
+TEST_CASE("Scheduled element changes become a reset", "[element_changes]")
+{
+    using Model = pex::ModelSelector<std::vector<int>>;
+
+    Model model(std::vector<int>(4, 0));
+    PEX_ROOT(model);
+
+    ElementRecorder<Model> recorder(model);
+
+    {
+        pex::Propagation propagation;
+        model.Set(0, 1);
+        model.Set(1, 2);
+    }
+
+    REQUIRE(recorder.changes.size() == 1);
+    REQUIRE(recorder.changes[0].isReset);
+    REQUIRE(model.Get() == std::vector<int>{1, 2, 0, 0});
+}
+
+
+TEST_CASE("Transaction commit resets element observers", "[element_changes]")
+{
+    using Model = pex::ModelSelector<std::vector<int>>;
+
+    Model model(std::vector<int>(10, 0));
+    PEX_ROOT(model);
+
+    ElementRecorder<Model> recorder(model);
+
+    {
+        pex::Transaction<Model> transaction(model);
+        (*transaction)[3] = 30;
+        (*transaction).push_back(11);
+        transaction.Commit();
+    }
+
+    REQUIRE(model.size() == 11);
+    REQUIRE(model[3] == 30);
+    REQUIRE(recorder.wholeCount == 1);
+
+    // The changed elements are not known, so element observers reset.
+    REQUIRE(recorder.changes.size() == 1);
+    REQUIRE(recorder.changes[0].isReset);
+}
@@ -0,0 +1,223 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include <pex/model_value.h>
+#include <pex/control_value.h>
+#include <pex/group.h>
+#include <pex/list.h>
+#include <pex/range.h>
+#include <pex/interface.h>
+#include <pex/transaction.h>
+
+
+namespace generation
+{
+
+
+template<typename T>
+struct ShipFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::name, "name"),
+        fields::Field(&T::speed, "speed"),
+        fields::Field(&T::cargo, "cargo"));
+};
+
+
+template<template<typename> typename T>
+struct ShipTemplate
+{
+    T<std::string> name;
+    T<double> speed;
+    T<pex::List<int, 2>> cargo;
+
+    static constexpr auto fields = ShipFields<ShipTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Ship";
+};
+
+
+using ShipGroup = pex::Group<ShipFields, ShipTemplate>;
+using Ship = typename ShipGroup::Plain;
+using ShipModel = typename ShipGroup::Model;
+using ShipControl = typename ShipGroup::template Control<ShipModel>;
+
+
+} // end namespace generation
+
+
+TEST_CASE("Value generation advances on every change", "[generation]")
+{
+    using Model = pex::model::Value<int>;
+    using Control = pex::control::Value<Model>;
+
+    Model model(1);
+    PEX_ROOT(model);
+
+    Control control(model);
+
+    auto generation = control.GetGeneration();
+    REQUIRE(generation == model.GetGeneration());
+
+    // Notify without a change does not advance the generation.
+    model.Notify();
+    REQUIRE(model.GetGeneration() == generation);
+
+    model.Set(2);
+    REQUIRE(control.GetGeneration() > generation);
+    generation = control.GetGeneration();
+
+    // A skipped Set is not a change.
+    REQUIRE(!control.SetIfChanged(2));
+    REQUIRE(control.GetGeneration() == generation);
+
+    REQUIRE(control.SetIfChanged(3));
+    REQUIRE(control.GetGeneration() > generation);
+    generation = control.GetGeneration();
+
+    {
+        // An uncommitted Transaction changes the value, and changes it back.
+        pex::Transaction<Model> transaction(model, 4);
+        REQUIRE(model.GetGeneration() > generation);
+    }
+
+    REQUIRE(model.Get() == 3);
+    REQUIRE(model.GetGeneration() > generation);
+}
+
+
+TEST_CASE("List generation counts items and size", "[generation]")
+{
+    using List = pex::List<int, 2>;
+    using ListModel = typename List::Model;
+    using ListControl = typename List::template Control<ListModel>;
+
+    ListModel listModel;
+    PEX_ROOT(listModel);
+
+    ListControl listControl(listModel);
+
+    auto generation = listControl.GetGeneration();
+
+    listModel[1].Set(42);
+    REQUIRE(listControl.GetGeneration() > generation);
+    generation = listControl.GetGeneration();
+
+    listModel.Append(7);
+    REQUIRE(listControl.GetGeneration() > generation);
+    generation = listControl.GetGeneration();
+
+    // Erasing an item removes its own count, but the list still advances.
+    listModel.Erase(1);
+    REQUIRE(listControl.GetGeneration() > generation);
+    generation = listControl.GetGeneration();
+
+    listModel.count.Set(1);
+    REQUIRE(listControl.GetGeneration() > generation);
+    generation = listControl.GetGeneration();
+
+    REQUIRE(listModel.GetGeneration() == generation);
+}
+
+
+TEST_CASE("Range items advance the generation of their list", "[generation]")
+{
+    using List =
+        pex::List<pex::MakeRange<int, pex::Limit<0>, pex::Limit<10>>, 2>;
+
+    using ListModel = typename List::Model;
+
+    ListModel listModel;
+    PEX_ROOT(listModel);
+
+    auto generation = listModel.GetGeneration();
+    REQUIRE(listModel.Get() == std::vector<int>{0, 0});
+
+    listModel[1].Set(5);
+    REQUIRE(listModel.GetGeneration() > generation);
+    REQUIRE(listModel.Get() == std::vector<int>{0, 5});
+    generation = listModel.GetGeneration();
+
+    // A change to the limits is a change to the item.
+    listModel[1].SetMaximum(4);
+    REQUIRE(listModel.GetGeneration() > generation);
+    REQUIRE(listModel.Get() == std::vector<int>{0, 4});
+}
+
+
+TEST_CASE("Group generation aggregates its members", "[generation]")
+{
+    using namespace generation;
+
+    ShipModel model;
+    PEX_ROOT(model);
+
+    ShipControl control(model);
+
+    auto generation = control.GetGeneration();
+    REQUIRE(model.GetGeneration() == generation);
+
+    model.speed.Set(12.0);
+    REQUIRE(control.GetGeneration() > generation);
+    generation = control.GetGeneration();
+
+    control.cargo[0].Set(3);
+    REQUIRE(model.GetGeneration() > generation);
+    generation = model.GetGeneration();
+
+    model.cargo.Append(4);
+    REQUIRE(model.GetGeneration() > generation);
+    generation = model.GetGeneration();
+
+    model.Set(Ship{"Arrow", 5.0, {1, 2}});
+    REQUIRE(control.GetGeneration() > generation);
+    generation = control.GetGeneration();
+
+    // Reading does not change anything.
+    auto ship = control.Get();
+    REQUIRE(ship.name == "Arrow");
+    REQUIRE(control.GetGeneration() == generation);
+}
+
+
+TEST_CASE("List generation follows changes deep within its items", "[generation]")
+{
+    using namespace generation;
+
+    using Fleet = pex::List<ShipGroup, 2>;
+    using FleetModel = typename Fleet::Model;
+
+    FleetModel fleet;
+    PEX_ROOT(fleet);
+
+    auto generation = fleet.GetGeneration();
+
+    // A member of a group that is an item of the list.
+    fleet[0].speed.Set(3.0);
+    REQUIRE(fleet.GetGeneration() > generation);
+    generation = fleet.GetGeneration();
+
+    // An item of a list within a group within the list.
+    fleet[1].cargo[0].Set(9);
+    REQUIRE(fleet.GetGeneration() > generation);
+    generation = fleet.GetGeneration();
+
+    fleet[1].cargo.Append(5);
+    REQUIRE(fleet.GetGeneration() > generation);
+    generation = fleet.GetGeneration();
+
+    // Items added later report to the list too.
+    fleet.Append(Ship{"Swift", 8.0, {1}});
+    REQUIRE(fleet.GetGeneration() > generation);
+    generation = fleet.GetGeneration();
+
+    fleet[2].name.Set("Swifter");
+    REQUIRE(fleet.GetGeneration() > generation);
+    generation = fleet.GetGeneration();
+
+    // Erasing an item never moves the generation backwards.
+    fleet.Erase(0);
+    REQUIRE(fleet.GetGeneration() > generation);
+    generation = fleet.GetGeneration();
+
+    REQUIRE(fleet.GetGeneration() == generation);
+}
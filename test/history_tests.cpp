@@ -0,0 +1,257 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include <pex/group.h>
+#include <pex/list.h>
+#include <pex/endpoint.h>
+#include <pex/history.h>
+
+
+namespace history
+{
+
+
+template<typename T>
+struct DocumentFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::title, "title"),
+        fields::Field(&T::width, "width"),
+        fields::Field(&T::pages, "pages"));
+};
+
+
+template<template<typename> typename T>
+struct DocumentTemplate
+{
+    T<std::string> title;
+    T<double> width;
+    T<pex::List<int, 0>> pages;
+
+    static constexpr auto fields = DocumentFields<DocumentTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Document";
+};
+
+
+using DocumentGroup = pex::Group<DocumentFields, DocumentTemplate>;
+using Document = typename DocumentGroup::Plain;
+using DocumentModel = typename DocumentGroup::Model;
+using DocumentControl = typename DocumentGroup::template Control<DocumentModel>;
+
+
+class DocumentObserver
+{
+public:
+    DocumentObserver(DocumentModel &model)
+        :
+        count(0),
+        endpoint_(
+            PEX_THIS("DocumentObserver"),
+            DocumentControl(model),
+            &DocumentObserver::OnDocument_)
+    {
+
+    }
+
+    ~DocumentObserver()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    size_t count;
+
+private:
+    void OnDocument_(const Document &)
+    {
+        ++this->count;
+    }
+
+    pex::Endpoint<DocumentObserver, DocumentControl> endpoint_;
+};
+
+
+} // end namespace history
+
+
+TEST_CASE("History undoes and redoes a value", "[history]")
+{
+    using Model = pex::model::Value<int>;
+
+    Model model(1);
+    PEX_ROOT(model);
+
+    pex::History<Model> history(model);
+    REQUIRE(!history.CanUndo());
+
+    model.Set(2);
+    model.Set(3);
+    REQUIRE(history.GetUndoCount() == 2);
+
+    history.Undo();
+    REQUIRE(model.Get() == 2);
+
+    history.Undo();
+    REQUIRE(model.Get() == 1);
+    REQUIRE(!history.CanUndo());
+    REQUIRE(history.GetRedoCount() == 2);
+
+    history.Redo();
+    REQUIRE(model.Get() == 2);
+
+    // A new change discards the changes that could be redone.
+    model.Set(10);
+    REQUIRE(!history.CanRedo());
+    REQUIRE_THROWS_AS(history.Redo(), std::logic_error);
+
+    history.Undo();
+    REQUIRE(model.Get() == 2);
+}
+
+
+TEST_CASE("History records only the group members that change", "[history]")
+{
+    using namespace history;
+
+    DocumentModel model;
+    PEX_ROOT(model);
+
+    model.Set(Document{"Draft", 8.5, {1, 2, 3}});
+
+    pex::History<DocumentModel> history(model);
+    DocumentObserver observer(model);
+
+    model.title.Set("Final");
+    model.width.Set(11.0);
+
+    REQUIRE(history.GetUndoCount() == 2);
+
+    // Undoing the width leaves the later title in place.
+    history.Undo();
+    REQUIRE(model.width.Get() == 8.5);
+    REQUIRE(model.title.Get() == "Final");
+
+    history.Undo();
+    REQUIRE(model.title.Get() == "Draft");
+
+    // Replaying a change to many members notifies the group once.
+    model.Set(Document{"Other", 4.0, {1, 2, 3}});
+    observer.count = 0;
+
+    history.Undo();
+    REQUIRE(observer.count == 1);
+    REQUIRE(model.Get().title == "Draft");
+    REQUIRE(model.width.Get() == 8.5);
+
+    history.Redo();
+    REQUIRE(model.title.Get() == "Other");
+    REQUIRE(model.width.Get() == 4.0);
+}
+
+
+TEST_CASE("History records list edits by index", "[history]")
+{
+    using List = pex::List<int, 0>;
+    using ListModel = typename List::Model;
+
+    ListModel model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3, 4});
+
+    pex::History<ListModel> history(model);
+
+    model.Insert(1, 7);
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 2, 3, 4});
+
+    model.Erase(3);
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 2, 4});
+
+    model[0].Set(9);
+    REQUIRE(model.Get() == std::vector<int>{9, 7, 2, 4});
+
+    history.Undo();
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 2, 4});
+
+    history.Undo();
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 2, 3, 4});
+
+    history.Undo();
+    REQUIRE(model.Get() == std::vector<int>{1, 2, 3, 4});
+
+    history.Redo();
+    history.Redo();
+    history.Redo();
+    REQUIRE(model.Get() == std::vector<int>{9, 7, 2, 4});
+}
+
+
+TEST_CASE("History records range edits from list signals", "[history]")
+{
+    using List = pex::List<int, 0>;
+    using ListModel = typename List::Model;
+
+    ListModel model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3, 4, 5});
+
+    pex::History<ListModel> history(model);
+
+    // Removes the last three items as one range.
+    model.count.Set(2);
+    REQUIRE(history.GetUndoCount() == 1);
+
+    model.InsertRange(1, std::vector<int>{7, 8});
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 8, 2});
+    REQUIRE(history.GetUndoCount() == 2);
+
+    // Setting the whole list records the item that changed.
+    model.Set({1, 7, 9, 2});
+    REQUIRE(history.GetUndoCount() == 3);
+
+    history.Undo();
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 8, 2});
+
+    history.Undo();
+    REQUIRE(model.Get() == std::vector<int>{1, 2});
+
+    history.Undo();
+    REQUIRE(model.Get() == std::vector<int>{1, 2, 3, 4, 5});
+
+    history.Redo();
+    history.Redo();
+    history.Redo();
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 9, 2});
+
+    // Edits after a replay are recorded against the replayed items.
+    model[3].Set(20);
+    history.Undo();
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 9, 2});
+}
+
+
+TEST_CASE("History forgets the oldest changes over budget", "[history]")
+{
+    using Model = pex::model::Value<std::string>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    pex::History<Model> history(model);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        model.Set(std::string(1000, static_cast<char>('a' + i)));
+    }
+
+    REQUIRE(history.GetUndoCount() == 10);
+
+    history.SetMemoryBudget(history.GetMemoryUsage() / 2);
+    REQUIRE(history.GetUndoCount() < 10);
+    REQUIRE(history.GetUndoCount() > 0);
+    REQUIRE(history.GetMemoryUsage() <= history.GetMemoryBudget());
+
+    // The latest changes are kept.
+    history.Undo();
+    REQUIRE(model.Get() == std::string(1000, 'i'));
+}
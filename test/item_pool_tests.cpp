@@ -0,0 +1,98 @@
+#include <catch2/catch.hpp>
+#include <vector>
+#include "pex/detail/item_pool.h"
+
+
+using Pool = pex::detail::ItemPool<int>;
+
+
+TEST_CASE("ItemPool reserves in chunks of limited size", "[item_pool]")
+{
+    Pool pool;
+    pool.Reserve(5000);
+
+    // Each chunk is limited to maximumChunkSize, and the reservation is met
+    // exactly.
+    REQUIRE(pool.GetCapacity() == 5000);
+    REQUIRE(pool.GetChunkCount() == 5);
+
+    std::vector<Pool::Pointer> items;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        items.push_back(pool.Make(i));
+    }
+
+    // The reservation was enough for every item.
+    REQUIRE(pool.GetCapacity() == 5000);
+    REQUIRE(pool.GetLiveCount() == 5000);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        REQUIRE(*items[static_cast<size_t>(i)] == i);
+    }
+
+    items.clear();
+    REQUIRE(pool.GetLiveCount() == 0);
+    REQUIRE(pool.GetCapacity() == 0);
+}
+
+
+TEST_CASE("ItemPool grows with its items", "[item_pool]")
+{
+    Pool pool;
+    std::vector<Pool::Pointer> items;
+
+    // A small list allocates only what it uses.
+    items.push_back(pool.Make(0));
+    REQUIRE(pool.GetCapacity() == 1);
+
+    items.push_back(pool.Make(1));
+    items.push_back(pool.Make(2));
+    REQUIRE(pool.GetCapacity() == 4);
+
+    for (int i = 3; i < 3000; ++i)
+    {
+        items.push_back(pool.Make(i));
+    }
+
+    REQUIRE(pool.GetCapacity() >= 3000);
+    REQUIRE(pool.GetCapacity() < 3000 + Pool::maximumChunkSize);
+}
+
+
+TEST_CASE("ItemPool frees chunks that have no items", "[item_pool]")
+{
+    Pool pool;
+    std::vector<Pool::Pointer> items;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        items.push_back(pool.Make(i));
+    }
+
+    auto chunkCount = pool.GetChunkCount();
+
+    // The first items share the first, smallest chunks, and the chunks that
+    // held the rest are freed.
+    items.resize(10);
+    REQUIRE(pool.GetChunkCount() < chunkCount);
+    REQUIRE(pool.GetCapacity() <= 16);
+
+    // Released slots in the remaining chunks are reused.
+    auto capacity = pool.GetCapacity();
+    items.pop_back();
+    items.push_back(pool.Make(42));
+    REQUIRE(pool.GetCapacity() == capacity);
+
+    // An item keeps its chunk, and its address, while others are released.
+    const int *address = items.back().get();
+    items.erase(items.begin(), items.end() - 1);
+    REQUIRE(items.back().get() == address);
+    REQUIRE(*items.back() == 42);
+    REQUIRE(pool.GetLiveCount() == 1);
+
+    items.clear();
+    REQUIRE(pool.GetCapacity() == 0);
+    REQUIRE(pool.GetChunkCount() == 0);
+}
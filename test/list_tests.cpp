@@ -5,6 +5,7 @@
 
 #include <pex/group.h>
 #include <pex/endpoint.h>
+#include <pex/list_observer.h>
 #include <nlohmann/json.hpp>
 #include <jive/testing/generator_limits.h>
 
@@ -28,7 +29,17 @@ public:
         memberRemovedEndpoint_(
             this,
             list.memberRemoved,
-            &ListChangedObserver::OnMemberRemoved_)
+            &ListChangedObserver::OnMemberRemoved_),
+
+        membersAddedEndpoint_(
+            this,
+            list.membersAdded,
+            &ListChangedObserver::OnMembersAdded_),
+
+        membersRemovedEndpoint_(
+            this,
+            list.membersRemoved,
+            &ListChangedObserver::OnMembersRemoved_)
     {
 
     }
@@ -71,6 +82,38 @@ public:
         }
     }
 
+    // Resizing the list adds or removes its items as one range.
+    void OnMembersAdded_(const std::optional<pex::ListRange> &range)
+    {
+        if (this->list_.count.Get() != this->list_.size())
+        {
+            throw std::logic_error(
+                "Expected count and list size to be consistent");
+        }
+
+        if (range && range->GetEnd() > this->list_.size())
+        {
+            throw std::logic_error("Expected range to fit within list bounds");
+        }
+    }
+
+    void OnMembersRemoved_(const std::optional<pex::ListRange> &range)
+    {
+        if (this->list_.count.Get() != this->list_.size())
+        {
+            throw std::logic_error(
+                "Expected count and list size to be consistent");
+        }
+
+        if (range && range->first > this->list_.size())
+        {
+            // The removed items may have been at the end of the list, making
+            // the first removed index equal to the current list_.size().
+            throw std::logic_error(
+                "Expected range to fit within list bounds  ; 1");
+        }
+    }
+
 private:
     List &list_;
 
@@ -87,6 +130,16 @@ private:
         pex::Endpoint<ListChangedObserver, MemberRemovedControl>;
 
     MemberRemovedEndpoint memberRemovedEndpoint_;
+
+    using MembersAddedEndpoint =
+        pex::Endpoint<ListChangedObserver, typename List::MembersAdded>;
+
+    MembersAddedEndpoint membersAddedEndpoint_;
+
+    using MembersRemovedEndpoint =
+        pex::Endpoint<ListChangedObserver, typename List::MembersRemoved>;
+
+    MembersRemovedEndpoint membersRemovedEndpoint_;
 };
 
 
@@ -1017,3 +1070,623 @@ TEST_CASE("KeyValueContainer allows key access", "[List]")
 
     REQUIRE(model.at("foo") == 42);
 }
+
+
+template<typename ListControl>
+class RangeObserver
+{
+public:
+    RangeObserver(const ListControl &listControl)
+        :
+        notificationCount(0),
+        values(),
+        membersAdded(),
+        membersRemoved(),
+
+        endpoint_(
+            PEX_THIS("RangeObserver"),
+            listControl,
+            &RangeObserver::OnList_),
+
+        membersAddedEndpoint_(
+            this,
+            listControl.membersAdded,
+            &RangeObserver::OnMembersAdded_),
+
+        membersRemovedEndpoint_(
+            this,
+            listControl.membersRemoved,
+            &RangeObserver::OnMembersRemoved_)
+    {
+
+    }
+
+    ~RangeObserver()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    size_t notificationCount;
+    std::vector<int> values;
+    std::vector<pex::ListRange> membersAdded;
+    std::vector<pex::ListRange> membersRemoved;
+
+private:
+    void OnList_(const std::vector<int> &values_)
+    {
+        ++this->notificationCount;
+        this->values = values_;
+    }
+
+    void OnMembersAdded_(const std::optional<pex::ListRange> &range)
+    {
+        if (range)
+        {
+            this->membersAdded.push_back(*range);
+        }
+    }
+
+    void OnMembersRemoved_(const std::optional<pex::ListRange> &range)
+    {
+        if (range)
+        {
+            this->membersRemoved.push_back(*range);
+        }
+    }
+
+    using MembersEndpoint =
+        pex::Endpoint<RangeObserver, typename ListControl::MembersAdded>;
+
+    pex::Endpoint<RangeObserver, ListControl> endpoint_;
+    MembersEndpoint membersAddedEndpoint_;
+    MembersEndpoint membersRemovedEndpoint_;
+};
+
+
+TEST_CASE("List inserts and erases ranges at once", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2});
+
+    Control control(model);
+    RangeObserver<Control> observer(control);
+
+    auto first = model.AppendRange(std::vector<int>{3, 4, 5});
+
+    REQUIRE(first == 2);
+    REQUIRE(model.Get() == std::vector<int>{1, 2, 3, 4, 5});
+    REQUIRE(control.size() == 5);
+    REQUIRE(control.count.Get() == 5);
+    REQUIRE(observer.membersAdded.size() == 1);
+    REQUIRE(observer.membersAdded[0] == pex::ListRange{2, 3});
+    REQUIRE(observer.values == model.Get());
+
+    model.selected.Set(3);
+    model.InsertRange(1, std::vector<int>{7, 8});
+
+    REQUIRE(model.Get() == std::vector<int>{1, 7, 8, 2, 3, 4, 5});
+    REQUIRE(control[2].Get() == 8);
+    REQUIRE(*model.selected.Get() == 5);
+    REQUIRE(observer.values == model.Get());
+
+    auto notificationCount = observer.notificationCount;
+    model.EraseRange(1, 4);
+
+    REQUIRE(model.Get() == std::vector<int>{1, 3, 4, 5});
+    REQUIRE(control.size() == 4);
+    REQUIRE(*model.selected.Get() == 2);
+    REQUIRE(observer.membersRemoved.size() == 1);
+    REQUIRE(observer.membersRemoved[0] == pex::ListRange{1, 3});
+    REQUIRE(observer.values == model.Get());
+    REQUIRE(observer.notificationCount > notificationCount);
+
+    // The connections to the remaining items are still in place.
+    control[1].Set(30);
+    REQUIRE(observer.values == std::vector<int>{1, 30, 4, 5});
+}
+
+
+TEST_CASE("List shrinks with one range removal", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3, 4, 5, 6});
+
+    Control control(model);
+    RangeObserver<Control> observer(control);
+
+    model.count.Set(2);
+
+    REQUIRE(model.Get() == std::vector<int>{1, 2});
+    REQUIRE(control.size() == 2);
+    REQUIRE(observer.membersRemoved.size() == 1);
+    REQUIRE(observer.membersRemoved[0] == pex::ListRange{2, 4});
+    REQUIRE(observer.values == model.Get());
+
+    model.Set({9});
+
+    REQUIRE(control.size() == 1);
+    REQUIRE(control.count.Get() == 1);
+    REQUIRE(observer.membersRemoved.size() == 2);
+    REQUIRE(observer.membersRemoved[1] == pex::ListRange{1, 1});
+    REQUIRE(observer.values == std::vector<int>{9});
+
+    control[0].Set(10);
+    REQUIRE(observer.values == std::vector<int>{10});
+}
+
+
+namespace
+{
+
+
+template<typename Control>
+class ItemEventObserver
+{
+public:
+    ItemEventObserver(Control control)
+        :
+        added(),
+        willRemove(),
+        removed(),
+        listObserver_(
+            this,
+            control,
+            &ItemEventObserver::OnMemberAdded_,
+            &ItemEventObserver::OnMemberWillRemove_,
+            &ItemEventObserver::OnMemberRemoved_,
+            &ItemEventObserver::OnMemberWillReplace_,
+            &ItemEventObserver::OnMemberReplaced_)
+    {
+
+    }
+
+    std::vector<size_t> added;
+    std::vector<size_t> willRemove;
+    std::vector<size_t> removed;
+
+private:
+    void OnMemberAdded_(const std::optional<size_t> &index)
+    {
+        this->added.push_back(*index);
+    }
+
+    void OnMemberWillRemove_(const std::optional<size_t> &index)
+    {
+        this->willRemove.push_back(*index);
+    }
+
+    void OnMemberRemoved_(const std::optional<size_t> &index)
+    {
+        this->removed.push_back(*index);
+    }
+
+    void OnMemberWillReplace_(const std::optional<size_t> &)
+    {
+
+    }
+
+    void OnMemberReplaced_(const std::optional<size_t> &)
+    {
+
+    }
+
+    pex::ListObserver<ItemEventObserver, Control> listObserver_;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("ListObserver reports range edits per item", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3, 4, 5});
+
+    Control control(model);
+    ItemEventObserver<Control> observer(control);
+
+    model.count.Set(2);
+
+    REQUIRE(observer.willRemove == std::vector<size_t>{4, 3, 2});
+    REQUIRE(observer.removed == std::vector<size_t>{4, 3, 2});
+
+    model.count.Set(4);
+
+    REQUIRE(observer.added == std::vector<size_t>{2, 3});
+
+    model.EraseRange(0, 2);
+
+    REQUIRE(model.Get() == std::vector<int>{0, 0});
+    REQUIRE(observer.willRemove == std::vector<size_t>{4, 3, 2, 1, 0});
+    REQUIRE(observer.removed == std::vector<size_t>{4, 3, 2, 1, 0});
+}
+
+
+TEST_CASE("List items keep their addresses", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3});
+
+    auto *second = &model[1];
+
+    model.InsertRange(0, std::vector<int>(100, 7));
+    model.count.Set(200);
+
+    REQUIRE(&model[101] == second);
+    REQUIRE(model[101].Get() == 2);
+
+    // Erased items return their storage to the list, and new items reuse it.
+    model.count.Set(50);
+    model.count.Set(300);
+
+    REQUIRE(model.Get().size() == 300);
+    REQUIRE(model[299].Get() == 0);
+}
+
+
+template<typename ListControl>
+class IndexedObserver
+{
+public:
+    IndexedObserver(const ListControl &listControl)
+        :
+        changes(),
+        connect_(listControl)
+    {
+        PEX_NAME("IndexedObserver");
+        this->connect_.Connect(this, &IndexedObserver::OnItem_);
+    }
+
+    ~IndexedObserver()
+    {
+        this->connect_.Disconnect();
+        PEX_CLEAR_NAME(this);
+    }
+
+    std::vector<std::pair<size_t, int>> changes;
+
+private:
+    void OnItem_(size_t index, pex::Argument<int> value)
+    {
+        this->changes.emplace_back(index, value);
+    }
+
+    pex::detail::ListConnect<IndexedObserver, ListControl> connect_;
+};
+
+
+TEST_CASE("List items report their index after inserts and erases", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3});
+
+    IndexedObserver<Control> observer{Control(model)};
+
+    model.InsertRange(0, std::vector<int>{7, 8});
+    model[4].Set(30);
+
+    REQUIRE(observer.changes.back() == std::pair<size_t, int>(4, 30));
+
+    model.Insert(1, 5);
+    model[0].Set(9);
+
+    REQUIRE(observer.changes.back() == std::pair<size_t, int>(0, 9));
+
+    model[5].Set(31);
+
+    REQUIRE(observer.changes.back() == std::pair<size_t, int>(5, 31));
+
+    model.Erase(0);
+    model.EraseRange(0, 2);
+    model[2].Set(32);
+
+    REQUIRE(model.Get() == std::vector<int>{1, 2, 32});
+    REQUIRE(observer.changes.back() == std::pair<size_t, int>(2, 32));
+}
+
+
+TEST_CASE("List reuses its snapshot while unchanged", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3});
+
+    auto first = model.GetSnapshot();
+    REQUIRE(first.IsSharedWith(model.GetSnapshot()));
+
+    model[1].Set(20);
+
+    auto second = model.GetSnapshot();
+
+    // A snapshot that was handed out is never changed.
+    REQUIRE(!second.IsSharedWith(first));
+    REQUIRE(first.Get() == std::vector<int>{1, 2, 3});
+    REQUIRE(second.Get() == std::vector<int>{1, 20, 3});
+
+    model.Append(4);
+
+    REQUIRE(model.GetSnapshot().Get() == std::vector<int>{1, 20, 3, 4});
+    REQUIRE(model.Get() == std::vector<int>{1, 20, 3, 4});
+
+    Control control(model);
+    REQUIRE(control.GetSnapshot().IsSharedWith(model.GetSnapshot()));
+}
+
+
+template<typename ListControl>
+class ListValuesObserver
+{
+public:
+    ListValuesObserver(const ListControl &listControl)
+        :
+        received(),
+        endpoint_(
+            PEX_THIS("ListValuesObserver"),
+            listControl,
+            &ListValuesObserver::OnList_)
+    {
+
+    }
+
+    ~ListValuesObserver()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    std::vector<int> received;
+
+private:
+    void OnList_(const std::vector<int> &values)
+    {
+        this->received = values;
+    }
+
+    pex::Endpoint<ListValuesObserver, ListControl> endpoint_;
+};
+
+
+TEST_CASE("List observers receive every item change", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3});
+
+    ListValuesObserver<Control> observer{Control(model)};
+
+    model[1].Set(20);
+    REQUIRE(observer.received == std::vector<int>{1, 20, 3});
+
+    model[2].Set(30);
+    REQUIRE(observer.received == std::vector<int>{1, 20, 30});
+
+    // After items are added or removed, the values are read from the list.
+    model.Insert(0, 7);
+    model[3].Set(40);
+    REQUIRE(observer.received == std::vector<int>{7, 1, 20, 40});
+
+    model.Erase(1);
+    model[0].Set(8);
+    REQUIRE(observer.received == std::vector<int>{8, 20, 40});
+
+    model.EraseRange(1, 3);
+    model[0].Set(9);
+    REQUIRE(observer.received == std::vector<int>{9});
+
+    {
+        // A change made while muted is sent when the list is unmuted.
+        auto mute = pex::detail::ScopeMute<Model>(model, false);
+        model[0].Set(10);
+        REQUIRE(observer.received == std::vector<int>{9});
+    }
+
+    REQUIRE(observer.received == std::vector<int>{10});
+
+    model.Append(11);
+    model[1].Set(12);
+    REQUIRE(observer.received == std::vector<int>{10, 12});
+}
+
+
+namespace
+{
+
+
+template<typename ListControl>
+class ListValueObserver
+{
+public:
+    ListValueObserver(const ListControl &listControl)
+        :
+        notificationCount(0),
+        endpoint_(
+            PEX_THIS("ListValueObserver"),
+            listControl,
+            &ListValueObserver::OnList_)
+    {
+
+    }
+
+    ~ListValueObserver()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    size_t notificationCount;
+
+private:
+    void OnList_(const typename ListControl::Type &)
+    {
+        ++this->notificationCount;
+    }
+
+    pex::Endpoint<ListValueObserver, ListControl> endpoint_;
+};
+
+
+// Connects after the list observer, so its place in the callback order of
+// the item shows whether the list observer's connection was rebuilt.
+template<typename Control>
+class ConnectionProbe
+{
+public:
+    ConnectionProbe(Control control)
+        :
+        endpoint_(
+            PEX_THIS("ConnectionProbe"),
+            control,
+            &ConnectionProbe::OnValue_)
+    {
+
+    }
+
+    ~ConnectionProbe()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+private:
+    void OnValue_(pex::Argument<typename Control::Type>)
+    {
+
+    }
+
+    pex::Endpoint<ConnectionProbe, Control> endpoint_;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("List inserts and erases keep item connections", "[List]")
+{
+    using List = pex::List<int>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model.Set({1, 2, 3});
+
+    Control control(model);
+    ListValueObserver<Control> observer(control);
+    ConnectionProbe<typename Control::ListItem> probe(control[2]);
+
+    auto order = model[2].GetNotificationOrder(&probe);
+    REQUIRE(order > 0);
+
+    model.InsertRange(0, std::vector<int>{7, 8});
+    model.Insert(1, 5);
+    model.Erase(0);
+
+    // A rebuilt connection would now follow the probe.
+    REQUIRE(model[4].Get() == 3);
+    REQUIRE(model[4].GetNotificationOrder(&probe) == order);
+
+    auto notificationCount = observer.notificationCount;
+    control[4].Set(30);
+    REQUIRE(observer.notificationCount == notificationCount + 1);
+}
+
+
+TEST_CASE("List of groups keeps item connections", "[List]")
+{
+    using List = pex::List<RocketGroup, 3>;
+    using Model = typename List::Model;
+    using Control = typename List::template Control<Model>;
+    using XControl = decltype(RocketControl::x);
+
+    Model model;
+    PEX_ROOT(model);
+
+    model[2].x.Set(3.0);
+
+    Control control(model);
+    ListValueObserver<Control> observer(control);
+    ConnectionProbe<XControl> probe(control[2].x);
+
+    auto order = model[2].x.GetNotificationOrder(&probe);
+    REQUIRE(order > 0);
+
+    model.InsertRange(0, std::vector<Rocket>(2));
+    model.Insert(1, Rocket{});
+    model.EraseRange(0, 2);
+
+    REQUIRE(model[3].x.Get() == 3.0);
+    REQUIRE(model[3].x.GetNotificationOrder(&probe) == order);
+
+    auto notificationCount = observer.notificationCount;
+    control[3].y.Set(4.0);
+    REQUIRE(observer.notificationCount == notificationCount + 1);
+}
+
+
+#ifndef NDEBUG
+TEST_CASE("List items cannot be set while the list is viewed", "[List]")
+{
+    using List = pex::List<int, 2>;
+    using Model = typename List::Model;
+
+    Model model;
+    PEX_ROOT(model);
+
+    model[1].Set(1);
+
+    {
+        auto view = model.View();
+        REQUIRE(view[1] == 1);
+        REQUIRE_THROWS_AS(model[1].Set(2), std::logic_error);
+        REQUIRE(view[1] == 1);
+    }
+
+    // Items added after a view is gone are guarded by the next one.
+    model.Append(3);
+
+    {
+        auto view = model.View();
+        REQUIRE_THROWS_AS(model[2].Set(4), std::logic_error);
+    }
+
+    model[2].Set(4);
+    REQUIRE(model.Get() == std::vector<int>{0, 1, 4});
+}
+#endif
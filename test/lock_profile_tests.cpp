@@ -0,0 +1,152 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include "pex/locks.h"
+#include "scoped_reset.h"
+
+
+namespace
+{
+
+
+using LockProfileReset = ScopedReset<pex::ResetLockProfile>;
+
+
+using ProfileWriteLock = pex::ProfileLock<pex::ExclusiveLock>;
+using ProfileReadLock = pex::ProfileLock<pex::SharedLock>;
+
+
+pex::detail::LockSite & GetWriteSite()
+{
+    static pex::detail::LockSite site("writer.cpp", 10, "WriteLock");
+
+    return site;
+}
+
+
+pex::detail::LockSite & GetReadSite()
+{
+    static pex::detail::LockSite site("reader.cpp", 20, "ReadLock");
+
+    return site;
+}
+
+
+std::optional<pex::LockProfile> FindProfile(const std::string &fileName)
+{
+    for (auto &profile: pex::GetLockProfiles(100))
+    {
+        if (profile.fileName == fileName)
+        {
+            return profile;
+        }
+    }
+
+    return {};
+}
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Uncontended locks are counted", "[lock_profile]")
+{
+    LockProfileReset reset;
+    pex::Mutex mutex;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ProfileReadLock lock(GetReadSite(), mutex);
+    }
+
+    {
+        ProfileWriteLock lock(GetWriteSite(), mutex);
+
+        // Relocking is measured as another acquisition.
+        lock.unlock();
+        lock.lock();
+    }
+
+    auto reader = FindProfile("reader.cpp");
+    REQUIRE(reader);
+    REQUIRE(reader->lockName == "ReadLock");
+    REQUIRE(reader->line == 20);
+    REQUIRE(reader->acquireCount == 3);
+    REQUIRE(reader->contendedCount == 0);
+    REQUIRE(reader->totalWait.count() == 0);
+
+    uint64_t holdCount = 0;
+
+    for (auto count: reader->holdHistogram)
+    {
+        holdCount += count;
+    }
+
+    REQUIRE(holdCount == 3);
+
+    auto writer = FindProfile("writer.cpp");
+    REQUIRE(writer);
+    REQUIRE(writer->acquireCount == 2);
+    REQUIRE(writer->contendedCount == 0);
+
+    pex::ResetLockProfile();
+    REQUIRE(pex::GetLockProfiles(100).empty());
+}
+
+
+TEST_CASE("A reader waiting on a writer is contended", "[lock_profile]")
+{
+    LockProfileReset reset;
+    pex::Mutex mutex;
+
+    std::atomic<bool> isLocked{false};
+    std::atomic<bool> isWaiting{false};
+
+    std::thread writer(
+        [&]()
+        {
+            ProfileWriteLock lock(GetWriteSite(), mutex);
+            isLocked = true;
+
+            while (!isWaiting)
+            {
+                std::this_thread::yield();
+            }
+
+            // Give the reader time to block on the lock.
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        });
+
+    while (!isLocked)
+    {
+        std::this_thread::yield();
+    }
+
+    isWaiting = true;
+
+    {
+        ProfileReadLock lock(GetReadSite(), mutex);
+    }
+
+    writer.join();
+
+    auto reader = FindProfile("reader.cpp");
+    REQUIRE(reader);
+    REQUIRE(reader->contendedCount == 1);
+    REQUIRE(reader->maxWait > std::chrono::milliseconds(1));
+    REQUIRE(reader->totalWait == reader->maxWait);
+
+    auto writerProfile = FindProfile("writer.cpp");
+    REQUIRE(writerProfile);
+    REQUIRE(writerProfile->maxHold >= std::chrono::milliseconds(10));
+
+    // The most contended site is reported first.
+    auto profiles = pex::GetLockProfiles(1);
+    REQUIRE(profiles.size() == 1);
+    REQUIRE(profiles.front().fileName == "reader.cpp");
+
+    std::ostringstream output;
+    pex::ReportLockProfile(output);
+    REQUIRE(output.str().find("ReadLock reader.cpp:20") != std::string::npos);
+}
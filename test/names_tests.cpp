@@ -0,0 +1,226 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pex/detail/log.h"
+
+
+namespace
+{
+
+
+struct Node
+{
+    char data;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Names are registered and cleared", "[names]")
+{
+    Node parent{};
+    Node child{};
+    Node anonymous{};
+
+    pex::PexName(&parent, "parent");
+    pex::PexName(&child, &parent, "child");
+
+    REQUIRE(pex::HasPexName(&parent));
+    REQUIRE(pex::HasPexName(&child));
+    REQUIRE(!pex::HasPexName(&anonymous));
+    REQUIRE(pex::HasNamedParent(&child));
+    REQUIRE(pex::GetParent(&child) == &parent);
+
+    auto childName = pex::LookupPexName(&child);
+    REQUIRE(childName.find("child") != std::string::npos);
+    REQUIRE(childName.find("member of parent") != std::string::npos);
+
+    REQUIRE_THROWS_AS(
+        pex::PexName(&child, &anonymous, "child"),
+        std::runtime_error);
+
+    REQUIRE_THROWS_AS(
+        pex::PexNameUnique(&parent, "parent"),
+        std::logic_error);
+
+    // Renaming keeps the parent.
+    pex::PexName(&child, "renamed");
+    REQUIRE(pex::GetParent(&child) == &parent);
+    REQUIRE(pex::LookupPexName(&child).find("renamed") != std::string::npos);
+
+    pex::ClearPexName(&child);
+    REQUIRE(!pex::HasPexName(&child));
+
+    auto deletedName = pex::LookupPexName(&child);
+    REQUIRE(deletedName.find("(deleted)") != std::string::npos);
+    REQUIRE(deletedName.find("renamed") != std::string::npos);
+
+    pex::ClearPexName(&parent);
+}
+
+
+TEST_CASE("Registered parents name their children", "[names]")
+{
+    Node parent{};
+    Node child{};
+    Node observer{};
+
+    pex::PexName(&parent, "parent");
+    pex::RegisterPexParent(&parent, &child);
+
+    // A child with a parent, but no name of its own, is anonymous.
+    REQUIRE(!pex::HasPexName(&child));
+    REQUIRE(pex::GetParent(&child) == &parent);
+
+    pex::PexName(&observer, "observer");
+    pex::PexLinkObserver(&parent, &observer);
+
+    // Children find the observer linked to their parents.
+    REQUIRE(pex::GetLinkedObserver(&child) == &observer);
+
+    pex::ClearPexName(&parent);
+    REQUIRE(pex::GetLinkedObserver(&child) == nullptr);
+
+    pex::ClearPexName(&child);
+    pex::ClearPexName(&observer);
+}
+
+
+TEST_CASE("Names can be registered from several threads", "[names]")
+{
+    static constexpr size_t threadCount = 4;
+    static constexpr size_t nodeCount = 1000;
+
+    std::vector<std::vector<Node>> nodes(
+        threadCount,
+        std::vector<Node>(nodeCount));
+
+    Node root{};
+    pex::PexName(&root, "root");
+
+    std::atomic<size_t> unnamedParentCount{0};
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(
+            [&root, &unnamedParentCount, &threadNodes = nodes[i]]()
+            {
+                for (auto &node: threadNodes)
+                {
+                    pex::PexName(&node, &root, "node");
+                }
+
+                for (auto &node: threadNodes)
+                {
+                    // Reads of the root are shared with the other threads.
+                    if (!pex::HasNamedParent(&node))
+                    {
+                        ++unnamedParentCount;
+                    }
+
+                    pex::ClearPexName(&node);
+                }
+            });
+    }
+
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(unnamedParentCount == 0);
+
+    for (auto &threadNodes: nodes)
+    {
+        for (auto &node: threadNodes)
+        {
+            REQUIRE(!pex::HasPexName(&node));
+        }
+    }
+
+    pex::ClearPexName(&root);
+}
+
+
+TEST_CASE("Names can be looked up while they are replaced", "[names]")
+{
+    static constexpr int renameCount = 10000;
+
+    Node parent{};
+    Node child{};
+
+    pex::PexName(&parent, "parent");
+    pex::PexName(&child, &parent, "child");
+
+    std::atomic<bool> isDone{false};
+    size_t emptyCount = 0;
+
+    // Each lookup copies the name while it is still in use, so a rename on
+    // the other thread cannot free it while it is read.
+    std::thread reader(
+        [&]()
+        {
+            while (!isDone)
+            {
+                if (pex::LookupPexName(&child).empty())
+                {
+                    ++emptyCount;
+                }
+
+                if (!pex::HasPexName(&parent))
+                {
+                    ++emptyCount;
+                }
+            }
+        });
+
+    for (int i = 0; i < renameCount; ++i)
+    {
+        pex::PexName(&parent, "parent " + std::to_string(i));
+        pex::PexName(&child, "child " + std::to_string(i));
+    }
+
+    isDone = true;
+    reader.join();
+
+    REQUIRE(emptyCount == 0);
+
+    pex::ClearPexName(&child);
+    pex::ClearPexName(&parent);
+}
+
+
+TEST_CASE("Names that are no longer used are freed", "[names]")
+{
+    // Static nodes do not share an address with a deleted node from another
+    // test, so clearing them adds their own deleted entries.
+    static Node node{};
+    static Node other{};
+
+    auto initialCount = pex::GetInternedPexNameCount();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        pex::PexName(&node, "node " + std::to_string(i));
+    }
+
+    // Only the last name is still in use.
+    REQUIRE(pex::GetInternedPexNameCount() == initialCount + 1);
+
+    // Nodes with the same name share it.
+    pex::PexName(&other, "node 999");
+    REQUIRE(pex::GetInternedPexNameCount() == initialCount + 1);
+
+    // The deleted names are kept for lookups.
+    pex::ClearPexName(&node);
+    pex::ClearPexName(&other);
+    REQUIRE(pex::GetInternedPexNameCount() == initialCount + 1);
+
+    pex::PexName(&node, "renamed");
+    pex::ClearPexName(&node);
+    REQUIRE(pex::GetInternedPexNameCount() == initialCount + 2);
+}
@@ -0,0 +1,531 @@
+#include <catch2/catch.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "pex/model_value.h"
+#include "pex/control_value.h"
+#include "pex/signal.h"
+
+
+namespace
+{
+
+
+using Model = pex::model::Value<int>;
+
+
+struct Recorder
+{
+    Recorder(std::vector<int> &record_, int id_)
+        :
+        record(record_),
+        id(id_)
+    {
+        PEX_NAME("Recorder");
+    }
+
+    ~Recorder()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    static void OnValue(void *context, int)
+    {
+        auto self = static_cast<Recorder *>(context);
+        self->record.push_back(self->id);
+    }
+
+    std::vector<int> &record;
+    int id;
+};
+
+
+struct Tracker
+{
+    Tracker()
+        :
+        values(),
+        signalCount(0)
+    {
+        PEX_NAME("Tracker");
+    }
+
+    ~Tracker()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    void OnValue(int value)
+    {
+        this->values.push_back(value);
+    }
+
+    void OnSignal()
+    {
+        ++this->signalCount;
+    }
+
+    std::vector<int> values;
+    int signalCount;
+};
+
+
+void OnTrackerValue(Tracker *tracker, int value)
+{
+    tracker->values.push_back(-value);
+}
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Disconnect by token removes only that connection", "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<int> record;
+    Recorder first(record, 1);
+    Recorder second(record, 2);
+
+    auto firstToken = model.Connect(&first, &Recorder::OnValue);
+    auto secondToken = model.Connect(&second, &Recorder::OnValue);
+
+    REQUIRE(model.HasConnection(firstToken));
+    REQUIRE(model.HasConnection(secondToken));
+
+    model.Disconnect(firstToken);
+
+    REQUIRE(!model.HasConnection(firstToken));
+    REQUIRE(model.HasConnection(secondToken));
+    REQUIRE(!model.HasObserver(&first));
+    REQUIRE(model.HasObserver(&second));
+
+    model.Set(1);
+    REQUIRE(record == std::vector<int>{2});
+
+    model.Disconnect(secondToken);
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE("Reused slots keep callbacks in connection order", "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<int> record;
+    std::vector<std::unique_ptr<Recorder>> recorders;
+    std::vector<pex::detail::ConnectionToken> tokens;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        recorders.push_back(std::make_unique<Recorder>(record, i));
+
+        tokens.push_back(
+            model.Connect(recorders.back().get(), &Recorder::OnValue));
+    }
+
+    // Vacate slots near the front, then reconnect.
+    // The new connections must be notified last.
+    model.Disconnect(tokens.at(1));
+    model.Disconnect(tokens.at(2));
+    model.Disconnect(tokens.at(5));
+
+    auto reconnected = model.Connect(recorders.at(2).get(), &Recorder::OnValue);
+    model.Connect(recorders.at(1).get(), &Recorder::OnValue);
+
+    // The stale token must not match the connection that reused its slot.
+    REQUIRE(!model.HasConnection(tokens.at(2)));
+    REQUIRE(!model.HasConnection(tokens.at(1)));
+    REQUIRE(model.HasConnection(reconnected));
+
+    model.Set(42);
+    REQUIRE(record == std::vector<int>{0, 3, 4, 6, 7, 2, 1});
+
+    REQUIRE(model.GetNotificationOrder(recorders.at(0).get()) == 0);
+    REQUIRE(model.GetNotificationOrder(recorders.at(2).get()) == 5);
+
+    for (auto &recorder: recorders)
+    {
+        if (model.HasObserver(recorder.get()))
+        {
+            model.Disconnect(recorder.get());
+        }
+    }
+
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE("Controls disconnect from the model by token", "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    using Control = pex::control::Value<Model>;
+
+    std::vector<int> record;
+    Recorder first(record, 1);
+    Recorder second(record, 2);
+
+    auto firstControl = std::make_unique<Control>(model);
+    Control secondControl(model);
+
+    auto token = firstControl->Connect(&first, &Recorder::OnValue);
+    secondControl.Connect(&second, &Recorder::OnValue);
+
+    REQUIRE(model.GetNotifierCount() == 2);
+
+    firstControl->Disconnect(token);
+
+    // The last connection to firstControl has been removed, so it no longer
+    // observes the model.
+    REQUIRE(model.GetNotifierCount() == 1);
+    REQUIRE(!model.HasObserver(firstControl.get()));
+
+    model.Set(3);
+    REQUIRE(record == std::vector<int>{2});
+
+    firstControl.reset();
+    secondControl.Disconnect(&second);
+    REQUIRE(!model.HasConnections());
+}
+
+
+namespace
+{
+
+
+// Runs an action from its callback, once.
+struct Reentrant
+{
+    Reentrant(std::vector<int> &record_, int id_)
+        :
+        record(record_),
+        id(id_),
+        action{}
+    {
+        PEX_NAME("Reentrant");
+    }
+
+    ~Reentrant()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    static void OnValue(void *context, int)
+    {
+        auto self = static_cast<Reentrant *>(context);
+        self->record.push_back(self->id);
+
+        if (self->action)
+        {
+            auto action = std::move(self->action);
+            self->action = {};
+            action();
+        }
+    }
+
+    std::vector<int> &record;
+    int id;
+    std::function<void()> action;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("A callback can disconnect itself", "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<int> record;
+    Reentrant first(record, 1);
+    Recorder second(record, 2);
+
+    auto token = model.Connect(&first, &Reentrant::OnValue);
+    model.Connect(&second, &Recorder::OnValue);
+
+    first.action = [&]()
+    {
+        model.Disconnect(token);
+    };
+
+    model.Set(1);
+    REQUIRE(record == std::vector<int>{1, 2});
+    REQUIRE(!model.HasConnection(token));
+    REQUIRE(model.GetNotifierCount() == 1);
+
+    model.Set(2);
+    REQUIRE(record == std::vector<int>{1, 2, 2});
+
+    model.Disconnect(&second);
+}
+
+
+TEST_CASE("A callback can disconnect a later observer", "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<int> record;
+    Reentrant first(record, 1);
+    Recorder second(record, 2);
+    Recorder third(record, 3);
+
+    model.Connect(&first, &Reentrant::OnValue);
+    model.Connect(&second, &Recorder::OnValue);
+    model.Connect(&third, &Recorder::OnValue);
+
+    first.action = [&]()
+    {
+        model.Disconnect(&second);
+    };
+
+    model.Set(1);
+    REQUIRE(record == std::vector<int>{1, 3});
+    REQUIRE(!model.HasObserver(&second));
+
+    model.Disconnect(&first);
+    model.Disconnect(&third);
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE(
+    "Connections made from a callback are notified next time",
+    "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<int> record;
+    Reentrant first(record, 1);
+
+    // Connect enough new observers to outgrow the slots being iterated.
+    auto count = GENERATE(
+        size_t{1},
+        pex::detail::inlineConnectionCount,
+        size_t{8});
+
+    std::vector<std::unique_ptr<Recorder>> recorders;
+    std::vector<pex::detail::ConnectionToken> tokens;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        recorders.push_back(
+            std::make_unique<Recorder>(record, static_cast<int>(10 + i)));
+    }
+
+    model.Connect(&first, &Reentrant::OnValue);
+
+    first.action = [&]()
+    {
+        for (auto &recorder: recorders)
+        {
+            tokens.push_back(
+                model.Connect(recorder.get(), &Recorder::OnValue));
+        }
+
+        // The new connections are visible immediately.
+        REQUIRE(model.GetNotifierCount() == count + 1);
+
+        for (auto &token: tokens)
+        {
+            REQUIRE(model.HasConnection(token));
+        }
+    };
+
+    model.Set(1);
+    REQUIRE(record == std::vector<int>{1});
+
+    record.clear();
+    model.Set(2);
+
+    std::vector<int> expected{1};
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        expected.push_back(static_cast<int>(10 + i));
+    }
+
+    REQUIRE(record == expected);
+
+    for (auto &token: tokens)
+    {
+        REQUIRE(model.HasConnection(token));
+        model.Disconnect(token);
+    }
+
+    model.Disconnect(&first);
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE(
+    "A connection made and removed from a callback is never notified",
+    "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<int> record;
+    Reentrant first(record, 1);
+    Recorder second(record, 2);
+    Recorder third(record, 3);
+
+    model.Connect(&first, &Reentrant::OnValue);
+
+    first.action = [&]()
+    {
+        auto token = model.Connect(&second, &Recorder::OnValue);
+        model.Connect(&third, &Recorder::OnValue);
+        model.Connect(&second, &Recorder::OnValue);
+        model.Disconnect(token);
+        REQUIRE(!model.HasConnection(token));
+        model.Disconnect(&second);
+    };
+
+    model.Set(1);
+    model.Set(2);
+    REQUIRE(record == std::vector<int>{1, 1, 3});
+    REQUIRE(model.GetNotifierCount() == 2);
+
+    model.Disconnect(&first);
+    model.Disconnect(&third);
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE("Nested notifications defer changes until the end", "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    std::vector<int> record;
+    Reentrant first(record, 1);
+    Reentrant second(record, 2);
+    Recorder third(record, 3);
+
+    model.Connect(&first, &Reentrant::OnValue);
+    auto secondToken = model.Connect(&second, &Reentrant::OnValue);
+
+    first.action = [&]()
+    {
+        // Notify again from inside the notification.
+        model.Set(2);
+    };
+
+    second.action = [&]()
+    {
+        model.Disconnect(secondToken);
+        model.Connect(&third, &Recorder::OnValue);
+    };
+
+    model.Set(1);
+
+    // The nested notification removes second, so the outer notification
+    // does not reach it again, and third waits for the next notification.
+    REQUIRE(record == std::vector<int>{1, 1, 2});
+
+    record.clear();
+    model.Set(3);
+    REQUIRE(record == std::vector<int>{1, 3});
+
+    model.Disconnect(&first);
+    model.Disconnect(&third);
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE("Bound callbacks reach the observer", "[notify]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    pex::control::Value<Model> control(model);
+    Tracker first;
+    Tracker second;
+    Tracker third;
+
+    auto firstToken = model.Connect<&Tracker::OnValue>(&first);
+    control.Connect<&Tracker::OnValue>(&second);
+    model.Connect<&OnTrackerValue>(&third);
+
+    model.Set(4);
+    control.Set(5);
+
+    REQUIRE(first.values == std::vector<int>{4, 5});
+    REQUIRE(second.values == std::vector<int>{4, 5});
+    REQUIRE(third.values == std::vector<int>{-4, -5});
+
+    model.Disconnect(firstToken);
+    control.Disconnect(&second);
+    model.Disconnect(&third);
+
+    REQUIRE(!control.HasConnections());
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE("Bound callbacks reach signal observers", "[notify]")
+{
+    pex::model::Signal model;
+    PEX_ROOT(model);
+
+    pex::control::Signal<pex::model::Signal> control(model);
+    Tracker first;
+    Tracker second;
+
+    model.Connect<&Tracker::OnSignal>(&first);
+    control.Connect<&Tracker::OnSignal>(&second);
+
+    model.Trigger();
+    control.Trigger();
+
+    REQUIRE(first.signalCount == 2);
+    REQUIRE(second.signalCount == 2);
+
+    model.Disconnect(&first);
+    control.Disconnect(&second);
+
+    REQUIRE(!model.HasConnections());
+}
+
+
+TEST_CASE("Connections keep the callable they were given", "[notify]")
+{
+    using Connection = pex::detail::ValueConnection<void, int>;
+
+    std::vector<int> record;
+    Recorder recorder(record, 7);
+
+    Connection plain(&recorder, &Recorder::OnValue);
+    plain(1);
+
+    REQUIRE(record == std::vector<int>{7});
+
+    auto callable = plain.GetCallable();
+    auto function = callable.target<void (*)(void *, int)>();
+    REQUIRE(function);
+    REQUIRE(*function == &Recorder::OnValue);
+
+    int captured = 0;
+
+    Connection lambda(
+        &recorder,
+        [&captured](void *, int value)
+        {
+            captured = value;
+        });
+
+    lambda(3);
+    REQUIRE(captured == 3);
+
+    auto copy = lambda;
+    copy(4);
+    REQUIRE(captured == 4);
+    REQUIRE(copy == lambda);
+}
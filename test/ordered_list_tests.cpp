@@ -271,6 +271,68 @@ TEST_CASE("Reordered OrderedList Erase by index", "[OrderedList]")
 }
 
 
+class RangeRemovedObserver
+{
+public:
+    using MembersRemoved = pex::control::ListOptionalRange;
+
+    RangeRemovedObserver(MembersRemoved membersRemoved)
+        :
+        endpoint_(
+            PEX_THIS("RangeRemovedObserver"),
+            membersRemoved,
+            &RangeRemovedObserver::OnMembersRemoved_),
+        ranges()
+    {
+
+    }
+
+    void OnMembersRemoved_(const std::optional<pex::ListRange> &range)
+    {
+        this->ranges.push_back(*range);
+    }
+
+private:
+    pex::Endpoint<RangeRemovedObserver, MembersRemoved> endpoint_;
+
+public:
+    std::vector<pex::ListRange> ranges;
+};
+
+
+TEST_CASE("Reordered OrderedList shrinks by count", "[OrderedList]")
+{
+    using List = pex::List<int, 0>;
+    using OrderedListGroup = pex::OrderedListGroup<List>;
+
+    using Model = typename OrderedListGroup::Model;
+    using Control = typename OrderedListGroup::template Control<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+    Control control(model);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        model.Append(i);
+    }
+
+    model.indices.Set({4, 1, 3, 0, 2});
+
+    RangeRemovedObserver observer(control.membersRemoved);
+
+    // Removes storage indices 2, 3, and 4 at once.
+    model.list.count.Set(2);
+
+    REQUIRE(observer.ranges.size() == 1);
+    REQUIRE(observer.ranges[0] == pex::ListRange{2, 3});
+    REQUIRE(model.size() == 2);
+    REQUIRE(model.indices.Get() == std::vector<size_t>{1, 0});
+    REQUIRE(control[0].Get() == 1);
+    REQUIRE(control[1].Get() == 0);
+}
+
+
 template<typename T>
 struct AnimalFields
 {
@@ -1011,3 +1011,72 @@ TEST_CASE("Use Poly in a pex::Group", "[poly]")
     REQUIRE(fixedWing == model.fixedWing.GetValue());
     REQUIRE(rotorWing == model.rotorWing.GetValue());
 }
+
+
+template<typename T>
+struct HangarFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::capacity, "capacity"),
+        fields::Field(&T::aircraft, "aircraft"));
+};
+
+
+template<template<typename> typename T>
+struct HangarTemplate
+{
+    T<pex::MakeRange<int, pex::Limit<0>, pex::Limit<100>>> capacity;
+    T<pex::List<pex::MakePoly<AircraftSupers>>> aircraft;
+
+    static constexpr auto fields = HangarFields<HangarTemplate>::fields;
+    static constexpr auto fieldsTypeName = "Hangar";
+};
+
+
+using HangarGroup = pex::Group<HangarFields, HangarTemplate>;
+using HangarModel = typename HangarGroup::Model;
+
+// Poly models change without a generation, so a group that holds them cannot
+// report every change.
+static_assert(
+    !pex::detail::ReportsChanges
+    <
+        pex::ModelSelector<pex::MakePoly<AircraftSupers>>
+    >);
+
+static_assert(!pex::detail::ReportsChanges<HangarModel>);
+
+
+TEST_CASE("List of groups with poly members reads every change", "[poly]")
+{
+    using HangarList = pex::List<HangarGroup, 1>;
+    using HangarListModel = typename HangarList::Model;
+
+    HangarListModel model;
+    auto &hangar = model.at(0);
+
+    hangar.aircraft.Append(
+        ValueWrapper::Create<RotorWing>(10000., 175., 25.));
+
+    auto snapshot = model.GetSnapshot();
+    REQUIRE(snapshot->at(0).capacity == 0);
+
+    // The Range member reports its changes.
+    hangar.capacity.Set(20);
+    REQUIRE(model.Get().at(0).capacity == 20);
+    REQUIRE(model.GetSnapshot()->at(0).capacity == 20);
+
+    // Setting a poly item to the same type changes it in place, without a
+    // generation.
+    hangar.aircraft[0].Set(
+        ValueWrapper::Create<RotorWing>(10000., 42., 25.));
+
+    REQUIRE(
+        model.Get().at(0).aircraft.at(0).RequireDerived<RotorWing>().range
+        == 42.0);
+
+    REQUIRE(
+        model.GetSnapshot()->at(0).aircraft.at(0)
+            .RequireDerived<RotorWing>().range
+        == 42.0);
+}
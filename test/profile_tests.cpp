@@ -0,0 +1,101 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <thread>
+#include "pex/detail/profile.h"
+#include "scoped_reset.h"
+
+
+namespace
+{
+
+
+using ProfileReset = ScopedReset<pex::ResetProfile>;
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Profile counts notifications and callbacks", "[profile]")
+{
+    ProfileReset profileReset;
+
+    int hot = 0;
+    int cold = 0;
+    int fast = 0;
+    int slow = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        pex::detail::ProfileNotify notify(&hot);
+
+        {
+            pex::detail::ProfileCallback callback(notify, &hot, &fast);
+        }
+
+        {
+            pex::detail::ProfileCallback callback(notify, &hot, &slow);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    {
+        pex::detail::ProfileNotify notify(&cold);
+    }
+
+    auto nodes = pex::GetHottestNodes(1);
+    REQUIRE(nodes.size() == 1);
+    REQUIRE(nodes[0].notifyCount == 3);
+    REQUIRE(nodes[0].callbackCount == 6);
+    REQUIRE(nodes[0].maxFanOut == 2);
+
+    REQUIRE(pex::GetHottestNodes(10).size() == 2);
+
+    auto observers = pex::GetSlowestObservers(10);
+    REQUIRE(observers.size() == 2);
+    REQUIRE(observers[0].callCount == 3);
+    REQUIRE(observers[0].maxTime >= std::chrono::microseconds(100));
+    REQUIRE(observers[0].totalTime >= observers[1].totalTime);
+
+    uint64_t histogramCount = 0;
+
+    for (auto count: observers[0].histogram)
+    {
+        histogramCount += count;
+    }
+
+    REQUIRE(histogramCount == 3);
+
+    // 100 microseconds is at least 2^16 nanoseconds.
+    REQUIRE(observers[0].histogram[16] + observers[0].histogram[17] > 0);
+}
+
+
+TEST_CASE("Profile exports JSON", "[profile]")
+{
+    ProfileReset profileReset;
+
+    int node = 0;
+    int observer = 0;
+
+    {
+        pex::detail::ProfileNotify notify(&node);
+        pex::detail::ProfileCallback callback(notify, &node, &observer);
+    }
+
+    std::ostringstream json;
+    pex::ExportProfileJson(json);
+
+    auto text = json.str();
+    REQUIRE(text.find("\"nodes\": [") != std::string::npos);
+    REQUIRE(text.find("\"notifyCount\": 1") != std::string::npos);
+    REQUIRE(text.find("\"callCount\": 1") != std::string::npos);
+    REQUIRE(text.find("\"histogram\": [") != std::string::npos);
+
+    std::ostringstream report;
+    pex::ReportProfile(report);
+    REQUIRE(report.str().find("Hottest nodes:") != std::string::npos);
+    REQUIRE(report.str().find("Slowest observers:") != std::string::npos);
+
+    pex::ResetProfile();
+    REQUIRE(pex::GetHottestNodes(10).empty());
+}
@@ -0,0 +1,500 @@
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "pex/model_value.h"
+#include "pex/control_value.h"
+#include "pex/signal.h"
+#include "pex/list.h"
+#include "pex/group.h"
+#include "pex/endpoint.h"
+#include "pex/propagation.h"
+
+
+namespace
+{
+
+
+using Model = pex::model::Value<int>;
+
+
+struct Recorder
+{
+    Recorder()
+        :
+        values()
+    {
+        PEX_NAME("Recorder");
+    }
+
+    ~Recorder()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    static void OnValue(void *context, int value)
+    {
+        static_cast<Recorder *>(context)->values.push_back(value);
+    }
+
+    std::vector<int> values;
+};
+
+
+// doubled = 2 * source, and sum = source + doubled.
+// The sum is updated once by the source and again by doubled, so without a
+// Propagation its observers first see a sum computed from a stale doubled.
+struct Diamond
+{
+    Diamond()
+        :
+        source(1),
+        doubled(2),
+        sum(3)
+    {
+        PEX_ROOT(source);
+        PEX_ROOT(doubled);
+        PEX_ROOT(sum);
+        PEX_NAME("Diamond");
+
+        this->source.Connect(this, &Diamond::OnSourceForSum_);
+        this->source.Connect(this, &Diamond::OnSourceForDoubled_);
+        this->doubled.Connect(this, &Diamond::OnDoubled_);
+    }
+
+    ~Diamond()
+    {
+        this->source.Disconnect(this);
+        this->doubled.Disconnect(this);
+        PEX_CLEAR_NAME(this);
+        PEX_CLEAR_NAME(&this->source);
+        PEX_CLEAR_NAME(&this->doubled);
+        PEX_CLEAR_NAME(&this->sum);
+    }
+
+    Model source;
+    Model doubled;
+    Model sum;
+
+private:
+    void UpdateSum_()
+    {
+        this->sum.Set(this->source.Get() + this->doubled.Get());
+    }
+
+    static void OnSourceForSum_(void *context, int)
+    {
+        static_cast<Diamond *>(context)->UpdateSum_();
+    }
+
+    static void OnSourceForDoubled_(void *context, int value)
+    {
+        static_cast<Diamond *>(context)->doubled.Set(2 * value);
+    }
+
+    static void OnDoubled_(void *context, int)
+    {
+        static_cast<Diamond *>(context)->UpdateSum_();
+    }
+};
+
+
+struct Thrower
+{
+    Thrower()
+    {
+        PEX_NAME("Thrower");
+    }
+
+    ~Thrower()
+    {
+        PEX_CLEAR_NAME(this);
+    }
+
+    static void OnValue(void *, int)
+    {
+        throw std::runtime_error("observer failed");
+    }
+};
+
+
+using List = pex::List<int>;
+using ListModel = typename List::Model;
+using ListControl = typename List::template Control<ListModel>;
+
+
+struct ItemRecorder
+{
+    ItemRecorder(const ListControl &listControl)
+        :
+        changes(),
+        connect_(listControl)
+    {
+        PEX_NAME("ItemRecorder");
+        this->connect_.Connect(this, &ItemRecorder::OnItem_);
+    }
+
+    ~ItemRecorder()
+    {
+        this->connect_.Disconnect();
+        PEX_CLEAR_NAME(this);
+    }
+
+    std::vector<std::pair<size_t, int>> changes;
+
+private:
+    void OnItem_(size_t index, pex::Argument<int> value)
+    {
+        this->changes.emplace_back(index, value);
+    }
+
+    pex::detail::ListConnect<ItemRecorder, ListControl> connect_;
+};
+
+
+template<typename T>
+struct PointFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::x, "x"),
+        fields::Field(&T::y, "y"));
+};
+
+
+template<template<typename> typename T>
+struct PointTemplate
+{
+    T<int> x;
+    T<int> y;
+
+    static constexpr auto fields = PointFields<PointTemplate<T>>::fields;
+    static constexpr auto fieldsTypeName = "Point";
+};
+
+
+using PointGroup = pex::Group<PointFields, PointTemplate>;
+using Point = typename PointGroup::Plain;
+using PointModel = typename PointGroup::Model;
+using PointControl = typename PointGroup::template Control<PointModel>;
+
+
+struct PointRecorder
+{
+    static constexpr auto observerName = "PointRecorder";
+
+    PointRecorder(const PointControl &control)
+        :
+        points(),
+        connect_(this, control, &PointRecorder::OnPoint_)
+    {
+
+    }
+
+    std::vector<Point> points;
+
+private:
+    void OnPoint_(const Point &point)
+    {
+        this->points.push_back(point);
+    }
+
+    pex::MakeConnector<PointRecorder, PointControl> connect_;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Without a Propagation, derived nodes observe glitches", "[propagation]")
+{
+    Diamond diamond;
+    Recorder recorder;
+    diamond.sum.Connect(&recorder, &Recorder::OnValue);
+
+    diamond.source.Set(10);
+
+    // 10 + 2, then 10 + 20.
+    REQUIRE(recorder.values == std::vector<int>{12, 30});
+
+    diamond.sum.Disconnect(&recorder);
+}
+
+
+TEST_CASE("Propagation notifies derived nodes once", "[propagation]")
+{
+    Diamond diamond;
+    Recorder recorder;
+    diamond.sum.Connect(&recorder, &Recorder::OnValue);
+
+    {
+        // The first propagation learns that sum is deeper than doubled.
+        pex::Propagation propagation;
+        diamond.source.Set(10);
+    }
+
+    REQUIRE(recorder.values.back() == 30);
+
+    for (int value = 20; value < 25; ++value)
+    {
+        recorder.values.clear();
+
+        {
+            pex::Propagation propagation;
+            diamond.source.Set(value);
+            REQUIRE(recorder.values.empty());
+        }
+
+        REQUIRE(recorder.values == std::vector<int>{3 * value});
+    }
+
+    diamond.sum.Disconnect(&recorder);
+}
+
+
+TEST_CASE("Propagation delivers the latest value once", "[propagation]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    using Control = pex::control::Value<Model>;
+    Control control(model);
+
+    Recorder modelRecorder;
+    Recorder controlRecorder;
+    model.Connect(&modelRecorder, &Recorder::OnValue);
+    control.Connect(&controlRecorder, &Recorder::OnValue);
+
+    {
+        pex::Propagation propagation;
+        model.Set(1);
+        control.Set(2);
+        model.Set(3);
+
+        REQUIRE(model.Get() == 3);
+        REQUIRE(modelRecorder.values.empty());
+    }
+
+    REQUIRE(modelRecorder.values == std::vector<int>{3});
+    REQUIRE(controlRecorder.values == std::vector<int>{3});
+
+    control.Disconnect(&controlRecorder);
+    model.Disconnect(&modelRecorder);
+}
+
+
+TEST_CASE("Nested propagations are flushed by the outermost", "[propagation]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    pex::model::Signal signal;
+    PEX_ROOT(signal);
+
+    Recorder recorder;
+    model.Connect(&recorder, &Recorder::OnValue);
+
+    struct SignalCounter
+    {
+        static void OnSignal(void *context)
+        {
+            ++(*static_cast<int *>(context));
+        }
+    };
+
+    int signalCount = 0;
+    PEX_ROOT(signalCount);
+    signal.Connect(&signalCount, &SignalCounter::OnSignal);
+
+    {
+        pex::Propagation outer;
+
+        {
+            pex::Propagation inner;
+            model.Set(1);
+            signal.Trigger();
+        }
+
+        REQUIRE(recorder.values.empty());
+        REQUIRE(signalCount == 0);
+
+        signal.Trigger();
+        outer.Flush();
+
+        REQUIRE(recorder.values == std::vector<int>{1});
+        REQUIRE(signalCount == 1);
+        REQUIRE(pex::Propagation::IsActive());
+    }
+
+    REQUIRE(!pex::Propagation::IsActive());
+
+    signal.Disconnect(&signalCount);
+    model.Disconnect(&recorder);
+    PEX_CLEAR_NAME(&signalCount);
+}
+
+
+TEST_CASE("Propagation cancels notifications of destroyed nodes", "[propagation]")
+{
+    Recorder recorder;
+    auto model = std::make_unique<Model>();
+    PEX_ROOT(*model);
+
+    model->Connect(&recorder, &Recorder::OnValue);
+
+    {
+        pex::Propagation propagation;
+        model->Set(1);
+        model->Disconnect(&recorder);
+        PEX_CLEAR_NAME(model.get());
+        model.reset();
+    }
+
+    REQUIRE(recorder.values.empty());
+}
+
+
+TEST_CASE("Propagation discards notifications on exception", "[propagation]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    Recorder recorder;
+    model.Connect(&recorder, &Recorder::OnValue);
+
+    try
+    {
+        pex::Propagation propagation;
+        model.Set(1);
+        throw std::runtime_error("abandon");
+    }
+    catch (const std::runtime_error &)
+    {
+
+    }
+
+    REQUIRE(model.Get() == 1);
+    REQUIRE(recorder.values.empty());
+    REQUIRE(!pex::Propagation::IsActive());
+
+    model.Disconnect(&recorder);
+}
+
+
+TEST_CASE("Propagation keeps an observer exception", "[propagation]")
+{
+    Model failing;
+    Model later;
+    PEX_ROOT(failing);
+    PEX_ROOT(later);
+
+    Thrower thrower;
+    Recorder recorder;
+    failing.Connect(&thrower, &Thrower::OnValue);
+    later.Connect(&recorder, &Recorder::OnValue);
+
+    {
+        pex::Propagation propagation;
+        failing.Set(1);
+        later.Set(2);
+
+        // Explicit flushes rethrow.
+        REQUIRE_THROWS_AS(propagation.Flush(), std::runtime_error);
+        REQUIRE(pex::Propagation::IsActive());
+
+        failing.Set(3);
+        later.Set(4);
+
+        // The destructor cannot throw, so it keeps the exception.
+    }
+
+    REQUIRE(!pex::Propagation::IsActive());
+
+    // The notification after the failed one was discarded both times.
+    REQUIRE(recorder.values.empty());
+    REQUIRE(later.Get() == 4);
+
+    auto failure = pex::Propagation::TakeFailure();
+    REQUIRE(failure);
+    REQUIRE_THROWS_AS(std::rethrow_exception(failure), std::runtime_error);
+    REQUIRE(!pex::Propagation::TakeFailure());
+
+    // Later propagations deliver normally.
+    failing.Disconnect(&thrower);
+
+    {
+        pex::Propagation propagation;
+        later.Set(5);
+    }
+
+    REQUIRE(recorder.values == std::vector<int>{5});
+    REQUIRE(!pex::Propagation::TakeFailure());
+
+    later.Disconnect(&recorder);
+}
+
+
+TEST_CASE("Propagation keeps list controls in sync", "[propagation]")
+{
+    ListModel list;
+    PEX_ROOT(list);
+
+    list.Set({1, 2, 3});
+
+    ListControl control(list);
+    ItemRecorder recorder(control);
+
+    {
+        pex::Propagation propagation;
+
+        // The structure of the list is never deferred, so the control and
+        // the recorder follow each change as it is made.
+        list.Append(4);
+        REQUIRE(control.count.Get() == 4);
+
+        control[3].Set(40);
+        list[1].Set(20);
+
+        // The erased item's scheduled notification is cancelled.
+        list.Erase(1);
+        REQUIRE(control.count.Get() == 3);
+        REQUIRE(control.size() == 3);
+
+        list[0].Set(10);
+        list[0].Set(11);
+
+        REQUIRE(recorder.changes.empty());
+    }
+
+    REQUIRE(list.Get() == std::vector<int>{11, 3, 40});
+
+    // Each remaining item delivers its latest value once, at its index.
+    std::sort(std::begin(recorder.changes), std::end(recorder.changes));
+
+    REQUIRE(
+        recorder.changes
+        == std::vector<std::pair<size_t, int>>{{0, 11}, {2, 40}});
+}
+
+
+TEST_CASE("Propagation delivers a group once", "[propagation]")
+{
+    PointModel model;
+    PEX_ROOT(model);
+
+    PointRecorder recorder{PointControl(model)};
+
+    {
+        pex::Propagation propagation;
+        model.x.Set(1);
+        model.y.Set(2);
+        model.x.Set(3);
+
+        REQUIRE(recorder.points.empty());
+    }
+
+    REQUIRE(recorder.points.size() == 1);
+    REQUIRE(recorder.points.back().x == 3);
+    REQUIRE(recorder.points.back().y == 2);
+}
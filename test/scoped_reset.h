@@ -0,0 +1,23 @@
+#pragma once
+
+
+/**
+ ** Calls reset when a test begins and again when it ends, so recorded state
+ ** does not leak between tests.
+ **/
+template<void (*reset)()>
+struct ScopedReset
+{
+    ScopedReset()
+    {
+        reset();
+    }
+
+    ~ScopedReset()
+    {
+        reset();
+    }
+
+    ScopedReset(const ScopedReset &) = delete;
+    ScopedReset & operator=(const ScopedReset &) = delete;
+};
@@ -0,0 +1,157 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "pex/detail/small_vector.h"
+#include "pex/model_value.h"
+
+
+using Strings = pex::detail::SmallVector<std::string, 2>;
+
+
+std::vector<std::string> ToVector(const Strings &strings)
+{
+    return std::vector<std::string>(strings.begin(), strings.end());
+}
+
+
+TEST_CASE("SmallVector stays inline until it outgrows its buffer", "[small]")
+{
+    Strings strings;
+    REQUIRE(strings.empty());
+    REQUIRE(strings.IsInline());
+
+    strings.emplace_back("first");
+    strings.emplace_back("second");
+    REQUIRE(strings.size() == 2);
+    REQUIRE(strings.IsInline());
+
+    strings.emplace_back("third");
+    REQUIRE(!strings.IsInline());
+
+    REQUIRE(
+        ToVector(strings)
+            == std::vector<std::string>{"first", "second", "third"});
+}
+
+
+TEST_CASE("SmallVector erase preserves order", "[small]")
+{
+    Strings strings;
+
+    for (auto word: {"a", "b", "c", "d", "e"})
+    {
+        strings.emplace_back(word);
+    }
+
+    strings.erase(strings.begin() + 1);
+    REQUIRE(ToVector(strings) == std::vector<std::string>{"a", "c", "d", "e"});
+
+    strings.erase(strings.begin() + 1, strings.begin() + 3);
+    REQUIRE(ToVector(strings) == std::vector<std::string>{"a", "e"});
+
+    strings.erase(
+        std::remove(strings.begin(), strings.end(), "a"),
+        strings.end());
+
+    REQUIRE(ToVector(strings) == std::vector<std::string>{"e"});
+}
+
+
+TEST_CASE("SmallVector appends its own element while growing", "[small]")
+{
+    Strings strings;
+    strings.emplace_back(std::string(100, 'a'));
+    strings.emplace_back(std::string(100, 'b'));
+    REQUIRE(strings.size() == strings.capacity());
+
+    // The argument refers to storage that is moved by the growth.
+    strings.push_back(strings[0]);
+    strings.emplace_back(strings[1]);
+
+    REQUIRE(
+        ToVector(strings)
+            == std::vector<std::string>{
+                std::string(100, 'a'),
+                std::string(100, 'b'),
+                std::string(100, 'a'),
+                std::string(100, 'b')});
+}
+
+TEST_CASE("SmallVector copies and moves inline and heap storage", "[small]")
+{
+    auto count = GENERATE(0, 1, 2, 3, 8);
+
+    Strings strings;
+    std::vector<std::string> expected;
+
+    for (int i = 0; i < count; ++i)
+    {
+        strings.emplace_back(std::to_string(i));
+        expected.push_back(std::to_string(i));
+    }
+
+    Strings copied(strings);
+    REQUIRE(ToVector(copied) == expected);
+
+    Strings moved(std::move(copied));
+    REQUIRE(ToVector(moved) == expected);
+    REQUIRE(copied.empty());
+
+    Strings assigned;
+    assigned.emplace_back("replaced");
+    assigned.emplace_back("replaced");
+    assigned.emplace_back("replaced");
+    assigned = strings;
+    REQUIRE(ToVector(assigned) == expected);
+
+    Strings moveAssigned;
+    moveAssigned = std::move(assigned);
+    REQUIRE(ToVector(moveAssigned) == expected);
+    REQUIRE(assigned.empty());
+    REQUIRE(assigned.IsInline());
+}
+
+
+TEST_CASE("Model with few observers does not allocate connections", "[small]")
+{
+    struct Observer
+    {
+        static void OnValue(void *observer, int value)
+        {
+            static_cast<Observer *>(observer)->observed = value;
+        }
+
+        int observed = 0;
+    };
+
+    using Model = pex::model::Value<int>;
+
+    struct TestModel: public Model
+    {
+        using Model::Model;
+
+        bool IsInline() const
+        {
+            return this->connections_.IsInline();
+        }
+    };
+
+    TestModel model;
+    PEX_ROOT(model);
+
+    Observer first;
+    Observer second;
+    PEX_ROOT(first);
+    PEX_ROOT(second);
+
+    model.Connect(&first, &Observer::OnValue);
+    model.Connect(&second, &Observer::OnValue);
+    REQUIRE(model.IsInline());
+
+    model.Set(42);
+    REQUIRE(first.observed == 42);
+    REQUIRE(second.observed == 42);
+
+    model.Disconnect(&first);
+    model.Disconnect(&second);
+}
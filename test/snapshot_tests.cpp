@@ -0,0 +1,163 @@
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "pex/snapshot.h"
+#include "pex/control_value.h"
+
+
+namespace
+{
+
+
+using Payload = std::vector<int>;
+using Model = pex::model::SnapshotValue<Payload>;
+using Control = pex::control::Value<Model>;
+
+
+struct Keeper
+{
+    Keeper(Control control)
+        :
+        control_(control),
+        kept()
+    {
+        this->control_.Connect(this, &Keeper::OnValue_);
+    }
+
+    ~Keeper()
+    {
+        this->control_.Disconnect(this);
+    }
+
+    static void OnValue_(void *context, const pex::Snapshot<Payload> &value)
+    {
+        static_cast<Keeper *>(context)->kept.push_back(value);
+    }
+
+    Control control_;
+    std::vector<pex::Snapshot<Payload>> kept;
+};
+
+
+// Keeps at most three elements, without knowing about Snapshot.
+struct TruncateFilter
+{
+    static Payload Set(const Payload &value)
+    {
+        auto count = std::min(value.size(), size_t(3));
+
+        return Payload(
+            std::begin(value),
+            std::next(std::begin(value), static_cast<ptrdiff_t>(count)));
+    }
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Observers share one snapshot", "[snapshot]")
+{
+    Model model;
+    PEX_ROOT(model);
+
+    Keeper first{Control(model)};
+    Keeper second{Control(model)};
+
+    Payload payload(1000, 42);
+    auto data = payload.data();
+
+    model.Set(std::move(payload));
+
+    REQUIRE(first.kept.size() == 1);
+    REQUIRE(second.kept.size() == 1);
+
+    // The payload was moved into the snapshot, and nobody copied it.
+    REQUIRE(first.kept.front()->data() == data);
+    REQUIRE(first.kept.front().IsSharedWith(second.kept.front()));
+    REQUIRE(model.Get().IsSharedWith(first.kept.front()));
+
+    // A new snapshot does not disturb the ones already shared.
+    model.Set(Payload{1, 2, 3});
+
+    REQUIRE(first.kept.at(0)->size() == 1000);
+    REQUIRE(first.kept.at(1)->size() == 3);
+    REQUIRE(first.kept.at(0).GetPointer().use_count() == 2);
+    REQUIRE(Control(model).Get().Get() == Payload{1, 2, 3});
+}
+
+
+TEST_CASE("SetIfChanged compares snapshot contents", "[snapshot]")
+{
+    Model model(Payload{1, 2, 3});
+    PEX_ROOT(model);
+
+    Keeper keeper{Control(model)};
+
+    REQUIRE(!model.SetIfChanged(model.Get()));
+    REQUIRE(!model.SetIfChanged(Payload{1, 2, 3}));
+    REQUIRE(keeper.kept.empty());
+
+    REQUIRE(model.SetIfChanged(Payload{4}));
+    REQUIRE(keeper.kept.size() == 1);
+    REQUIRE(*keeper.kept.front() == Payload{4});
+}
+
+
+TEST_CASE("Snapshot values use filters written for the payload", "[snapshot]")
+{
+    using FilteredModel =
+        pex::model::FilteredValue<pex::Snapshot<Payload>, TruncateFilter>;
+
+    FilteredModel model;
+    PEX_ROOT(model);
+
+    model.Set(Payload{1, 2, 3, 4, 5});
+    REQUIRE(*model.Get() == Payload{1, 2, 3});
+
+    const Payload &payload = model.Get();
+    REQUIRE(payload.size() == 3);
+}
+
+
+TEST_CASE("Readers on other threads share locked snapshots", "[snapshot]")
+{
+    pex::model::LockedSnapshotValue<Payload> model(Payload(100, 0));
+    PEX_ROOT(model);
+
+    std::atomic<bool> isDone{false};
+    std::atomic<int> failureCount{0};
+
+    std::thread reader(
+        [&]()
+        {
+            while (!isDone)
+            {
+                auto snapshot = model.Get();
+
+                // Every snapshot is complete, because it is never modified.
+                if (
+                    std::adjacent_find(
+                        std::begin(*snapshot),
+                        std::end(*snapshot),
+                        std::not_equal_to<int>()) != std::end(*snapshot))
+                {
+                    ++failureCount;
+                }
+            }
+        });
+
+    for (int i = 1; i < 1000; ++i)
+    {
+        model.Set(Payload(100, i));
+    }
+
+    isDone = true;
+    reader.join();
+
+    REQUIRE(failureCount == 0);
+    REQUIRE(model.Get()->front() == 999);
+}
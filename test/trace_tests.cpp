@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <thread>
+#include "pex/detail/log.h"
+#include "pex/detail/trace.h"
+#include "scoped_reset.h"
+
+
+namespace
+{
+
+
+using TraceReset = ScopedReset<pex::ResetTrace>;
+
+
+struct Node
+{
+    char data;
+};
+
+
+const pex::TraceSite testSite{"trace_tests.cpp", "Test", 1};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("Log arguments are recorded in the trace", "[trace]")
+{
+    TraceReset reset;
+
+    Node node{};
+    pex::PexName(&node, "node");
+
+    int count = 42;
+    pex::detail::TraceLog(&testSite, "Connect ", &node, " count ", count);
+
+    auto trace = pex::CollectTrace();
+    REQUIRE(trace.size() == 1);
+
+    auto &record = trace.front();
+    REQUIRE(record.kind == pex::TraceKind::log);
+    REQUIRE(record.site == &testSite);
+    REQUIRE(record.address == &node);
+    REQUIRE(record.payload == 42);
+
+    std::ostringstream output;
+    pex::ReportTrace(output, trace);
+
+    auto report = output.str();
+    REQUIRE(report.find("trace_tests.cpp:Test:1") != std::string::npos);
+    REQUIRE(report.find("node @") != std::string::npos);
+    REQUIRE(report.find("42") != std::string::npos);
+
+    pex::ClearPexName(&node);
+}
+
+
+TEST_CASE("The trace keeps the most recent events", "[trace]")
+{
+    TraceReset reset;
+
+    Node node{};
+    auto eventCount = pex::traceCapacity + 10;
+
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        pex::detail::RecordTrace(pex::TraceKind::notify, &testSite, &node, i);
+    }
+
+    auto trace = pex::CollectTrace();
+    REQUIRE(trace.size() == pex::traceCapacity);
+    REQUIRE(trace.front().payload == 10);
+    REQUIRE(trace.back().payload == eventCount - 1);
+
+    pex::ResetTrace();
+    REQUIRE(pex::CollectTrace().empty());
+}
+
+
+TEST_CASE("Each thread records into its own buffer", "[trace]")
+{
+    TraceReset reset;
+
+    static constexpr size_t threadCount = 4;
+    static constexpr size_t eventCount = 100;
+
+    Node node{};
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(
+            [&node]()
+            {
+                for (size_t j = 0; j < eventCount; ++j)
+                {
+                    pex::detail::RecordTrace(
+                        pex::TraceKind::callback,
+                        &testSite,
+                        &node,
+                        j);
+                }
+            });
+    }
+
+    // Collecting while the threads record returns only complete events.
+    for (auto &record: pex::CollectTrace())
+    {
+        REQUIRE(record.address == &node);
+    }
+
+    for (auto &thread: threads)
+    {
+        thread.join();
+    }
+
+    auto trace = pex::CollectTrace();
+    REQUIRE(trace.size() == threadCount * eventCount);
+
+    for (size_t i = 1; i < trace.size(); ++i)
+    {
+        REQUIRE(trace[i - 1].time <= trace[i].time);
+    }
+
+    // The buffers of the exited threads are released.
+    pex::ResetTrace();
+    REQUIRE(pex::CollectTrace().empty());
+}
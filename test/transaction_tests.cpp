@@ -0,0 +1,320 @@
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "pex/model_value.h"
+#include "pex/list.h"
+#include "pex/group.h"
+#include "pex/endpoint.h"
+#include "pex/transaction.h"
+
+
+namespace
+{
+
+
+using IntModel = pex::model::Value<int>;
+using StringModel = pex::model::Value<std::string>;
+
+
+// Records the state of both models each time either one notifies.
+struct Pair
+{
+    Pair()
+        :
+        count(1),
+        name("one"),
+        seen()
+    {
+        PEX_ROOT(count);
+        PEX_ROOT(name);
+        PEX_NAME("Pair");
+
+        this->count.Connect(this, &Pair::OnCount_);
+        this->name.Connect(this, &Pair::OnName_);
+    }
+
+    ~Pair()
+    {
+        this->count.Disconnect(this);
+        this->name.Disconnect(this);
+        PEX_CLEAR_NAME(this);
+        PEX_CLEAR_NAME(&this->count);
+        PEX_CLEAR_NAME(&this->name);
+    }
+
+    IntModel count;
+    StringModel name;
+    std::vector<std::string> seen;
+
+private:
+    void Record_()
+    {
+        this->seen.push_back(
+            std::to_string(this->count.Get()) + " " + this->name.Get());
+    }
+
+    static void OnCount_(void *context, int)
+    {
+        static_cast<Pair *>(context)->Record_();
+    }
+
+    static void OnName_(void *context, const std::string &)
+    {
+        static_cast<Pair *>(context)->Record_();
+    }
+};
+
+
+// total is recomputed whenever either input changes.
+struct Sum
+{
+    Sum()
+        :
+        left(1),
+        right(2),
+        total(3),
+        totals()
+    {
+        PEX_ROOT(left);
+        PEX_ROOT(right);
+        PEX_ROOT(total);
+        PEX_NAME("Sum");
+
+        this->left.Connect(this, &Sum::OnInput_);
+        this->right.Connect(this, &Sum::OnInput_);
+        this->total.Connect(this, &Sum::OnTotal_);
+    }
+
+    ~Sum()
+    {
+        this->left.Disconnect(this);
+        this->right.Disconnect(this);
+        this->total.Disconnect(this);
+        PEX_CLEAR_NAME(this);
+        PEX_CLEAR_NAME(&this->left);
+        PEX_CLEAR_NAME(&this->right);
+        PEX_CLEAR_NAME(&this->total);
+    }
+
+    IntModel left;
+    IntModel right;
+    IntModel total;
+    std::vector<int> totals;
+
+private:
+    static void OnInput_(void *context, int)
+    {
+        auto self = static_cast<Sum *>(context);
+        self->total.Set(self->left.Get() + self->right.Get());
+    }
+
+    static void OnTotal_(void *context, int value)
+    {
+        static_cast<Sum *>(context)->totals.push_back(value);
+    }
+};
+
+
+template<typename T>
+struct PointFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::x, "x"),
+        fields::Field(&T::y, "y"));
+};
+
+
+template<template<typename> typename T>
+struct PointTemplate
+{
+    T<int> x;
+    T<int> y;
+
+    static constexpr auto fields = PointFields<PointTemplate<T>>::fields;
+    static constexpr auto fieldsTypeName = "Point";
+};
+
+
+using PointGroup = pex::Group<PointFields, PointTemplate>;
+using Point = typename PointGroup::Plain;
+using PointModel = typename PointGroup::Model;
+using PointControl = typename PointGroup::template Control<PointModel>;
+
+
+struct PointRecorder
+{
+    static constexpr auto observerName = "PointRecorder";
+
+    PointRecorder(const PointControl &control)
+        :
+        points(),
+        connect_(this, control, &PointRecorder::OnPoint_)
+    {
+
+    }
+
+    std::vector<Point> points;
+
+private:
+    void OnPoint_(const Point &point)
+    {
+        this->points.push_back(point);
+    }
+
+    pex::MakeConnector<PointRecorder, PointControl> connect_;
+};
+
+
+using List = pex::List<int>;
+using ListModel = typename List::Model;
+using ListControl = typename List::template Control<ListModel>;
+
+
+struct ItemRecorder
+{
+    ItemRecorder(const ListControl &listControl)
+        :
+        changes(),
+        connect_(listControl)
+    {
+        PEX_NAME("ItemRecorder");
+        this->connect_.Connect(this, &ItemRecorder::OnItem_);
+    }
+
+    ~ItemRecorder()
+    {
+        this->connect_.Disconnect();
+        PEX_CLEAR_NAME(this);
+    }
+
+    std::vector<std::pair<size_t, int>> changes;
+
+private:
+    void OnItem_(size_t index, pex::Argument<int> value)
+    {
+        this->changes.emplace_back(index, value);
+    }
+
+    pex::detail::ListConnect<ItemRecorder, ListControl> connect_;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("TransactionGroup reverts every model", "[transaction]")
+{
+    Pair pair;
+
+    {
+        pex::TransactionGroup group;
+        group.Set(pair.count, 2);
+        group.Set(pair.name, std::string("two"));
+
+        // The same model is only staged once.
+        group.Set(pair.count, 3);
+        REQUIRE(group.GetCount() == 2);
+
+        REQUIRE(pair.count.Get() == 3);
+        REQUIRE(pair.name.Get() == "two");
+    }
+
+    REQUIRE(pair.count.Get() == 1);
+    REQUIRE(pair.name.Get() == "one");
+    REQUIRE(pair.seen.empty());
+}
+
+
+TEST_CASE("TransactionGroup publishes all changes together", "[transaction]")
+{
+    Pair pair;
+
+    {
+        pex::TransactionGroup group;
+        group.Set(pair.count, 2);
+        group.Add(pair.name).Set("two");
+        group.Commit();
+    }
+
+    // Neither observer sees a half-applied state.
+    REQUIRE(pair.seen == std::vector<std::string>{"2 two", "2 two"});
+    REQUIRE(pair.count.Get() == 2);
+    REQUIRE(pair.name.Get() == "two");
+}
+
+
+TEST_CASE("TransactionGroup notifies derived nodes once", "[transaction]")
+{
+    Sum sum;
+
+    pex::TransactionGroup group;
+    group.Set(sum.left, 10);
+    group.Set(sum.right, 20);
+    group.Commit();
+
+    REQUIRE(sum.totals == std::vector<int>{30});
+    REQUIRE(group.GetCount() == 0);
+}
+
+
+TEST_CASE("TransactionGroup notifies a group once", "[transaction]")
+{
+    PointModel model;
+    PEX_ROOT(model);
+
+    PointRecorder recorder{PointControl(model)};
+
+    pex::TransactionGroup group;
+    group.Set(model.x, 3);
+    group.Set(model.y, 4);
+    group.Set(model.x, 5);
+
+    REQUIRE(group.GetCount() == 2);
+    REQUIRE(recorder.points.empty());
+
+    group.Commit();
+
+    REQUIRE(recorder.points.size() == 1);
+    REQUIRE(recorder.points.back().x == 5);
+    REQUIRE(recorder.points.back().y == 4);
+}
+
+
+TEST_CASE("TransactionGroup publishes list items", "[transaction]")
+{
+    ListModel list;
+    PEX_ROOT(list);
+
+    list.Set({1, 2, 3});
+
+    ListControl control(list);
+    ItemRecorder recorder(control);
+
+    {
+        pex::TransactionGroup group;
+        group.Set(list[0], 10);
+        group.Set(list[2], 30);
+
+        REQUIRE(list.Get() == std::vector<int>{10, 2, 30});
+        REQUIRE(recorder.changes.empty());
+    }
+
+    // Reverted without publishing.
+    REQUIRE(list.Get() == std::vector<int>{1, 2, 3});
+    REQUIRE(recorder.changes.empty());
+
+    pex::TransactionGroup group;
+    group.Set(list[0], 10);
+    group.Set(list[2], 30);
+    group.Commit();
+
+    std::sort(std::begin(recorder.changes), std::end(recorder.changes));
+
+    REQUIRE(list.Get() == std::vector<int>{10, 2, 30});
+
+    REQUIRE(
+        recorder.changes
+        == std::vector<std::pair<size_t, int>>{{0, 10}, {2, 30}});
+}
@@ -223,3 +223,293 @@ TEMPLATE_TEST_CASE(
         REQUIRE(observer4.observedValue == Approx(propagated));
     }
 }
+
+
+namespace
+{
+
+
+struct ClampFilter
+{
+    static int Set(int value)
+    {
+        return std::max(-10, std::min(value, 10));
+    }
+};
+
+
+// Values of this type cannot be compared.
+struct Opaque
+{
+    int value;
+};
+
+
+// Counts copies, to check that rvalues are moved into storage.
+struct Counted
+{
+    Counted(int value_ = 0)
+        :
+        value(value_)
+    {
+
+    }
+
+    Counted(const Counted &other)
+        :
+        value(other.value)
+    {
+        ++copyCount;
+    }
+
+    Counted(Counted &&other) = default;
+
+    Counted & operator=(const Counted &other)
+    {
+        this->value = other.value;
+        ++copyCount;
+
+        return *this;
+    }
+
+    Counted & operator=(Counted &&other) = default;
+
+    int value;
+
+    static inline int copyCount = 0;
+};
+
+
+// A member filter that takes its argument by value.
+struct OffsetFilter
+{
+    Counted Set(Counted counted) const
+    {
+        counted.value += this->offset;
+
+        return counted;
+    }
+
+    int offset = 100;
+};
+
+
+} // end anonymous namespace
+
+
+TEST_CASE("SetIfChanged suppresses redundant notifications", "[value]")
+{
+    using Model = pex::model::Value<int>;
+    using Control = pex::control::Value<Model>;
+
+    Model model(42);
+    PEX_ROOT(model);
+    TerminusObserver<Control> observer{Control(model)};
+
+    REQUIRE(!model.SetIfChanged(42));
+    REQUIRE(observer.GetCount() == 0);
+
+    REQUIRE(model.SetIfChanged(43));
+    REQUIRE(observer.GetCount() == 1);
+    REQUIRE(observer.observedValue == 43);
+
+    Control control(model);
+    REQUIRE(!control.SetIfChanged(43));
+    REQUIRE(observer.GetCount() == 1);
+
+    REQUIRE(control.SetIfChanged(44));
+    REQUIRE(observer.GetCount() == 2);
+    REQUIRE(observer.observedValue == 44);
+
+    // Set always notifies.
+    model.Set(44);
+    REQUIRE(observer.GetCount() == 3);
+}
+
+
+TEST_CASE("SetIfChanged compares the filtered value", "[value]")
+{
+    using Model = pex::model::FilteredValue<int, ClampFilter>;
+    using Control = pex::control::Value<Model>;
+
+    Model model(10);
+    PEX_ROOT(model);
+    TerminusObserver<Control> observer{Control(model)};
+
+    // 20 is clamped to the current value.
+    REQUIRE(!model.SetIfChanged(20));
+    REQUIRE(observer.GetCount() == 0);
+
+    REQUIRE(model.SetIfChanged(-20));
+    REQUIRE(observer.GetCount() == 1);
+    REQUIRE(observer.observedValue == -10);
+}
+
+
+TEST_CASE("SetIfChanged always notifies incomparable types", "[value]")
+{
+    using Model = pex::model::Value<Opaque>;
+    using Control = pex::control::Value<Model>;
+
+    Model model(Opaque{1});
+    PEX_ROOT(model);
+    TerminusObserver<Control> observer{Control(model)};
+
+    REQUIRE(model.SetIfChanged(Opaque{1}));
+    REQUIRE(observer.GetCount() == 1);
+}
+
+
+TEST_CASE("Set moves rvalues into storage", "[value]")
+{
+    using Model = pex::model::Value<Counted>;
+    using Control = pex::control::Value<Model>;
+
+    Model model;
+    PEX_ROOT(model);
+
+    Control control(model);
+
+    int notificationCount = 0;
+
+    control.Connect(
+        &notificationCount,
+        [](void *context, const Counted &)
+        {
+            ++(*static_cast<int *>(context));
+        });
+
+    Counted::copyCount = 0;
+
+    model.Set(Counted{1});
+    control.Set(Counted{2});
+    model = Counted{3};
+    control = Counted{4};
+    pex::AccessReference(model).Set(Counted{5});
+
+    {
+        pex::Defer<Model> defer(model);
+        defer.Set(Counted{6});
+        defer = Counted{7};
+    }
+
+    REQUIRE(Counted::copyCount == 0);
+
+    // Observers are notified by const reference, and the Defer notifies
+    // once.
+    REQUIRE(notificationCount == 6);
+
+    {
+        // Only the saved value is copied.
+        pex::Transaction<Model> transaction(model, Counted{8});
+        transaction.Set(Counted{9});
+        REQUIRE(Counted::copyCount == 1);
+
+        transaction.Commit();
+    }
+
+    REQUIRE(Counted::copyCount == 1);
+    REQUIRE(model.Get().value == 9);
+
+    // A Transaction that is not committed moves the saved value back.
+    Counted::copyCount = 0;
+
+    {
+        pex::Transaction<Model> transaction(model, Counted{10});
+    }
+
+    REQUIRE(Counted::copyCount == 1);
+    REQUIRE(model.Get().value == 9);
+
+    // Lvalues are still copied.
+    Counted::copyCount = 0;
+    Counted counted{11};
+    model.Set(counted);
+    REQUIRE(Counted::copyCount == 1);
+
+    control.Disconnect(&notificationCount);
+}
+
+
+TEST_CASE("Set moves rvalues through member filters", "[value]")
+{
+    using Model = pex::model::FilteredValue<Counted, OffsetFilter>;
+    using Control = pex::control::Value<Model>;
+
+    Model model(Counted{}, OffsetFilter{});
+    PEX_ROOT(model);
+
+    Control control(model);
+
+    Counted::copyCount = 0;
+
+    model.Set(Counted{1});
+    REQUIRE(Counted::copyCount == 0);
+    REQUIRE(model.Get().value == 101);
+
+    Counted::copyCount = 0;
+    control.Set(Counted{2});
+    REQUIRE(Counted::copyCount == 0);
+    REQUIRE(model.Get().value == 102);
+}
+
+
+TEST_CASE("GetRef reads the model value without a copy", "[value]")
+{
+    using Model = pex::model::Value<Counted>;
+    using Control = pex::control::Value<Model>;
+
+    Model model(Counted{1});
+    PEX_ROOT(model);
+
+    Control control(model);
+    Control copy(control);
+
+    Counted::copyCount = 0;
+
+    REQUIRE(&model.GetRef() == &control.GetRef());
+    REQUIRE(&control.GetRef() == &copy.GetRef());
+    REQUIRE(control.GetRef().value == 1);
+
+    {
+        auto view = copy.View();
+        REQUIRE(&view.Get() == &model.GetRef());
+        REQUIRE(view->value == 1);
+    }
+
+    REQUIRE(Counted::copyCount == 0);
+
+    // The reference follows the value.
+    const Counted &value = control.GetRef();
+    control.Set(Counted{2});
+    REQUIRE(value.value == 2);
+}
+
+
+#ifndef NDEBUG
+TEST_CASE("Values cannot be set while viewed", "[value]")
+{
+    using Model = pex::model::Value<std::string>;
+    using Control = pex::control::Value<Model>;
+
+    Model model("viewed");
+    PEX_ROOT(model);
+
+    Control control(model);
+
+    {
+        auto view = control.View();
+        REQUIRE(*view == "viewed");
+        REQUIRE_THROWS_AS(control.Set("changed"), std::logic_error);
+        REQUIRE_THROWS_AS(model.Set(std::string("moved")), std::logic_error);
+
+        // An unchanged value is not modified.
+        REQUIRE(!model.SetIfChanged("viewed"));
+        REQUIRE_THROWS_AS(model.SetIfChanged("changed"), std::logic_error);
+        REQUIRE(*view == "viewed");
+    }
+
+    control.Set("changed");
+    REQUIRE(model.Get() == "changed");
+}
+#endif